@@ -0,0 +1,255 @@
+/**
+ *
+ * @file Bus.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les bus de mixage hiérarchiques (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Bus.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <AL/al.h>
+
+#include "Context.h"
+#include "ProfilerPrivate.h"
+#include "KA3D/Sound.h"
+
+namespace KA3D
+{
+
+Bus::Bus(const std::string& szName):
+	Bus(szName, nullptr)
+{ }
+
+Bus::Bus(const std::string& szName, Bus* pParent):
+	m_szName(szName),
+	m_pParent(pParent),
+	m_tblChildren(),
+	m_tblSounds(),
+	m_mutex(),
+	m_fGain(1.f),
+	m_fDuckGain(1.f),
+	m_fEffectiveGain(pParent ? pParent->m_fEffectiveGain : 1.f),
+	m_isMuted(false),
+	m_isDirty(false),
+	m_hasDirtyChild(false)
+{ }
+
+Bus::~Bus() noexcept
+{ }
+
+Bus& Bus::addChild(const std::string& szName)
+{
+	std::lock_guard<std::mutex> lock(treeMutex());
+	m_tblChildren.push_back(std::unique_ptr<Bus>(new Bus(szName, this)));
+	return *m_tblChildren.back();
+}
+
+Bus* Bus::find(const std::string& szName) noexcept
+{
+	if(m_szName == szName)
+		return this;
+	for(const std::unique_ptr<Bus>& pChild : m_tblChildren)
+	{
+		Bus* pBus(pChild->find(szName));
+		if(pBus)
+			return pBus;
+	}
+	return nullptr;
+}
+
+void Bus::collect(std::vector<Bus*>& tblBuses)
+{
+	tblBuses.push_back(this);
+	for(const std::unique_ptr<Bus>& pChild : m_tblChildren)
+		pChild->collect(tblBuses);
+}
+
+const std::string& Bus::name() const noexcept
+{
+	return m_szName;
+}
+
+Bus* Bus::parent() const noexcept
+{
+	return m_pParent;
+}
+
+void Bus::setGain(float fGain) noexcept
+{
+	std::lock_guard<std::mutex> lock(treeMutex());
+	if(fGain == m_fGain)
+		return;
+	m_fGain = fGain;
+	markDirty();
+}
+
+float Bus::gain() const noexcept
+{
+	return m_fGain;
+}
+
+void Bus::setMuted(bool isMuted) noexcept
+{
+	std::lock_guard<std::mutex> lock(treeMutex());
+	if(isMuted == m_isMuted)
+		return;
+	m_isMuted = isMuted;
+	markDirty();
+}
+
+bool Bus::isMuted() const noexcept
+{
+	return m_isMuted;
+}
+
+void Bus::setDuckGain(float fGain) noexcept
+{
+	std::lock_guard<std::mutex> lock(treeMutex());
+	if(fGain == m_fDuckGain)
+		return;
+	m_fDuckGain = fGain;
+	markDirty();
+}
+
+float Bus::duckGain() const noexcept
+{
+	return m_fDuckGain;
+}
+
+float Bus::effectiveGain() const noexcept
+{
+	return m_fEffectiveGain;
+}
+
+bool Bus::isPlaying() const
+{
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(treeMutex());
+	return hasPlayingSound();
+}
+
+void Bus::add(Sound& sound)
+{
+	std::lock_guard<std::mutex> lock(treeMutex());
+	m_tblSounds.push_back(&sound);
+}
+
+void Bus::remove(Sound& sound) noexcept
+{
+	std::lock_guard<std::mutex> lock(treeMutex());
+	m_tblSounds.erase(std::remove(m_tblSounds.begin(), m_tblSounds.end(),
+	                              &sound), m_tblSounds.end());
+}
+
+void Bus::flush()
+{
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(treeMutex());
+	if(!m_isDirty && !m_hasDirtyChild)
+		return;
+	KA3D_PROFILE_SCOPE("Bus::flush");
+
+	// Toutes les modifications sont appliquées ensemble par le pilote
+	Context* pContext(Context::current());
+	bool isDeferred(pContext && pContext->extensions().alDeferUpdatesSOFT);
+	if(isDeferred)
+		pContext->extensions().alDeferUpdatesSOFT();
+	try
+	{
+		propagate(m_pParent ? m_pParent->m_fEffectiveGain : 1.f, false);
+	}
+	catch(...)
+	{
+		if(isDeferred)
+			pContext->extensions().alProcessUpdatesSOFT();
+		throw;
+	}
+	if(isDeferred)
+		pContext->extensions().alProcessUpdatesSOFT();
+}
+
+std::mutex& Bus::treeMutex() const noexcept
+{
+	const Bus* pRoot(this);
+	while(pRoot->m_pParent)
+		pRoot = pRoot->m_pParent;
+	return pRoot->m_mutex;
+}
+
+void Bus::markDirty() noexcept
+{
+	m_isDirty = true;
+	// Un ancêtre déjà marqué implique que les suivants le sont aussi
+	for(Bus* pBus=m_pParent; pBus && !pBus->m_hasDirtyChild;
+	    pBus=pBus->m_pParent)
+	{
+		pBus->m_hasDirtyChild = true;
+	}
+}
+
+bool Bus::hasPlayingSound() const
+{
+	for(const Sound* pSound : m_tblSounds)
+		if(pSound->isPlaying())
+			return true;
+	for(const std::unique_ptr<Bus>& pChild : m_tblChildren)
+		if(pChild->hasPlayingSound())
+			return true;
+	return false;
+}
+
+void Bus::propagate(float fParentGain, bool isParentChanged)
+{
+	bool isChanged(false);
+	if(m_isDirty || isParentChanged)
+	{
+		float fGain(m_isMuted ? 0.f : fParentGain * m_fGain * m_fDuckGain);
+		if(fGain != m_fEffectiveGain)
+		{
+			m_fEffectiveGain = fGain;
+			isChanged = true;
+			for(Sound* pSound : m_tblSounds)
+				pSound->setBusGain(fGain);
+		}
+	}
+	m_isDirty = false;
+
+	// Seules les branches modifiées (ou sous un bus modifié) sont visitées
+	if(isChanged || m_hasDirtyChild)
+	{
+		for(const std::unique_ptr<Bus>& pChild : m_tblChildren)
+		{
+			if(isChanged || pChild->m_isDirty || pChild->m_hasDirtyChild)
+				pChild->propagate(m_fEffectiveGain, isChanged);
+		}
+	}
+	m_hasDirtyChild = false;
+}
+
+} // namespace KA3D
@@ -27,21 +27,31 @@
 
 #include "Context.h"
 
+#include <cstdint>
 #include <cstring>
 #include <sstream>
 #include <stdexcept>
 
+#include <AL/al.h>
 #include <AL/alc.h>
 
 #include "Error.h"
+#include "Extensions.h"
+#include "HandlePool.h"
 
 namespace KA3D
 {
 
+std::atomic<Context*> Context::pCurrent(nullptr);
+
 Context::Context(const char* deviceName):
 	m_pDevices(nullptr),
 	m_pContext(nullptr),
-	m_szDeviceName(nullptr)
+	m_szDeviceName(nullptr),
+	m_sources(alGenSources, alDeleteSources),
+	m_buffers(alGenBuffers, alDeleteBuffers),
+	m_extensions(),
+	m_mutex()
 {
 	if(deviceName)
 	{
@@ -63,7 +73,8 @@ void Context::Init(const int* attributes)
 		if(m_pDevices == nullptr)
 		{
 			std::ostringstream msg;
-			msg << "Unable to open device '" << m_szDeviceName << "'";
+			msg << "Unable to open device '"
+			    << (m_szDeviceName ? m_szDeviceName : "default") << "'";
 			throw std::runtime_error(msg.str());
 		}
 
@@ -93,6 +104,63 @@ void Context::Quit()
 		checkALCError(device());
 }
 
+void Context::reserve(std::size_t sources, std::size_t buffers)
+{
+	m_sources.reserve(sources);
+	m_buffers.reserve(buffers);
+}
+
+HandlePool& Context::sources() noexcept
+{
+	return m_sources;
+}
+HandlePool& Context::buffers() noexcept
+{
+	return m_buffers;
+}
+
+const Extensions& Context::extensions() const noexcept
+{
+	return m_extensions;
+}
+
+std::recursive_mutex& Context::mutex() noexcept
+{
+	return m_mutex;
+}
+
+std::int64_t Context::deviceClock() const
+{
+	if(!m_extensions.alcGetInteger64vSOFT)
+		throw std::runtime_error("ALC_SOFT_device_clock not supported");
+
+	ALCint64SOFT clock(0);
+	m_extensions.alcGetInteger64vSOFT(m_pDevices, ALC_DEVICE_CLOCK_SOFT,
+	                                  1, &clock);
+	checkALCError(device());
+	return clock;
+}
+
+void Context::deviceClockLatency(std::int64_t& clock,
+                                 std::int64_t& latency) const
+{
+	if(!m_extensions.alcGetInteger64vSOFT)
+		throw std::runtime_error("ALC_SOFT_device_clock not supported");
+
+	ALCint64SOFT values[2];
+	m_extensions.alcGetInteger64vSOFT(m_pDevices,
+	                                  ALC_DEVICE_CLOCK_LATENCY_SOFT,
+	                                  2, values);
+	checkALCError(device());
+	clock = values[0];
+	latency = values[1];
+}
+
+Context* Context::current() noexcept
+{
+	return pCurrent;
+}
+
 ALCdevice* Context::device() const noexcept
 {
 	return m_pDevices;
@@ -106,12 +174,15 @@ void Context::makeCurrent()
 {
 	if(alcMakeContextCurrent(m_pContext) != ALC_TRUE)
 		checkALCError(device());
+	m_extensions.load(m_pDevices);
+	pCurrent = this;
 }
 
 void Context::clearCurrent()
 {
 	if(alcMakeContextCurrent(nullptr) != ALC_TRUE)
 		throw std::runtime_error("Unable to set null current context");
+	pCurrent = nullptr;
 }
 
 void Context::suspend()
@@ -27,12 +27,25 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <mutex>
+
 #include <AL/alc.h>
 
+#include "Extensions.h"
+#include "HandlePool.h"
+
 namespace KA3D
 {
 class Context
 {
+public:
+	//! Contexte actif (défini par #makeCurrent), nullptr si aucun
+	static Context* current() noexcept;
+
 public:
 	Context(const char* deviceName = nullptr);
 	Context(Context& ) noexcept = delete;
@@ -45,15 +58,66 @@ public:
 	void Init(const int* attributes);
 	void Quit();
 
+	//! Pré-alloue les sources et buffers (contexte actif requis)
+	void reserve(std::size_t sources, std::size_t buffers);
+	HandlePool& sources() noexcept;
+	HandlePool& buffers() noexcept;
+	//! Extensions chargées par #makeCurrent
+	const Extensions& extensions() const noexcept;
+
+	//! Horloge du périphérique en nanosecondes (ALC_SOFT_device_clock)
+	std::int64_t deviceClock() const;
+	//! Horloge et latence de sortie du périphérique, lues ensemble (ns)
+	void deviceClockLatency(std::int64_t& clock, std::int64_t& latency) const;
+
 	void makeCurrent();
 	static void clearCurrent();
 	void suspend();
 	void process();
 
+	//! Verrou des appels OpenAL (cf. ContextLock)
+	std::recursive_mutex& mutex() noexcept;
+
+private:
+	//! Lu aussi par le fil de l'Updater
+	static std::atomic<Context*> pCurrent;
+
 private:
 	ALCdevice* m_pDevices;
 	ALCcontext* m_pContext;
 	ALCchar* m_szDeviceName;
+	HandlePool m_sources; //!< Réserve de sources
+	HandlePool m_buffers; //!< Réserve de buffers
+	Extensions m_extensions; //!< Extensions du contexte
+	std::recursive_mutex m_mutex; //!< Verrou des appels OpenAL
+};
+
+/**
+ * @brief Verrou des appels OpenAL du contexte actif (portée)
+ * L'état d'erreur d'OpenAL (alGetError) est partagé par tous les fils :
+ * un appel et la lecture de son erreur doivent se faire sous ce verrou,
+ * pris par chaque pas de l'Updater et par les fonctions publiques qui
+ * appellent le pilote. Récursif : ces fonctions s'appellent entre elles.
+ */
+class ContextLock
+{
+public:
+	ContextLock():
+		m_pContext(Context::current())
+	{
+		if(m_pContext)
+			m_pContext->mutex().lock();
+	}
+	ContextLock(const ContextLock& ) = delete;
+	ContextLock& operator=(const ContextLock& ) = delete;
+	~ContextLock() noexcept
+	{
+		if(m_pContext)
+			m_pContext->mutex().unlock();
+	}
+
+private:
+	Context* m_pContext; //!< Contexte verrouillé (nullptr : aucun)
 };
 } // namespace KA3D
 
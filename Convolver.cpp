@@ -0,0 +1,258 @@
+/**
+ *
+ * @file Convolver.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la convolution par FFT partitionnée (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/Convolver.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "FFT.h"
+#include "MixKernels.h"
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+Convolver::Convolver(std::uint32_t blockSize):
+	m_pFFT(new FFT(2*blockSize)),
+	m_uBlockSize(blockSize),
+	m_uBins(blockSize + 1),
+	m_uPartitions(0),
+	m_uIrChannels(0),
+	m_uChannels(0),
+	m_uFill(0),
+	m_uHead(0),
+	m_fDry(0.f),
+	m_fWet(1.f),
+	m_tblIrRe(),
+	m_tblIrIm(),
+	m_tblDelayRe(),
+	m_tblDelayIm(),
+	m_tblInput(),
+	m_tblOutput(),
+	m_tblWorkRe(2*blockSize),
+	m_tblWorkIm(2*blockSize),
+	m_tblAccRe(blockSize + 1),
+	m_tblAccIm(blockSize + 1)
+{ }
+
+Convolver::~Convolver() noexcept
+{
+	delete m_pFFT;
+}
+
+void Convolver::setImpulse(const MixerBuffer& impulse)
+{
+	KA3D_PROFILE_SCOPE("Convolver::setImpulse");
+	m_uIrChannels = impulse.channels();
+	m_uPartitions = std::max<std::uint32_t>(1,
+		(impulse.frames() + m_uBlockSize - 1) / m_uBlockSize);
+	m_tblIrRe.assign(m_uIrChannels * m_uPartitions * m_uBins, 0.f);
+	m_tblIrIm.assign(m_uIrChannels * m_uPartitions * m_uBins, 0.f);
+
+	// Chaque partition, complétée par des zéros, est transformée une fois
+	for(std::uint16_t c=0; c<m_uIrChannels; ++c)
+	{
+		const float* pIr(impulse.channel(c));
+		for(std::uint32_t p=0; p<m_uPartitions; ++p)
+		{
+			std::uint32_t begin(p*m_uBlockSize);
+			std::uint32_t count(std::min(m_uBlockSize,
+			                             impulse.frames() - std::min(begin,
+			                                             impulse.frames())));
+			std::fill(m_tblWorkRe.begin(), m_tblWorkRe.end(), 0.f);
+			std::fill(m_tblWorkIm.begin(), m_tblWorkIm.end(), 0.f);
+			std::copy(pIr + begin, pIr + begin + count, m_tblWorkRe.begin());
+			m_pFFT->forward(m_tblWorkRe.data(), m_tblWorkIm.data());
+
+			std::size_t offset((c*m_uPartitions + p) * m_uBins);
+			std::copy(m_tblWorkRe.begin(), m_tblWorkRe.begin() + m_uBins,
+			          m_tblIrRe.begin() + offset);
+			std::copy(m_tblWorkIm.begin(), m_tblWorkIm.begin() + m_uBins,
+			          m_tblIrIm.begin() + offset);
+		}
+	}
+
+	setChannels(m_uChannels);
+}
+
+void Convolver::loadWav(std::iostream& file)
+{
+	std::unique_ptr<MixerBuffer> pImpulse;
+	try
+	{
+		pImpulse.reset(MixerBuffer::fromWav(file));
+	}
+	catch(const std::exception& e)
+	{
+		throw std::runtime_error(std::string("Unable to load impulse: ") +
+		                         e.what());
+	}
+	setImpulse(*pImpulse);
+}
+
+void Convolver::reset() noexcept
+{
+	std::fill(m_tblDelayRe.begin(), m_tblDelayRe.end(), 0.f);
+	std::fill(m_tblDelayIm.begin(), m_tblDelayIm.end(), 0.f);
+	std::fill(m_tblInput.begin(), m_tblInput.end(), 0.f);
+	std::fill(m_tblOutput.begin(), m_tblOutput.end(), 0.f);
+	m_uFill = 0;
+	m_uHead = 0;
+}
+
+void Convolver::setDry(float fDry) noexcept
+{
+	m_fDry = fDry;
+}
+
+void Convolver::setWet(float fWet) noexcept
+{
+	m_fWet = fWet;
+}
+
+std::uint32_t Convolver::partitions() const noexcept
+{
+	return m_uPartitions;
+}
+
+std::uint32_t Convolver::latency() const noexcept
+{
+	return m_uBlockSize;
+}
+
+void Convolver::setChannels(std::uint16_t channels)
+{
+	m_uChannels = channels;
+	m_tblDelayRe.assign(channels * m_uPartitions * m_uBins, 0.f);
+	m_tblDelayIm.assign(channels * m_uPartitions * m_uBins, 0.f);
+	m_tblInput.assign(channels * 2*m_uBlockSize, 0.f);
+	m_tblOutput.assign(channels * m_uBlockSize, 0.f);
+	m_uFill = 0;
+	m_uHead = 0;
+}
+
+void Convolver::process(float* const* tblChannels, std::uint16_t channels,
+                        std::uint32_t frames)
+{
+	KA3D_PROFILE_SCOPE("Convolver::process");
+	if(channels != m_uChannels)
+		setChannels(channels);
+
+	std::uint32_t done(0);
+	while(done < frames)
+	{
+		std::uint32_t count(std::min(frames - done, m_uBlockSize - m_uFill));
+		for(std::uint16_t c=0; c<channels; ++c)
+		{
+			float* pIO(tblChannels[c] + done);
+			float* pInput(m_tblInput.data() + c*2*m_uBlockSize + m_uFill);
+			const float* pOutput(m_tblOutput.data() + c*m_uBlockSize + m_uFill);
+			for(std::uint32_t i=0; i<count; ++i)
+			{
+				float sample(pIO[i]);
+				pIO[i] = m_fDry*pInput[i] + m_fWet*pOutput[i];
+				pInput[m_uBlockSize + i] = sample;
+			}
+		}
+		m_uFill += count;
+		done += count;
+		if(m_uFill == m_uBlockSize)
+		{
+			processBlock();
+			m_uFill = 0;
+		}
+	}
+}
+
+void Convolver::processBlock()
+{
+	std::uint32_t size(2*m_uBlockSize);
+	if(m_uPartitions == 0)
+	{
+		std::fill(m_tblOutput.begin(), m_tblOutput.end(), 0.f);
+		for(std::uint16_t c=0; c<m_uChannels; ++c)
+		{
+			float* pInput(m_tblInput.data() + c*size);
+			std::copy(pInput + m_uBlockSize, pInput + size, pInput);
+		}
+		return;
+	}
+
+	m_uHead = (m_uHead + 1) % m_uPartitions;
+	for(std::uint16_t c=0; c<m_uChannels; ++c)
+	{
+		float* pInput(m_tblInput.data() + c*size);
+		std::uint16_t irChannel(std::min<std::uint16_t>(c, m_uIrChannels-1));
+		std::size_t delayBase(c * m_uPartitions * m_uBins);
+		std::size_t irBase(irChannel * m_uPartitions * m_uBins);
+
+		// Spectre de [bloc précédent | bloc courant], rangé en tête de ligne
+		std::copy(pInput, pInput + size, m_tblWorkRe.begin());
+		std::fill(m_tblWorkIm.begin(), m_tblWorkIm.end(), 0.f);
+		m_pFFT->forward(m_tblWorkRe.data(), m_tblWorkIm.data());
+		std::copy(m_tblWorkRe.begin(), m_tblWorkRe.begin() + m_uBins,
+		          m_tblDelayRe.begin() + delayBase + m_uHead*m_uBins);
+		std::copy(m_tblWorkIm.begin(), m_tblWorkIm.begin() + m_uBins,
+		          m_tblDelayIm.begin() + delayBase + m_uHead*m_uBins);
+
+		// Somme des produits spectre retardé de p blocs × partition p
+		std::fill(m_tblAccRe.begin(), m_tblAccRe.end(), 0.f);
+		std::fill(m_tblAccIm.begin(), m_tblAccIm.end(), 0.f);
+		for(std::uint32_t p=0; p<m_uPartitions; ++p)
+		{
+			std::uint32_t slot((m_uHead + m_uPartitions - p) % m_uPartitions);
+			std::size_t delay(delayBase + slot*m_uBins);
+			std::size_t ir(irBase + p*m_uBins);
+			mixComplexMulAdd(m_tblAccRe.data(), m_tblAccIm.data(),
+			                 &m_tblDelayRe[delay], &m_tblDelayIm[delay],
+			                 &m_tblIrRe[ir], &m_tblIrIm[ir], m_uBins);
+		}
+
+		// Signal réel : spectre à symétrie hermitienne
+		std::copy(m_tblAccRe.begin(), m_tblAccRe.end(), m_tblWorkRe.begin());
+		std::copy(m_tblAccIm.begin(), m_tblAccIm.end(), m_tblWorkIm.begin());
+		for(std::uint32_t k=1; k<m_uBlockSize; ++k)
+		{
+			m_tblWorkRe[size-k] = m_tblAccRe[k];
+			m_tblWorkIm[size-k] = -m_tblAccIm[k];
+		}
+		m_pFFT->inverse(m_tblWorkRe.data(), m_tblWorkIm.data());
+
+		// Overlap-save : seule la seconde moitié est valide
+		std::copy(m_tblWorkRe.begin() + m_uBlockSize, m_tblWorkRe.end(),
+		          m_tblOutput.begin() + c*m_uBlockSize);
+		std::copy(pInput + m_uBlockSize, pInput + size, pInput);
+	}
+}
+
+} // namespace KA3D
@@ -29,18 +29,25 @@
 
 
 #include <AL/al.h>
+#include <AL/alc.h>
 
 
 #include <cassert>
 #include <cstdint>
 
+#include <algorithm>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 
-#include "DataPrivate.h"
+#include "Context.h"
 #include "Error.h"
+#include "Extensions.h"
+#include "MixKernels.h"
+#include "ProfilerPrivate.h"
 #include "KA3D/WaveFile.h"
 
 namespace KA3D
@@ -51,50 +58,99 @@ static const struct
 	const char* name;
 	std::uint16_t channels, bytesPerSample;
 	ALenum format;
+	bool Extensions::* pExtension; //!< Extension requise (nullptr : aucune)
+	DataFormat fallback; //!< Format converti sans l'extension
 } tblAudioFormat[] = {
-	{"DF_MONO8", 1, 1, AL_FORMAT_MONO8},
-	{"DF_MONO16", 1, 2, AL_FORMAT_MONO16},
-	{"DF_STEREO8", 2, 1, AL_FORMAT_STEREO8},
-	{"DF_STEREO16", 2, 2, AL_FORMAT_STEREO16},
+	{"DF_MONO8", 1, 1, AL_FORMAT_MONO8, nullptr, DF_MONO8},
+	{"DF_MONO16", 1, 2, AL_FORMAT_MONO16, nullptr, DF_MONO16},
+	{"DF_STEREO8", 2, 1, AL_FORMAT_STEREO8, nullptr, DF_STEREO8},
+	{"DF_STEREO16", 2, 2, AL_FORMAT_STEREO16, nullptr, DF_STEREO16},
+	{"DF_MONO_FLOAT32", 1, 4, AL_FORMAT_MONO_FLOAT32,
+	 &Extensions::hasFloat32, DF_MONO16},
+	{"DF_STEREO_FLOAT32", 2, 4, AL_FORMAT_STEREO_FLOAT32,
+	 &Extensions::hasFloat32, DF_STEREO16},
+	{"DF_QUAD8", 4, 1, AL_FORMAT_QUAD8, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_QUAD16", 4, 2, AL_FORMAT_QUAD16, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_QUAD_FLOAT32", 4, 4, AL_FORMAT_QUAD32,
+	 &Extensions::hasMCFormats, DF_LAST},
+	{"DF_51CHN8", 6, 1, AL_FORMAT_51CHN8, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_51CHN16", 6, 2, AL_FORMAT_51CHN16, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_51CHN_FLOAT32", 6, 4, AL_FORMAT_51CHN32,
+	 &Extensions::hasMCFormats, DF_LAST},
+	{"DF_61CHN8", 7, 1, AL_FORMAT_61CHN8, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_61CHN16", 7, 2, AL_FORMAT_61CHN16, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_61CHN_FLOAT32", 7, 4, AL_FORMAT_61CHN32,
+	 &Extensions::hasMCFormats, DF_LAST},
+	{"DF_71CHN8", 8, 1, AL_FORMAT_71CHN8, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_71CHN16", 8, 2, AL_FORMAT_71CHN16, &Extensions::hasMCFormats, DF_LAST},
+	{"DF_71CHN_FLOAT32", 8, 4, AL_FORMAT_71CHN32,
+	 &Extensions::hasMCFormats, DF_LAST},
 
-	{"DF_LAST", 0, 0, 0}
+	{"DF_LAST", 0, 0, 0, nullptr, DF_LAST}
 };
 
 static inline ALenum audioDataFormatConvert(DataFormat format);
+static bool releaseBuffer(ALuint handle) noexcept;
+
+//! Fréquence utilisée pour vider un buffer rendu à la réserve
+const ALsizei EMPTY_BUFFER_FREQ = 22050;
+
+//! Buffers dont la suppression a été différée (encore attachés à une source)
+static std::vector<ALuint> tblPendingBuffers;
+static std::mutex mtxPendingBuffers;
 
 
 Data* Data::fromData(const std::vector<std::uint8_t>& tblData,
                                DataFormat format, std::int32_t freq)
 {
-	DataPrivate* privateData(new DataPrivate);
+	KA3D_PROFILE_SCOPE("Data::fromData");
+	KA3D_PROFILE_COUNT(PC_BUFFER_UPLOAD);
+	KA3D_PROFILE_ADD(PC_BUFFER_UPLOAD_BYTES, tblData.size());
+	ContextLock contextLock;
+	ALuint handle(0);
+	Context* pContext(Context::current());
 	try
 	{
-		alGenBuffers(1, &privateData->handle);
-		checkALError();
-		alBufferData(privateData->handle, audioDataFormatConvert(format),
-		             tblData.data(), tblData.size(), freq);
+		if(!pContext)
+			throw std::runtime_error("No current audio context");
+
+		// Buffer pré-alloué (cf. Listener::setBufferPool)
+		handle = pContext->buffers().pop();
+		bufferData(handle, format, tblData.data(), tblData.size(), freq);
 		checkALError();
 	}
-	catch(std::runtime_error& e)
+	catch(std::exception& e)
 	{
-		if(privateData->handle)
-			alDeleteBuffers(1, &privateData->handle);
-		delete privateData;
+		// Le buffer reste vide : rendu à la réserve
+		if(handle)
+			pContext->buffers().push(handle);
 
 		std::ostringstream msg;
 		msg << "Unable to create audio buffer data: " << e.what();
 		throw std::runtime_error(msg.str());
 	}
-	return new Data(privateData);
+	return new Data(handle, freq);
 }
 
 Data* Data::fromWav(std::iostream& file)
 {
+	WaveFile waveFile(file);
+	return fromWave(waveFile);
+}
+
+Data* Data::fromWav(Reader& reader)
+{
+	WaveFile waveFile(reader);
+	return fromWave(waveFile);
+}
+
+Data* Data::fromWave(WaveFile& waveFile)
+{
+	KA3D_PROFILE_SCOPE("Data::fromWav");
 	std::vector<std::uint8_t> tblData;
 	DataFormat format;
 	std::uint32_t freq;
 
-	WaveFile waveFile(file);
 	waveFile.open(std::ios_base::in);
 
 	format = waveFile.format();
@@ -105,21 +161,137 @@ Data* Data::fromWav(std::iostream& file)
 
 	waveFile.close();
 
-	return fromData(tblData, format, freq);
+	Data* pData(fromData(tblData, format, freq));
+	try
+	{
+		if(waveFile.hasLoop())
+			pData->setLoopPoints(waveFile.loopStart(), waveFile.loopEnd());
+		pData->setMarkers(waveFile.markers());
+	}
+	catch(...)
+	{
+		pData->unref();
+		throw;
+	}
+	return pData;
 }
 
-Data::Data(DataPrivate* pData) noexcept:
-	m_pData(pData)
+static_assert(sizeof(std::uint32_t) == sizeof(ALuint),
+              "ALuint must be stored inline as std::uint32_t");
+
+Data::Data(std::uint32_t uHandle, std::int32_t freq) noexcept:
+	m_uHandle(uHandle),
+	m_uRefCount(1),
+	m_uLoopStart(0),
+	m_uLoopEnd(0),
+	m_tblMarkers(),
+	m_iFrequency(freq)
 { }
 
 Data::~Data() noexcept
 {
-	alDeleteBuffers(1, &m_pData->handle);
-	delete m_pData;
+	if(!releaseBuffer(m_uHandle))
+	{
+		std::lock_guard<std::mutex> lock(mtxPendingBuffers);
+		tblPendingBuffers.push_back(m_uHandle);
+	}
+}
+
+void Data::ref() noexcept
+{
+	m_uRefCount.fetch_add(1, std::memory_order_relaxed);
 }
-DataPrivate* Data::data() noexcept
+
+void Data::unref() noexcept
+{
+	assert(m_uRefCount.load(std::memory_order_relaxed) > 0);
+	if(m_uRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete this;
+}
+
+std::uint32_t Data::refCount() const noexcept
+{
+	return m_uRefCount.load(std::memory_order_relaxed);
+}
+
+std::size_t Data::collect()
+{
+	KA3D_PROFILE_SCOPE("Data::collect");
+	std::vector<ALuint> tblPending;
+	{
+		std::lock_guard<std::mutex> lock(mtxPendingBuffers);
+		tblPending.swap(tblPendingBuffers);
+	}
+
+	std::vector<ALuint> tblRemaining;
+	for(ALuint handle : tblPending)
+	{
+		if(!releaseBuffer(handle))
+			tblRemaining.push_back(handle);
+	}
+
+	std::lock_guard<std::mutex> lock(mtxPendingBuffers);
+	tblPendingBuffers.insert(tblPendingBuffers.end(),
+	                         tblRemaining.begin(), tblRemaining.end());
+	return tblPendingBuffers.size();
+}
+
+std::uint32_t Data::handle() const noexcept
 {
-	return m_pData;
+	return m_uHandle;
+}
+
+void Data::setLoopPoints(std::uint32_t start, std::uint32_t end)
+{
+	ContextLock contextLock;
+	try
+	{
+		if(start >= end)
+			throw std::runtime_error("Empty loop");
+		if(isLoopPointsSupported())
+		{
+			ALint tblPoints[2] = {static_cast<ALint>(start),
+			                      static_cast<ALint>(end)};
+			alBufferiv(m_uHandle, AL_LOOP_POINTS_SOFT, tblPoints);
+			checkALError();
+		}
+	}
+	catch(std::runtime_error& e)
+	{
+		std::ostringstream msg;
+		msg << "Unable to set loop points: " << e.what();
+		throw std::runtime_error(msg.str());
+	}
+	m_uLoopStart = start;
+	m_uLoopEnd = end;
+}
+
+std::uint32_t Data::loopStart() const noexcept
+{
+	return m_uLoopStart;
+}
+
+std::uint32_t Data::loopEnd() const noexcept
+{
+	return m_uLoopEnd;
+}
+
+void Data::setMarkers(std::vector<Marker> tblMarkers)
+{
+	std::stable_sort(tblMarkers.begin(), tblMarkers.end(),
+	                 [](const Marker& a, const Marker& b)
+	                 { return a.position < b.position; });
+	m_tblMarkers = std::move(tblMarkers);
+}
+
+const std::vector<Marker>& Data::markers() const noexcept
+{
+	return m_tblMarkers;
+}
+
+std::int32_t Data::frequency() const noexcept
+{
+	return m_iFrequency;
 }
 
 const char* Data::formatName(DataFormat format) noexcept
@@ -144,18 +316,65 @@ std::uint16_t Data::formatPitch(DataFormat format) noexcept
 {
 	return formatChannels(format) * formatBytesPerSample(format);
 }
+
+std::int32_t Data::formatAL(DataFormat format) noexcept
+{
+	return audioDataFormatConvert(format);
+}
+
+bool Data::isFormatNative(DataFormat format) noexcept
+{
+	assert(format < DF_LAST);
+	bool Extensions::* pExtension(tblAudioFormat[format].pExtension);
+	if(!pExtension)
+		return true;
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().*pExtension;
+}
+
+void Data::bufferData(std::uint32_t uHandle, DataFormat format,
+                      const void* data, std::size_t size, std::int32_t freq)
+{
+	ContextLock contextLock;
+	if(!isFormatNative(format) && tblAudioFormat[format].fallback == DF_LAST)
+	{
+		std::ostringstream msg;
+		msg << "Unsupported format " << formatName(format)
+		    << ": AL_EXT_MCFORMATS not supported";
+		throw std::runtime_error(msg.str());
+	}
+	if(!isFormatNative(format))
+	{
+		// Flottants convertis en 16 bits (tampon réutilisé par fil)
+		static thread_local std::vector<std::int16_t> tblConvert;
+		std::size_t count(size / sizeof(float));
+		tblConvert.resize(count);
+		convertFloatToS16(tblConvert.data(), static_cast<const float*>(data),
+		                  static_cast<std::uint32_t>(count));
+		format = tblAudioFormat[format].fallback;
+		data = tblConvert.data();
+		size = count * sizeof(std::int16_t);
+	}
+	alBufferData(uHandle, audioDataFormatConvert(format), data,
+	             static_cast<ALsizei>(size), freq);
+}
+
+bool Data::isLoopPointsSupported() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().hasLoopPoints;
+}
+
 DataFormat
 Data::formatFromPerSample(std::uint16_t channels,
                                std::uint16_t bytesPerSample) noexcept
 {
-	if(channels == 1 && bytesPerSample == 1)
-		return DF_MONO8;
-	if(channels == 1 && bytesPerSample == 2)
-		return DF_MONO16;
-	if(channels == 2 && bytesPerSample == 1)
-		return DF_STEREO8;
-	if(channels == 2 && bytesPerSample == 2)
-		return DF_STEREO16;
+	for(int format=DF_MONO8; format<DF_LAST; ++format)
+	{
+		if(tblAudioFormat[format].channels == channels &&
+		   tblAudioFormat[format].bytesPerSample == bytesPerSample)
+			return static_cast<DataFormat>(format);
+	}
 	return DF_LAST;
 }
 
@@ -165,4 +384,29 @@ static inline ALenum audioDataFormatConvert(DataFormat format)
 	return tblAudioFormat[format].format;
 }
 
+// Rend un buffer à la réserve (vidé) ou le supprime,
+// échoue s'il est encore attaché ou sans contexte courant
+static bool releaseBuffer(ALuint handle) noexcept
+{
+	if(alcGetCurrentContext() == nullptr)
+		return false;
+
+	ContextLock contextLock;
+	Context* pContext(Context::current());
+	if(pContext)
+	{
+		alGetError(); // Erreur antérieure : ne doit pas être prise pour un échec
+		alBufferData(handle, AL_FORMAT_MONO8, nullptr, 0, EMPTY_BUFFER_FREQ);
+		if(alGetError() == AL_NO_ERROR)
+		{
+			pContext->buffers().push(handle);
+			return true;
+		}
+	}
+
+	alGetError();
+	alDeleteBuffers(1, &handle);
+	return (alGetError() == AL_NO_ERROR);
+}
+
 } // namespace KA3D
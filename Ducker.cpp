@@ -0,0 +1,152 @@
+/**
+ *
+ * @file Ducker.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'atténuation par déclenchement (ducking) (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Ducker.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "KA3D/Bus.h"
+
+namespace KA3D
+{
+
+Ducker::Ducker(float fDepth, float fAttack, float fRelease, float fThreshold):
+	m_fDepth(fDepth),
+	m_fAttack(fAttack),
+	m_fRelease(fRelease),
+	m_fThreshold(fThreshold),
+	m_fEnvelope(0.f),
+	m_pTrigger(nullptr),
+	m_tblTargets(),
+	m_mutex()
+{ }
+
+Ducker::~Ducker() noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(Bus* pBus : m_tblTargets)
+		pBus->setDuckGain(1.f);
+}
+
+void Ducker::setTrigger(Bus* pBus) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pTrigger = pBus;
+}
+
+void Ducker::addTarget(Bus& bus)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_tblTargets.push_back(&bus);
+	bus.setDuckGain(targetGain());
+}
+
+void Ducker::removeTarget(Bus& bus) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_tblTargets.erase(std::remove(m_tblTargets.begin(), m_tblTargets.end(),
+	                               &bus), m_tblTargets.end());
+	bus.setDuckGain(1.f);
+}
+
+void Ducker::setDepth(float fDepth) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_fDepth = fDepth;
+}
+
+void Ducker::setTimes(float fAttack, float fRelease) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_fAttack = fAttack;
+	m_fRelease = fRelease;
+}
+
+void Ducker::setThreshold(float fThreshold) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_fThreshold = fThreshold;
+}
+
+void Ducker::update(float fDelta)
+{
+	Bus* pTrigger;
+	float fThreshold;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		pTrigger = m_pTrigger;
+		fThreshold = m_fThreshold;
+	}
+
+	// Hors verrou : Bus::isPlaying interroge le pilote
+	bool isActive(pTrigger && pTrigger->isPlaying());
+	update(fDelta, isActive ? std::max(fThreshold, 1.f) : 0.f);
+}
+
+void Ducker::update(float fDelta, float fLevel) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// Enveloppe linéaire : l'attaque et le relâchement durent exactement
+	// les temps demandés, quel que soit le pas
+	if(fLevel >= m_fThreshold && fLevel > 0.f)
+	{
+		m_fEnvelope = m_fAttack > 0.f ?
+			std::min(1.f, m_fEnvelope + fDelta / m_fAttack) : 1.f;
+	}
+	else
+	{
+		m_fEnvelope = m_fRelease > 0.f ?
+			std::max(0.f, m_fEnvelope - fDelta / m_fRelease) : 0.f;
+	}
+
+	// Le bus ne marque sa branche modifiée que si le volume change
+	float fGain(targetGain());
+	for(Bus* pBus : m_tblTargets)
+		pBus->setDuckGain(fGain);
+}
+
+float Ducker::envelope() const noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_fEnvelope;
+}
+
+float Ducker::gain() const noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return targetGain();
+}
+
+float Ducker::targetGain() const noexcept
+{
+	return 1.f + m_fEnvelope * (m_fDepth - 1.f);
+}
+
+} // namespace KA3D
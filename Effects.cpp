@@ -0,0 +1,574 @@
+/**
+ *
+ * @file Effects.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les effets auxiliaires (EFX) et les zones de réverbération (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/Effects.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Extensions.h doit précéder EFX-Util.h (définition de __cdecl)
+#include "Extensions.h"
+
+#include <AL/al.h>
+#include <AL/EFX-Util.h>
+
+#include "Context.h"
+#include "Error.h"
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+//! Préréglages EAX au format historique (convertis par convertReverb)
+static const EAXREVERBPROPERTIES tblReverbPreset[] = {
+	REVERB_PRESET_GENERIC,
+	REVERB_PRESET_PADDEDCELL,
+	REVERB_PRESET_ROOM,
+	REVERB_PRESET_BATHROOM,
+	REVERB_PRESET_LIVINGROOM,
+	REVERB_PRESET_STONEROOM,
+	REVERB_PRESET_AUDITORIUM,
+	REVERB_PRESET_CONCERTHALL,
+	REVERB_PRESET_CAVE,
+	REVERB_PRESET_ARENA,
+	REVERB_PRESET_HANGAR,
+	REVERB_PRESET_CARPETTEDHALLWAY,
+	REVERB_PRESET_HALLWAY,
+	REVERB_PRESET_STONECORRIDOR,
+	REVERB_PRESET_ALLEY,
+	REVERB_PRESET_FOREST,
+	REVERB_PRESET_CITY,
+	REVERB_PRESET_MOUNTAINS,
+	REVERB_PRESET_QUARRY,
+	REVERB_PRESET_PLAIN,
+	REVERB_PRESET_PARKINGLOT,
+	REVERB_PRESET_SEWERPIPE,
+	REVERB_PRESET_UNDERWATER,
+	REVERB_PRESET_DRUGGED,
+	REVERB_PRESET_DIZZY,
+	REVERB_PRESET_PSYCHOTIC
+};
+static_assert(sizeof(tblReverbPreset)/sizeof(tblReverbPreset[0]) == RP_LAST,
+              "tblReverbPreset must match ReverbPreset");
+
+static const EchoProperties tblEchoPreset[] = {
+	{AL_ECHO_DEFAULT_DELAY, AL_ECHO_DEFAULT_LRDELAY, AL_ECHO_DEFAULT_DAMPING,
+	 AL_ECHO_DEFAULT_FEEDBACK, AL_ECHO_DEFAULT_SPREAD}, // EP_DEFAULT
+	{0.08f, 0.f, 0.3f, 0.f, 0.f}, // EP_SLAPBACK
+	{0.207f, 0.3f, 0.6f, 0.6f, -0.8f} // EP_CANYON
+};
+static_assert(sizeof(tblEchoPreset)/sizeof(tblEchoPreset[0]) == EP_LAST,
+              "tblEchoPreset must match EchoPreset");
+
+//! Drapeau EAX de limitation de la décroissance des aigus
+static const unsigned long EAXREVERB_FLAG_DECAYHFLIMIT = 0x20;
+
+static inline float millibelToGain(float mB) noexcept
+{
+	return std::pow(10.f, mB / 2000.f);
+}
+
+// Équivalent de ConvertReverbParameters (EFX-Util), sans la bibliothèque
+static void convertReverb(const EAXREVERBPROPERTIES& eax,
+                          EFXEAXREVERBPROPERTIES& efx) noexcept
+{
+	efx.flDensity = std::min(1.f, std::pow(eax.flEnvironmentSize, 3.f) / 16.f);
+	efx.flDiffusion = eax.flEnvironmentDiffusion;
+	efx.flGain = millibelToGain(static_cast<float>(eax.lRoom));
+	efx.flGainHF = millibelToGain(static_cast<float>(eax.lRoomHF));
+	efx.flGainLF = millibelToGain(static_cast<float>(eax.lRoomLF));
+	efx.flDecayTime = eax.flDecayTime;
+	efx.flDecayHFRatio = eax.flDecayHFRatio;
+	efx.flDecayLFRatio = eax.flDecayLFRatio;
+	efx.flReflectionsGain = millibelToGain(static_cast<float>(eax.lReflections));
+	efx.flReflectionsDelay = eax.flReflectionsDelay;
+	efx.flReflectionsPan[0] = eax.vReflectionsPan.x;
+	efx.flReflectionsPan[1] = eax.vReflectionsPan.y;
+	efx.flReflectionsPan[2] = eax.vReflectionsPan.z;
+	efx.flLateReverbGain = millibelToGain(static_cast<float>(eax.lReverb));
+	efx.flLateReverbDelay = eax.flReverbDelay;
+	efx.flLateReverbPan[0] = eax.vReverbPan.x;
+	efx.flLateReverbPan[1] = eax.vReverbPan.y;
+	efx.flLateReverbPan[2] = eax.vReverbPan.z;
+	efx.flEchoTime = eax.flEchoTime;
+	efx.flEchoDepth = eax.flEchoDepth;
+	efx.flModulationTime = eax.flModulationTime;
+	efx.flModulationDepth = eax.flModulationDepth;
+	efx.flAirAbsorptionGainHF = millibelToGain(eax.flAirAbsorptionHF);
+	efx.flHFReference = eax.flHFReference;
+	efx.flLFReference = eax.flLFReference;
+	efx.flRoomRolloffFactor = eax.flRoomRolloffFactor;
+	efx.iDecayHFLimit = (eax.ulFlags & EAXREVERB_FLAG_DECAYHFLIMIT) ? 1 : 0;
+}
+
+static inline const Extensions& efx()
+{
+	Context* pContext(Context::current());
+	if(!pContext || !pContext->extensions().alGenEffects)
+		throw std::runtime_error("ALC_EXT_EFX not supported");
+	return pContext->extensions();
+}
+
+// Envoie une réverbération à un effet et la charge dans son emplacement
+// (copie : alEffectfv du SDK Creative prend des pointeurs non constants)
+static void uploadReverb(ALuint effect, ALuint slot,
+                         EFXEAXREVERBPROPERTIES prop)
+{
+	const Extensions& ext(efx());
+
+	// Réverbération EAX si disponible, sinon réverbération standard
+	alGetError();
+	ext.alEffecti(effect, AL_EFFECT_TYPE, AL_EFFECT_EAXREVERB);
+	if(alGetError() == AL_NO_ERROR)
+	{
+		ext.alEffectf(effect, AL_EAXREVERB_DENSITY, prop.flDensity);
+		ext.alEffectf(effect, AL_EAXREVERB_DIFFUSION, prop.flDiffusion);
+		ext.alEffectf(effect, AL_EAXREVERB_GAIN, prop.flGain);
+		ext.alEffectf(effect, AL_EAXREVERB_GAINHF, prop.flGainHF);
+		ext.alEffectf(effect, AL_EAXREVERB_GAINLF, prop.flGainLF);
+		ext.alEffectf(effect, AL_EAXREVERB_DECAY_TIME, prop.flDecayTime);
+		ext.alEffectf(effect, AL_EAXREVERB_DECAY_HFRATIO, prop.flDecayHFRatio);
+		ext.alEffectf(effect, AL_EAXREVERB_DECAY_LFRATIO, prop.flDecayLFRatio);
+		ext.alEffectf(effect, AL_EAXREVERB_REFLECTIONS_GAIN,
+		              prop.flReflectionsGain);
+		ext.alEffectf(effect, AL_EAXREVERB_REFLECTIONS_DELAY,
+		              prop.flReflectionsDelay);
+		ext.alEffectfv(effect, AL_EAXREVERB_REFLECTIONS_PAN,
+		               prop.flReflectionsPan);
+		ext.alEffectf(effect, AL_EAXREVERB_LATE_REVERB_GAIN,
+		              prop.flLateReverbGain);
+		ext.alEffectf(effect, AL_EAXREVERB_LATE_REVERB_DELAY,
+		              prop.flLateReverbDelay);
+		ext.alEffectfv(effect, AL_EAXREVERB_LATE_REVERB_PAN,
+		               prop.flLateReverbPan);
+		ext.alEffectf(effect, AL_EAXREVERB_ECHO_TIME, prop.flEchoTime);
+		ext.alEffectf(effect, AL_EAXREVERB_ECHO_DEPTH, prop.flEchoDepth);
+		ext.alEffectf(effect, AL_EAXREVERB_MODULATION_TIME,
+		              prop.flModulationTime);
+		ext.alEffectf(effect, AL_EAXREVERB_MODULATION_DEPTH,
+		              prop.flModulationDepth);
+		ext.alEffectf(effect, AL_EAXREVERB_AIR_ABSORPTION_GAINHF,
+		              prop.flAirAbsorptionGainHF);
+		ext.alEffectf(effect, AL_EAXREVERB_HFREFERENCE, prop.flHFReference);
+		ext.alEffectf(effect, AL_EAXREVERB_LFREFERENCE, prop.flLFReference);
+		ext.alEffectf(effect, AL_EAXREVERB_ROOM_ROLLOFF_FACTOR,
+		              prop.flRoomRolloffFactor);
+		ext.alEffecti(effect, AL_EAXREVERB_DECAY_HFLIMIT, prop.iDecayHFLimit);
+	}
+	else
+	{
+		ext.alEffecti(effect, AL_EFFECT_TYPE, AL_EFFECT_REVERB);
+		ext.alEffectf(effect, AL_REVERB_DENSITY, prop.flDensity);
+		ext.alEffectf(effect, AL_REVERB_DIFFUSION, prop.flDiffusion);
+		ext.alEffectf(effect, AL_REVERB_GAIN, prop.flGain);
+		ext.alEffectf(effect, AL_REVERB_GAINHF, prop.flGainHF);
+		ext.alEffectf(effect, AL_REVERB_DECAY_TIME, prop.flDecayTime);
+		ext.alEffectf(effect, AL_REVERB_DECAY_HFRATIO, prop.flDecayHFRatio);
+		ext.alEffectf(effect, AL_REVERB_REFLECTIONS_GAIN,
+		              prop.flReflectionsGain);
+		ext.alEffectf(effect, AL_REVERB_REFLECTIONS_DELAY,
+		              prop.flReflectionsDelay);
+		ext.alEffectf(effect, AL_REVERB_LATE_REVERB_GAIN,
+		              prop.flLateReverbGain);
+		ext.alEffectf(effect, AL_REVERB_LATE_REVERB_DELAY,
+		              prop.flLateReverbDelay);
+		ext.alEffectf(effect, AL_REVERB_AIR_ABSORPTION_GAINHF,
+		              prop.flAirAbsorptionGainHF);
+		ext.alEffectf(effect, AL_REVERB_ROOM_ROLLOFF_FACTOR,
+		              prop.flRoomRolloffFactor);
+		ext.alEffecti(effect, AL_REVERB_DECAY_HFLIMIT, prop.iDecayHFLimit);
+	}
+	// Les paramètres sont copiés dans l'emplacement à l'attachement
+	ext.alAuxiliaryEffectSloti(slot, AL_EFFECTSLOT_EFFECT,
+	                           static_cast<ALint>(effect));
+	checkALError();
+}
+
+// Interpolation linéaire des paramètres de deux réverbérations
+static void blendReverbProperties(const EFXEAXREVERBPROPERTIES& from,
+                                  const EFXEAXREVERBPROPERTIES& to, float t,
+                                  EFXEAXREVERBPROPERTIES& prop) noexcept
+{
+	auto lerp = [t](float a, float b) { return a + (b - a) * t; };
+	prop.flDensity = lerp(from.flDensity, to.flDensity);
+	prop.flDiffusion = lerp(from.flDiffusion, to.flDiffusion);
+	prop.flGain = lerp(from.flGain, to.flGain);
+	prop.flGainHF = lerp(from.flGainHF, to.flGainHF);
+	prop.flGainLF = lerp(from.flGainLF, to.flGainLF);
+	prop.flDecayTime = lerp(from.flDecayTime, to.flDecayTime);
+	prop.flDecayHFRatio = lerp(from.flDecayHFRatio, to.flDecayHFRatio);
+	prop.flDecayLFRatio = lerp(from.flDecayLFRatio, to.flDecayLFRatio);
+	prop.flReflectionsGain = lerp(from.flReflectionsGain, to.flReflectionsGain);
+	prop.flReflectionsDelay = lerp(from.flReflectionsDelay,
+	                               to.flReflectionsDelay);
+	prop.flLateReverbGain = lerp(from.flLateReverbGain, to.flLateReverbGain);
+	prop.flLateReverbDelay = lerp(from.flLateReverbDelay, to.flLateReverbDelay);
+	for(int axis=0; axis<3; ++axis)
+	{
+		prop.flReflectionsPan[axis] = lerp(from.flReflectionsPan[axis],
+		                                   to.flReflectionsPan[axis]);
+		prop.flLateReverbPan[axis] = lerp(from.flLateReverbPan[axis],
+		                                  to.flLateReverbPan[axis]);
+	}
+	prop.flEchoTime = lerp(from.flEchoTime, to.flEchoTime);
+	prop.flEchoDepth = lerp(from.flEchoDepth, to.flEchoDepth);
+	prop.flModulationTime = lerp(from.flModulationTime, to.flModulationTime);
+	prop.flModulationDepth = lerp(from.flModulationDepth, to.flModulationDepth);
+	prop.flAirAbsorptionGainHF = lerp(from.flAirAbsorptionGainHF,
+	                                  to.flAirAbsorptionGainHF);
+	prop.flHFReference = lerp(from.flHFReference, to.flHFReference);
+	prop.flLFReference = lerp(from.flLFReference, to.flLFReference);
+	prop.flRoomRolloffFactor = lerp(from.flRoomRolloffFactor,
+	                                to.flRoomRolloffFactor);
+	prop.iDecayHFLimit = t < 0.5f ? from.iDecayHFLimit : to.iDecayHFLimit;
+}
+
+bool Effects::isSupported() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().alGenEffects;
+}
+
+EchoProperties Effects::echoPreset(EchoPreset preset) noexcept
+{
+	assert(preset < EP_LAST);
+	return tblEchoPreset[preset];
+}
+
+Effects::Effects(std::uint16_t zoneSlots, std::uint16_t freeSlots):
+	m_uZoneSlots(zoneSlots),
+	m_uSlots(zoneSlots + freeSlots),
+	m_tblSlots(),
+	m_tblEffects(),
+	m_tblGains(),
+	m_tblSlotEffects(),
+	m_tblSlotZone(),
+	m_tblZones(),
+	m_tblWeights(),
+	m_tblSelected()
+{ }
+
+Effects::~Effects() noexcept
+{ }
+
+void Effects::Init()
+{
+	KA3D_PROFILE_SCOPE("Effects::Init");
+	ContextLock contextLock;
+	try
+	{
+		const Extensions& ext(efx());
+		std::vector<ALuint> tblSlots(m_uSlots);
+		std::vector<ALuint> tblEffects(m_uSlots);
+
+		// Un seul appel au pilote pour tous les emplacements et effets
+		ext.alGenAuxiliaryEffectSlots(m_uSlots, tblSlots.data());
+		checkALError();
+		ext.alGenEffects(m_uSlots, tblEffects.data());
+		if(alGetError() != AL_NO_ERROR)
+		{
+			ext.alDeleteAuxiliaryEffectSlots(m_uSlots, tblSlots.data());
+			throw std::runtime_error("Unable to generate effects");
+		}
+
+		m_tblSlots.assign(tblSlots.begin(), tblSlots.end());
+		m_tblEffects.assign(tblEffects.begin(), tblEffects.end());
+		m_tblGains.assign(m_uSlots, 1.f);
+		SlotEffect none = {ET_NONE, RP_GENERIC, echoPreset(EP_DEFAULT)};
+		m_tblSlotEffects.assign(m_uSlots, none);
+		m_tblSlotZone.assign(m_uSlots, -1);
+		m_tblSelected.reserve(m_uZoneSlots);
+		for(std::uint16_t slot=0; slot<m_uZoneSlots; ++slot)
+			applyGain(slot, 0.f);
+	}
+	catch(std::exception& e)
+	{
+		throw std::runtime_error(std::string("Unable to initialize effects: ")
+		                         + e.what());
+	}
+}
+
+void Effects::Quit()
+{
+	ContextLock contextLock;
+	if(m_tblSlots.empty())
+		return;
+	const Extensions& ext(efx());
+	std::vector<ALuint> tblNames(m_tblSlots.begin(), m_tblSlots.end());
+	ext.alDeleteAuxiliaryEffectSlots(m_uSlots, tblNames.data());
+	tblNames.assign(m_tblEffects.begin(), m_tblEffects.end());
+	ext.alDeleteEffects(m_uSlots, tblNames.data());
+	m_tblSlots.clear();
+	m_tblEffects.clear();
+	m_tblSlotEffects.clear();
+	checkALError();
+}
+
+std::uint16_t Effects::slotCount() const noexcept
+{
+	return m_uSlots;
+}
+
+std::uint16_t Effects::zoneSlotCount() const noexcept
+{
+	return m_uZoneSlots;
+}
+
+std::uint16_t Effects::maxSends() const noexcept
+{
+	Context* pContext(Context::current());
+	return pContext ? static_cast<std::uint16_t>(
+		pContext->extensions().iMaxAuxiliarySends) : 0;
+}
+
+void Effects::loadReverb(std::uint16_t slot, ReverbPreset preset)
+{
+	assert(preset < RP_LAST);
+	EFXEAXREVERBPROPERTIES prop;
+	convertReverb(tblReverbPreset[preset], prop);
+	uploadReverb(m_tblEffects[slot], m_tblSlots[slot], prop);
+	m_tblSlotEffects[slot].type = ET_REVERB;
+	m_tblSlotEffects[slot].reverb = preset;
+}
+
+void Effects::applyGain(std::uint16_t slot, float fGain)
+{
+	if(std::fabs(m_tblGains[slot] - fGain) < 1e-3f &&
+	   (fGain != 0.f || m_tblGains[slot] == 0.f))
+	{
+		return;
+	}
+	efx().alAuxiliaryEffectSlotf(m_tblSlots[slot], AL_EFFECTSLOT_GAIN, fGain);
+	checkALError();
+	m_tblGains[slot] = fGain;
+}
+
+void Effects::setReverb(std::uint16_t slot, ReverbPreset preset)
+{
+	ContextLock contextLock;
+	if(slot < m_uZoneSlots || slot >= m_uSlots || m_tblSlots.empty())
+		throw std::runtime_error("Unable to set reverb: invalid effect slot");
+	loadReverb(slot, preset);
+}
+
+void Effects::setEcho(std::uint16_t slot, const EchoProperties& echo)
+{
+	ContextLock contextLock;
+	if(slot < m_uZoneSlots || slot >= m_uSlots || m_tblSlots.empty())
+		throw std::runtime_error("Unable to set echo: invalid effect slot");
+	const Extensions& ext(efx());
+	ALuint effect(m_tblEffects[slot]);
+	ext.alEffecti(effect, AL_EFFECT_TYPE, AL_EFFECT_ECHO);
+	ext.alEffectf(effect, AL_ECHO_DELAY, echo.fDelay);
+	ext.alEffectf(effect, AL_ECHO_LRDELAY, echo.fLRDelay);
+	ext.alEffectf(effect, AL_ECHO_DAMPING, echo.fDamping);
+	ext.alEffectf(effect, AL_ECHO_FEEDBACK, echo.fFeedback);
+	ext.alEffectf(effect, AL_ECHO_SPREAD, echo.fSpread);
+	ext.alAuxiliaryEffectSloti(m_tblSlots[slot], AL_EFFECTSLOT_EFFECT,
+	                           static_cast<ALint>(effect));
+	checkALError();
+	m_tblSlotEffects[slot].type = ET_ECHO;
+	m_tblSlotEffects[slot].echo = echo;
+}
+
+void Effects::setSlotGain(std::uint16_t slot, float fGain)
+{
+	ContextLock contextLock;
+	if(slot < m_uZoneSlots || slot >= m_uSlots || m_tblSlots.empty())
+		throw std::runtime_error("Unable to set slot gain: invalid effect slot");
+	applyGain(slot, fGain);
+}
+
+float Effects::slotGain(std::uint16_t slot) const noexcept
+{
+	assert(slot < m_tblGains.size());
+	return m_tblGains[slot];
+}
+
+const SlotEffect& Effects::slotEffect(std::uint16_t slot) const noexcept
+{
+	assert(slot < m_tblSlotEffects.size());
+	return m_tblSlotEffects[slot];
+}
+
+void Effects::blendReverb(std::uint16_t slot, ReverbPreset from,
+                          ReverbPreset to, float t)
+{
+	ContextLock contextLock;
+	assert(from < RP_LAST && to < RP_LAST);
+	if(slot < m_uZoneSlots || slot >= m_uSlots || m_tblSlots.empty())
+		throw std::runtime_error("Unable to blend reverb: invalid effect slot");
+	EFXEAXREVERBPROPERTIES propFrom, propTo, prop;
+	convertReverb(tblReverbPreset[from], propFrom);
+	convertReverb(tblReverbPreset[to], propTo);
+	blendReverbProperties(propFrom, propTo, t, prop);
+	uploadReverb(m_tblEffects[slot], m_tblSlots[slot], prop);
+	m_tblSlotEffects[slot].type = ET_REVERB;
+	m_tblSlotEffects[slot].reverb = t < 0.5f ? from : to;
+}
+
+void Effects::attach(Source& source)
+{
+	ContextLock contextLock;
+	std::uint16_t count(std::min(m_uSlots, maxSends()));
+	for(std::uint16_t send=0; send<count; ++send)
+		attach(source, send, send);
+}
+
+void Effects::attach(Source& source, std::uint16_t send, std::uint16_t slot)
+{
+	ContextLock contextLock;
+	if(slot >= m_tblSlots.size() || send >= maxSends())
+		throw std::runtime_error("Unable to attach source: invalid send");
+	alSource3i(source.handle(), AL_AUXILIARY_SEND_FILTER,
+	           static_cast<ALint>(m_tblSlots[slot]), send, AL_FILTER_NULL);
+	checkALError();
+}
+
+void Effects::detach(Source& source)
+{
+	ContextLock contextLock;
+	std::uint16_t count(maxSends());
+	for(std::uint16_t send=0; send<count; ++send)
+	{
+		alSource3i(source.handle(), AL_AUXILIARY_SEND_FILTER,
+		           AL_EFFECTSLOT_NULL, send, AL_FILTER_NULL);
+	}
+	checkALError();
+}
+
+std::uint32_t Effects::addZone(ReverbPreset preset, float xpos, float ypos,
+                               float zpos, float fRadius, float fFade)
+{
+	assert(preset < RP_LAST);
+	Zone zone = {preset, {xpos, ypos, zpos}, fRadius, fFade, true};
+	for(std::uint32_t i=0; i<m_tblZones.size(); ++i)
+	{
+		if(!m_tblZones[i].isUsed)
+		{
+			m_tblZones[i] = zone;
+			return i;
+		}
+	}
+	m_tblZones.push_back(zone);
+	return static_cast<std::uint32_t>(m_tblZones.size() - 1);
+}
+
+void Effects::removeZone(std::uint32_t zone) noexcept
+{
+	assert(zone < m_tblZones.size());
+	m_tblZones[zone].isUsed = false;
+	// L'identifiant peut être réutilisé par #addZone avant le prochain #update
+	for(std::int32_t& slotZone : m_tblSlotZone)
+		if(slotZone == static_cast<std::int32_t>(zone))
+			slotZone = -1;
+}
+
+void Effects::update(float xpos, float ypos, float zpos)
+{
+	KA3D_PROFILE_SCOPE("Effects::update");
+	ContextLock contextLock;
+	if(m_tblSlots.empty())
+		return;
+
+	// Poids de chaque zone : 1 dans le rayon, décroissance sur le fondu
+	m_tblWeights.assign(m_tblZones.size(), 0.f);
+	for(std::uint32_t i=0; i<m_tblZones.size(); ++i)
+	{
+		const Zone& zone(m_tblZones[i]);
+		if(!zone.isUsed)
+			continue;
+		float dx(xpos - zone.tblPosition[0]);
+		float dy(ypos - zone.tblPosition[1]);
+		float dz(zpos - zone.tblPosition[2]);
+		float dist(std::sqrt(dx*dx + dy*dy + dz*dz));
+		if(dist <= zone.fRadius)
+			m_tblWeights[i] = 1.f;
+		else if(zone.fFade > 0.f)
+			m_tblWeights[i] = std::max(0.f, 1.f - (dist - zone.fRadius) /
+			                                      zone.fFade);
+	}
+
+	// Sélection des zones les plus fortes (une par emplacement)
+	m_tblSelected.clear();
+	float fTotal(0.f);
+	for(std::uint16_t n=0; n<m_uZoneSlots; ++n)
+	{
+		std::int32_t best(-1);
+		for(std::uint32_t i=0; i<m_tblWeights.size(); ++i)
+		{
+			if(m_tblWeights[i] > 0.f &&
+			   std::find(m_tblSelected.begin(), m_tblSelected.end(),
+			             static_cast<std::int32_t>(i)) == m_tblSelected.end() &&
+			   (best < 0 || m_tblWeights[i] > m_tblWeights[best]))
+			{
+				best = static_cast<std::int32_t>(i);
+			}
+		}
+		if(best < 0)
+			break;
+		m_tblSelected.push_back(best);
+		fTotal += m_tblWeights[best];
+	}
+
+	// Les emplacements gardent leur zone si elle reste sélectionnée
+	for(std::uint16_t slot=0; slot<m_uZoneSlots; ++slot)
+	{
+		std::vector<std::int32_t>::iterator it(std::find(m_tblSelected.begin(),
+			m_tblSelected.end(), m_tblSlotZone[slot]));
+		if(it != m_tblSelected.end())
+			m_tblSelected.erase(it);
+		else
+			m_tblSlotZone[slot] = -1;
+	}
+	for(std::uint16_t slot=0; slot<m_uZoneSlots && !m_tblSelected.empty();
+	    ++slot)
+	{
+		if(m_tblSlotZone[slot] < 0)
+		{
+			m_tblSlotZone[slot] = m_tblSelected.back();
+			m_tblSelected.pop_back();
+			loadReverb(slot, m_tblZones[m_tblSlotZone[slot]].preset);
+		}
+	}
+
+	// Mélange : zones chevauchantes normalisées, fondu vers le silence sinon
+	float fNorm(fTotal > 1.f ? 1.f / fTotal : 1.f);
+	for(std::uint16_t slot=0; slot<m_uZoneSlots; ++slot)
+	{
+		std::int32_t zone(m_tblSlotZone[slot]);
+		applyGain(slot, zone < 0 ? 0.f : m_tblWeights[zone] * fNorm);
+	}
+}
+
+} // namespace KA3D
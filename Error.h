@@ -32,6 +32,8 @@
 #include <AL/al.h>
 #include <AL/alc.h>
 
+#include "ProfilerPrivate.h"
+
 #define ALIBTESTERR(ERRAL) case ERRAL: return #ERRAL
 
 static inline std::string alErrorString(ALenum error)
@@ -50,6 +52,7 @@ static inline std::string alErrorString(ALenum error)
 
 static inline void checkALError()
 {
+	KA3D_PROFILE_COUNT(PC_AL_ERROR_CHECK);
 	ALenum error(alGetError());
 	if(error != AL_NO_ERROR)
 		throw std::runtime_error(alErrorString(error));
@@ -71,6 +74,7 @@ static inline std::string alcErrorString(ALCenum error)
 
 static inline void checkALCError(ALCdevice* device)
 {
+	KA3D_PROFILE_COUNT(PC_AL_ERROR_CHECK);
 	ALCenum error(alcGetError(device));
 	if(error != ALC_NO_ERROR)
 		throw std::runtime_error(alcErrorString(error));
@@ -0,0 +1,107 @@
+/**
+ *
+ * @file Extensions.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Contient les extensions OpenAL (Soft) utilisées par KAudio3D (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Extensions.h"
+
+#include <AL/al.h>
+#include <AL/alc.h>
+
+namespace KA3D
+{
+
+template<typename T>
+static inline T alProc(const char* extension, const char* name) noexcept
+{
+	if(alIsExtensionPresent(extension) != AL_TRUE)
+		return nullptr;
+	return reinterpret_cast<T>(alGetProcAddress(name));
+}
+
+template<typename T>
+static inline T alcProc(ALCdevice* device,
+                        const char* extension, const char* name) noexcept
+{
+	if(alcIsExtensionPresent(device, extension) != ALC_TRUE)
+		return nullptr;
+	return reinterpret_cast<T>(alcGetProcAddress(device, name));
+}
+
+template<typename T>
+static inline T efxProc(bool isPresent, const char* name) noexcept
+{
+	if(!isPresent)
+		return nullptr;
+	return reinterpret_cast<T>(alGetProcAddress(name));
+}
+
+void Extensions::load(ALCdevice* device) noexcept
+{
+	alGetSourcedvSOFT = alProc<LPALGETSOURCEDVSOFT>(
+		"AL_SOFT_source_latency", "alGetSourcedvSOFT");
+	alGetSourcei64vSOFT = alProc<LPALGETSOURCEI64VSOFT>(
+		"AL_SOFT_source_latency", "alGetSourcei64vSOFT");
+
+	alcGetInteger64vSOFT = alcProc<LPALCGETINTEGER64VSOFT>(device,
+		"ALC_SOFT_device_clock", "alcGetInteger64vSOFT");
+
+	alSourcePlayAtTimevSOFT = alProc<LPALSOURCEPLAYATTIMEVSOFT>(
+		"AL_SOFT_source_start_delay", "alSourcePlayAtTimevSOFT");
+
+	alDeferUpdatesSOFT = alProc<LPALDEFERUPDATESSOFT>(
+		"AL_SOFT_deferred_updates", "alDeferUpdatesSOFT");
+	alProcessUpdatesSOFT = alProc<LPALPROCESSUPDATESSOFT>(
+		"AL_SOFT_deferred_updates", "alProcessUpdatesSOFT");
+
+	hasFloat32 = (alIsExtensionPresent("AL_EXT_FLOAT32") == AL_TRUE);
+	hasMCFormats = (alIsExtensionPresent("AL_EXT_MCFORMATS") == AL_TRUE);
+	hasLoopPoints = (alIsExtensionPresent("AL_SOFT_loop_points") == AL_TRUE);
+
+	bool hasEFX(alcIsExtensionPresent(device, ALC_EXT_EFX_NAME) == ALC_TRUE);
+	alGenEffects = efxProc<LPALGENEFFECTS>(hasEFX, "alGenEffects");
+	alDeleteEffects = efxProc<LPALDELETEEFFECTS>(hasEFX, "alDeleteEffects");
+	alEffecti = efxProc<LPALEFFECTI>(hasEFX, "alEffecti");
+	alEffectf = efxProc<LPALEFFECTF>(hasEFX, "alEffectf");
+	alEffectfv = efxProc<LPALEFFECTFV>(hasEFX, "alEffectfv");
+	alGenAuxiliaryEffectSlots = efxProc<LPALGENAUXILIARYEFFECTSLOTS>(hasEFX,
+		"alGenAuxiliaryEffectSlots");
+	alDeleteAuxiliaryEffectSlots = efxProc<LPALDELETEAUXILIARYEFFECTSLOTS>(
+		hasEFX, "alDeleteAuxiliaryEffectSlots");
+	alAuxiliaryEffectSloti = efxProc<LPALAUXILIARYEFFECTSLOTI>(hasEFX,
+		"alAuxiliaryEffectSloti");
+	alAuxiliaryEffectSlotf = efxProc<LPALAUXILIARYEFFECTSLOTF>(hasEFX,
+		"alAuxiliaryEffectSlotf");
+	alGenFilters = efxProc<LPALGENFILTERS>(hasEFX, "alGenFilters");
+	alDeleteFilters = efxProc<LPALDELETEFILTERS>(hasEFX, "alDeleteFilters");
+	alFilteri = efxProc<LPALFILTERI>(hasEFX, "alFilteri");
+	alFilterf = efxProc<LPALFILTERF>(hasEFX, "alFilterf");
+
+	iMaxAuxiliarySends = 0;
+	if(hasEFX)
+		alcGetIntegerv(device, ALC_MAX_AUXILIARY_SENDS, 1, &iMaxAuxiliarySends);
+}
+
+} // namespace KA3D
@@ -0,0 +1,162 @@
+#ifndef EXTENSIONS_H_INCLUDED
+#define EXTENSIONS_H_INCLUDED
+/**
+ *
+ * @file Extensions.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Contient les extensions OpenAL (Soft) utilisées par KAudio3D (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <AL/al.h>
+#include <AL/alc.h>
+
+// efx.h et EFX-Util.h du SDK Creative utilisent __cdecl (propre à Windows)
+#if !defined(_WIN32) && !defined(__cdecl)
+#  define __cdecl
+#endif
+#include <AL/efx.h>
+#include <AL/efx-creative.h>
+
+// Définitions reprises de AL/alext.h (OpenAL Soft), absent de deps/include
+
+#ifndef AL_SOFT_source_latency
+#define AL_SOFT_source_latency 1
+#define AL_SAMPLE_OFFSET_LATENCY_SOFT            0x1200
+#define AL_SEC_OFFSET_LATENCY_SOFT               0x1201
+typedef std::int64_t ALint64SOFT;
+typedef std::uint64_t ALuint64SOFT;
+typedef void (AL_APIENTRY*LPALGETSOURCEDVSOFT)(ALuint, ALenum, ALdouble*);
+typedef void (AL_APIENTRY*LPALGETSOURCEI64VSOFT)(ALuint, ALenum, ALint64SOFT*);
+#endif
+
+#ifndef ALC_SOFT_device_clock
+#define ALC_SOFT_device_clock 1
+typedef std::int64_t ALCint64SOFT;
+typedef std::uint64_t ALCuint64SOFT;
+#define ALC_DEVICE_CLOCK_SOFT                    0x1600
+#define ALC_DEVICE_LATENCY_SOFT                  0x1601
+#define ALC_DEVICE_CLOCK_LATENCY_SOFT            0x1602
+#define AL_SAMPLE_OFFSET_CLOCK_SOFT              0x1202
+#define AL_SEC_OFFSET_CLOCK_SOFT                 0x1203
+typedef void (ALC_APIENTRY*LPALCGETINTEGER64VSOFT)(ALCdevice*, ALCenum,
+                                                   ALsizei, ALCint64SOFT*);
+#endif
+
+#ifndef AL_SOFT_source_start_delay
+#define AL_SOFT_source_start_delay 1
+typedef void (AL_APIENTRY*LPALSOURCEPLAYATTIMESOFT)(ALuint, ALint64SOFT);
+typedef void (AL_APIENTRY*LPALSOURCEPLAYATTIMEVSOFT)(ALsizei, const ALuint*,
+                                                     ALint64SOFT);
+#endif
+
+#ifndef AL_SOFT_deferred_updates
+#define AL_SOFT_deferred_updates 1
+#define AL_DEFERRED_UPDATES_SOFT                 0xC002
+typedef void (AL_APIENTRY*LPALDEFERUPDATESSOFT)(void);
+typedef void (AL_APIENTRY*LPALPROCESSUPDATESSOFT)(void);
+#endif
+
+#ifndef AL_EXT_float32
+#define AL_EXT_float32 1
+#define AL_FORMAT_MONO_FLOAT32                   0x10010
+#define AL_FORMAT_STEREO_FLOAT32                 0x10011
+#endif
+
+#ifndef AL_EXT_MCFORMATS
+#define AL_EXT_MCFORMATS 1
+#define AL_FORMAT_QUAD8                          0x1204
+#define AL_FORMAT_QUAD16                         0x1205
+#define AL_FORMAT_QUAD32                         0x1206
+#define AL_FORMAT_51CHN8                         0x120A
+#define AL_FORMAT_51CHN16                        0x120B
+#define AL_FORMAT_51CHN32                        0x120C
+#define AL_FORMAT_61CHN8                         0x120D
+#define AL_FORMAT_61CHN16                        0x120E
+#define AL_FORMAT_61CHN32                        0x120F
+#define AL_FORMAT_71CHN8                         0x1210
+#define AL_FORMAT_71CHN16                        0x1211
+#define AL_FORMAT_71CHN32                        0x1212
+#endif
+
+#ifndef AL_SOFT_loop_points
+#define AL_SOFT_loop_points 1
+#define AL_LOOP_POINTS_SOFT                      0x2015
+#endif
+
+namespace KA3D
+{
+
+/**
+ * @brief Extensions disponibles sur le périphérique/contexte actif
+ * Chargées par Context::makeCurrent, les pointeurs sont nuls si
+ * l'extension correspondante n'est pas présente
+ */
+struct Extensions
+{
+	//! AL_SOFT_source_latency
+	LPALGETSOURCEDVSOFT alGetSourcedvSOFT;
+	LPALGETSOURCEI64VSOFT alGetSourcei64vSOFT;
+	//! ALC_SOFT_device_clock
+	LPALCGETINTEGER64VSOFT alcGetInteger64vSOFT;
+	//! AL_SOFT_source_start_delay
+	LPALSOURCEPLAYATTIMEVSOFT alSourcePlayAtTimevSOFT;
+	//! AL_SOFT_deferred_updates
+	LPALDEFERUPDATESSOFT alDeferUpdatesSOFT;
+	LPALPROCESSUPDATESSOFT alProcessUpdatesSOFT;
+	//! AL_EXT_FLOAT32 : buffers en flottants 32 bits
+	bool hasFloat32;
+	//! AL_EXT_MCFORMATS : buffers multicanaux (quad, 5.1, 6.1, 7.1)
+	bool hasMCFormats;
+	//! AL_SOFT_loop_points : boucle sur une partie d'un buffer
+	bool hasLoopPoints;
+	//! ALC_EXT_EFX : effets
+	LPALGENEFFECTS alGenEffects;
+	LPALDELETEEFFECTS alDeleteEffects;
+	LPALEFFECTI alEffecti;
+	LPALEFFECTF alEffectf;
+	LPALEFFECTFV alEffectfv;
+	//! ALC_EXT_EFX : emplacements d'effets auxiliaires
+	LPALGENAUXILIARYEFFECTSLOTS alGenAuxiliaryEffectSlots;
+	LPALDELETEAUXILIARYEFFECTSLOTS alDeleteAuxiliaryEffectSlots;
+	LPALAUXILIARYEFFECTSLOTI alAuxiliaryEffectSloti;
+	LPALAUXILIARYEFFECTSLOTF alAuxiliaryEffectSlotf;
+	//! ALC_EXT_EFX : filtres
+	LPALGENFILTERS alGenFilters;
+	LPALDELETEFILTERS alDeleteFilters;
+	LPALFILTERI alFilteri;
+	LPALFILTERF alFilterf;
+	//! ALC_EXT_EFX : nombre d'envois auxiliaires par source (0 sans EFX)
+	ALCint iMaxAuxiliarySends;
+
+	/**
+	 * @brief Charge les extensions (contexte actif requis)
+	 * @param device Périphérique du contexte actif
+	 */
+	void load(ALCdevice* device) noexcept;
+};
+
+} // namespace KA3D
+
+#endif // EXTENSIONS_H_INCLUDED
@@ -0,0 +1,109 @@
+/**
+ *
+ * @file FFT.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la transformée de Fourier rapide (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "FFT.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "MixKernels.h"
+
+namespace KA3D
+{
+
+FFT::FFT(std::uint32_t size):
+	m_uSize(size),
+	m_tblBitReverse(size),
+	m_tblTwiddleRe(size > 1 ? size-1 : 0),
+	m_tblTwiddleIm(size > 1 ? size-1 : 0)
+{
+	if(size < 2 || (size & (size-1)) != 0)
+		throw std::runtime_error("FFT size must be a power of two");
+
+	std::uint32_t bits(0);
+	while((1u << bits) < size)
+		++bits;
+	for(std::uint32_t i=0; i<size; ++i)
+	{
+		std::uint32_t r(0);
+		for(std::uint32_t b=0; b<bits; ++b)
+			r |= ((i >> b) & 1u) << (bits-1-b);
+		m_tblBitReverse[i] = r;
+	}
+
+	// Étage de demi-taille h : rotations exp(-i·pi·j/h) à l'indice h-1+j
+	const double PI(3.14159265358979323846);
+	for(std::uint32_t half=1; half<size; half*=2)
+	{
+		for(std::uint32_t j=0; j<half; ++j)
+		{
+			double angle(-PI * j / half);
+			m_tblTwiddleRe[half-1+j] = static_cast<float>(std::cos(angle));
+			m_tblTwiddleIm[half-1+j] = static_cast<float>(std::sin(angle));
+		}
+	}
+}
+
+std::uint32_t FFT::size() const noexcept
+{
+	return m_uSize;
+}
+
+void FFT::forward(float* re, float* im) const noexcept
+{
+	for(std::uint32_t i=0; i<m_uSize; ++i)
+	{
+		std::uint32_t r(m_tblBitReverse[i]);
+		if(r > i)
+		{
+			std::swap(re[i], re[r]);
+			std::swap(im[i], im[r]);
+		}
+	}
+	for(std::uint32_t half=1; half<m_uSize; half*=2)
+	{
+		mixButterflies(re, im, m_uSize, half, &m_tblTwiddleRe[half-1],
+		               &m_tblTwiddleIm[half-1]);
+	}
+}
+
+void FFT::inverse(float* re, float* im) const noexcept
+{
+	// ifft(x) = conj(fft(conj(x))) / N
+	for(std::uint32_t i=0; i<m_uSize; ++i)
+		im[i] = -im[i];
+	forward(re, im);
+	float scale(1.f / static_cast<float>(m_uSize));
+	mixScale(re, m_uSize, scale);
+	mixScale(im, m_uSize, -scale);
+}
+
+} // namespace KA3D
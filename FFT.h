@@ -0,0 +1,77 @@
+#ifndef FFT_H_INCLUDED
+#define FFT_H_INCLUDED
+/**
+ *
+ * @file FFT.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la transformée de Fourier rapide (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <vector>
+
+namespace KA3D
+{
+
+/**
+ * @brief Transformée de Fourier rapide complexe (radix-2, complexes séparés)
+ * Les parties réelles et imaginaires sont rangées dans deux tableaux
+ * distincts pour que les papillons soient vectorisés (cf. MixKernels.h)
+ */
+class FFT
+{
+public:
+	/**
+	 * @brief Constructeur (précalcule les facteurs de rotation)
+	 * @param size Taille de la transformée (puissance de 2)
+	 */
+	explicit FFT(std::uint32_t size);
+
+	/**
+	 * @brief Taille de la transformée
+	 */
+	std::uint32_t size() const noexcept;
+	/**
+	 * @brief Transformée directe (en place)
+	 * @param re Parties réelles (size points)
+	 * @param im Parties imaginaires (size points)
+	 */
+	void forward(float* re, float* im) const noexcept;
+	/**
+	 * @brief Transformée inverse normalisée (en place, divisée par size)
+	 * @param re Parties réelles (size points)
+	 * @param im Parties imaginaires (size points)
+	 */
+	void inverse(float* re, float* im) const noexcept;
+
+private:
+	std::uint32_t m_uSize; //!< Taille de la transformée
+	std::vector<std::uint32_t> m_tblBitReverse; //!< Permutation des entrées
+	std::vector<float> m_tblTwiddleRe; //!< Rotations, étage après étage
+	std::vector<float> m_tblTwiddleIm; //!< Rotations, étage après étage
+};
+
+} // namespace KA3D
+
+#endif // FFT_H_INCLUDED
@@ -0,0 +1,114 @@
+/**
+ *
+ * @file HandlePool.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les réserves d'objets OpenAL pré-alloués (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HandlePool.h"
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <AL/al.h>
+
+#include "Error.h"
+
+namespace KA3D
+{
+
+HandlePool::HandlePool(GenFunc gen, DeleteFunc del) noexcept:
+	m_gen(gen),
+	m_delete(del),
+	m_tblFree(),
+	m_mutex()
+{ }
+
+HandlePool::~HandlePool() noexcept
+{ }
+
+std::size_t HandlePool::reserve(std::size_t count)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(m_tblFree.size() >= count)
+		return m_tblFree.size();
+
+	std::size_t missing(count - m_tblFree.size());
+	std::size_t offset(m_tblFree.size());
+	while(missing > 0)
+	{
+		m_tblFree.resize(offset + missing);
+		alGetError(); // Erreur antérieure : ne doit pas être prise pour un échec
+		m_gen(static_cast<ALsizei>(missing), m_tblFree.data() + offset);
+		if(alGetError() == AL_NO_ERROR)
+			break;
+		missing /= 2;
+	}
+	m_tblFree.resize(offset + missing);
+	return m_tblFree.size();
+}
+
+ALuint HandlePool::pop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(!m_tblFree.empty())
+		{
+			ALuint handle(m_tblFree.back());
+			m_tblFree.pop_back();
+			return handle;
+		}
+	}
+
+	ALuint handle(0);
+	alGetError();
+	m_gen(1, &handle);
+	checkALError();
+	return handle;
+}
+
+void HandlePool::push(ALuint handle)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_tblFree.push_back(handle);
+}
+
+void HandlePool::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(!m_tblFree.empty())
+	{
+		m_delete(static_cast<ALsizei>(m_tblFree.size()), m_tblFree.data());
+		m_tblFree.clear();
+		checkALError();
+	}
+}
+
+std::size_t HandlePool::available() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_tblFree.size();
+}
+
+} // namespace KA3D
@@ -0,0 +1,95 @@
+#ifndef HANDLEPOOL_H_INCLUDED
+#define HANDLEPOOL_H_INCLUDED
+/**
+ *
+ * @file HandlePool.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les réserves d'objets OpenAL pré-alloués (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <AL/al.h>
+
+namespace KA3D
+{
+
+/**
+ * @brief Réserve de noms OpenAL (sources ou buffers)
+ * Les noms sont générés par lot (un seul alGenSources(n)/alGenBuffers(n))
+ * puis distribués depuis une liste libre : la création en cours de jeu
+ * n'appelle plus le pilote tant que la réserve n'est pas vide.
+ */
+class HandlePool
+{
+public:
+	typedef void (AL_APIENTRY *GenFunc)(ALsizei n, ALuint* handles);
+	typedef void (AL_APIENTRY *DeleteFunc)(ALsizei n, const ALuint* handles);
+
+public:
+	/**
+	 * @brief Constructeur
+	 * @param gen Fonction de génération (alGenSources, alGenBuffers)
+	 * @param del Fonction de suppression (alDeleteSources, alDeleteBuffers)
+	 */
+	HandlePool(GenFunc gen, DeleteFunc del) noexcept;
+	HandlePool(const HandlePool& ) noexcept = delete;
+	HandlePool& operator=(const HandlePool& ) noexcept = delete;
+	~HandlePool() noexcept;
+
+	/**
+	 * @brief Complète la réserve jusqu'à \a count noms libres (en un appel)
+	 * Si le pilote refuse le lot (limite de sources atteinte),
+	 * la taille du lot est divisée par deux jusqu'à être acceptée
+	 * @return Nombre de noms libres après l'opération
+	 */
+	std::size_t reserve(std::size_t count);
+	/**
+	 * @brief Retire un nom de la réserve (génère un nom si elle est vide)
+	 */
+	ALuint pop();
+	/**
+	 * @brief Rend un nom à la réserve (il doit avoir été réinitialisé)
+	 */
+	void push(ALuint handle);
+	/**
+	 * @brief Supprime tous les noms libres (en un appel)
+	 */
+	void clear();
+	/**
+	 * @brief Nombre de noms libres
+	 */
+	std::size_t available() const;
+
+private:
+	GenFunc m_gen; //!< Fonction de génération
+	DeleteFunc m_delete; //!< Fonction de suppression
+	std::vector<ALuint> m_tblFree; //!< Liste libre
+	mutable std::mutex m_mutex; //!< Protection de la liste libre
+};
+
+} // namespace KA3D
+
+#endif // HANDLEPOOL_H_INCLUDED
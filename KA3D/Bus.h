@@ -0,0 +1,192 @@
+#ifndef BUS_H_INCLUDED
+#define BUS_H_INCLUDED
+/**
+ *
+ * @file Bus.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les bus de mixage hiérarchiques (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace KA3D
+{
+
+class Sound;
+
+/**
+ * @brief Bus de mixage (catégorie de sons : musique, bruitages, voix...)
+ * Les bus forment un arbre dont la racine (« master ») est créée par
+ * l'utilisateur et les enfants par #addChild. Chaque son est assigné à un
+ * bus (Sound::setBus) ; le volume envoyé au pilote pour ses sources est
+ * le volume propre de la source multiplié par le volume effectif du bus
+ * (produit des volumes de ses ancêtres).
+ *
+ * #setGain et #setMuted ne font que marquer le bus comme modifié : #flush
+ * (sur la racine, par exemple une fois par image) recalcule les volumes
+ * effectifs des seules branches modifiées et n'appelle le pilote que pour
+ * les sources dont le volume a réellement changé, en un seul lot.
+ * Les modifications et #flush peuvent venir de fils différents (ex : le
+ * fil de l'Updater) : l'arbre est protégé par un verrou de la racine et
+ * le volume de chaque source par son propre verrou (Source::setGain).
+ */
+class Bus
+{
+public:
+	/**
+	 * @brief Constructeur (bus racine)
+	 * @param szName Nom du bus
+	 */
+	explicit Bus(const std::string& szName = "master");
+	//! Copie interdite
+	Bus(const Bus& other) = delete;
+	//! Copie interdite
+	Bus& operator=(const Bus& other) = delete;
+	/**
+	 * @brief Destructeur (détruit les bus enfants)
+	 * Les sons doivent avoir été retirés (Sound::setBus(nullptr))
+	 */
+	~Bus() noexcept;
+
+	/**
+	 * @brief Crée un bus enfant (détenu par ce bus)
+	 * @param szName Nom du bus
+	 * @return Bus créé
+	 */
+	Bus& addChild(const std::string& szName);
+	/**
+	 * @brief Cherche un bus par son nom dans ce sous-arbre
+	 * @param szName Nom du bus
+	 * @return Bus trouvé, nullptr sinon
+	 */
+	Bus* find(const std::string& szName) noexcept;
+	/**
+	 * @brief Ajoute ce bus et ses descendants à une liste (préfixe)
+	 * @param[out] tblBuses Liste complétée
+	 */
+	void collect(std::vector<Bus*>& tblBuses);
+	/**
+	 * @brief Nom du bus
+	 */
+	const std::string& name() const noexcept;
+	/**
+	 * @brief Bus parent (nullptr pour la racine)
+	 */
+	Bus* parent() const noexcept;
+
+	/**
+	 * @brief Permet de définir le volume propre du bus (appliqué par #flush)
+	 * @param fGain Volume (0 à 1, > 1 amplification)
+	 */
+	void setGain(float fGain) noexcept;
+	/**
+	 * @brief Permet d'obtenir le volume propre du bus
+	 */
+	float gain() const noexcept;
+	/**
+	 * @brief Coupe ou rétablit le son du bus (appliqué par #flush)
+	 * Le volume propre est conservé
+	 * @param isMuted Vrai pour couper le son
+	 */
+	void setMuted(bool isMuted) noexcept;
+	/**
+	 * @brief Permet de savoir si le son du bus est coupé
+	 */
+	bool isMuted() const noexcept;
+	/**
+	 * @brief Permet de définir l'atténuation du bus (cf. Ducker)
+	 * Multipliée au volume propre, appliquée par #flush
+	 * @param fGain Volume d'atténuation (1 : aucune)
+	 */
+	void setDuckGain(float fGain) noexcept;
+	/**
+	 * @brief Permet d'obtenir l'atténuation du bus
+	 */
+	float duckGain() const noexcept;
+	/**
+	 * @brief Volume effectif du bus (produit des ancêtres, lors du
+	 * dernier #flush)
+	 */
+	float effectiveGain() const noexcept;
+	/**
+	 * @brief Permet de savoir si un son du bus (ou d'un bus enfant) est
+	 * en cours de lecture
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * @brief Ajoute un son au bus (utilisé par Sound::setBus)
+	 * @param sound Son ajouté
+	 */
+	void add(Sound& sound);
+	/**
+	 * @brief Retire un son du bus (utilisé par Sound::setBus)
+	 * @param sound Son retiré
+	 */
+	void remove(Sound& sound) noexcept;
+
+	/**
+	 * @brief Applique les volumes modifiés de ce sous-arbre
+	 * À appeler sur la racine ; les modifications sont envoyées en un
+	 * seul lot (AL_SOFT_deferred_updates si disponible)
+	 */
+	void flush();
+
+private:
+	/**
+	 * @brief Constructeur (bus enfant)
+	 * @param szName Nom du bus
+	 * @param pParent Bus parent
+	 */
+	Bus(const std::string& szName, Bus* pParent);
+
+	//! Verrou de l'arbre (celui de la racine)
+	std::mutex& treeMutex() const noexcept;
+	//! Marque les ancêtres comme ayant un descendant modifié
+	void markDirty() noexcept;
+	//! Cherche un son en lecture dans ce sous-arbre (verrou détenu)
+	bool hasPlayingSound() const;
+	//! Recalcule et applique les volumes d'un sous-arbre modifié
+	void propagate(float fParentGain, bool isParentChanged);
+
+private:
+	std::string m_szName; //!< Nom du bus
+	Bus* m_pParent; //!< Bus parent (nullptr : racine)
+	std::vector<std::unique_ptr<Bus>> m_tblChildren; //!< Bus enfants
+	std::vector<Sound*> m_tblSounds; //!< Sons assignés au bus
+	mutable std::mutex m_mutex; //!< Verrou de l'arbre (racine seulement)
+	float m_fGain; //!< Volume propre
+	float m_fDuckGain; //!< Atténuation (cf. Ducker)
+	float m_fEffectiveGain; //!< Volume effectif appliqué
+	bool m_isMuted; //!< Son coupé
+	bool m_isDirty; //!< Volume propre modifié depuis le dernier flush
+	bool m_hasDirtyChild; //!< Un descendant est modifié
+};
+
+} // namespace KA3D
+
+#endif // BUS_H_INCLUDED
@@ -0,0 +1,152 @@
+#ifndef CONVOLVER_H_INCLUDED
+#define CONVOLVER_H_INCLUDED
+/**
+ *
+ * @file Convolver.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la convolution par FFT partitionnée (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <iostream>
+#include <vector>
+
+#include "MixerBuffer.h"
+#include "MixerEffect.h"
+
+namespace KA3D
+{
+
+class FFT;
+
+/**
+ * @brief Convolution par FFT uniformément partitionnée (overlap-save)
+ * Réverbération à convolution ou filtrage par HRTF : la réponse
+ * impulsionnelle est découpée en partitions de la taille d'un bloc,
+ * transformées une fois pour toutes ; chaque bloc d'entrée est transformé
+ * une fois puis multiplié avec toutes les partitions via une ligne à
+ * retard fréquentielle. Le coût par échantillon est indépendant de la
+ * position dans la réponse, ce qui permet des réponses de plusieurs
+ * secondes en temps réel.
+ * La latence est d'un bloc (le signal sec est retardé d'autant).
+ * Le canal c du signal est convolué avec le canal min(c, n-1) de la réponse.
+ */
+class Convolver : public MixerEffect
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param blockSize Taille des partitions et latence (puissance de 2)
+	 */
+	explicit Convolver(std::uint32_t blockSize = 256);
+	//! Copie interdite
+	Convolver(const Convolver& other) = delete;
+	//! Copie interdite
+	Convolver& operator=(const Convolver& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	virtual ~Convolver() noexcept;
+
+	/**
+	 * @brief Permet de définir la réponse impulsionnelle
+	 * Aucun rééchantillonnage n'est effectué : la réponse doit être à la
+	 * fréquence du signal traité
+	 * @param impulse Réponse impulsionnelle (un ou plusieurs canaux)
+	 */
+	void setImpulse(const MixerBuffer& impulse);
+	/**
+	 * @brief Permet de charger la réponse impulsionnelle d'un fichier wav
+	 * @param file Flux contenant le fichier audio
+	 */
+	void loadWav(std::iostream& file);
+	/**
+	 * @brief Remet à zéro l'historique du signal (lignes à retard)
+	 */
+	void reset() noexcept;
+
+	/**
+	 * @brief Permet de définir le volume du signal sec (non traité)
+	 */
+	void setDry(float fDry) noexcept;
+	/**
+	 * @brief Permet de définir le volume du signal convolué
+	 */
+	void setWet(float fWet) noexcept;
+	/**
+	 * @brief Nombre de partitions de la réponse impulsionnelle
+	 */
+	std::uint32_t partitions() const noexcept;
+	/**
+	 * @brief Latence en échantillons (taille d'un bloc)
+	 */
+	std::uint32_t latency() const noexcept;
+
+	/**
+	 * @brief Traite un bloc de signal (en place, taille quelconque)
+	 * @param tblChannels Échantillons de chaque canal
+	 * @param channels Nombre de canaux
+	 * @param frames Nombre d'échantillons par canal
+	 */
+	virtual void process(float* const* tblChannels, std::uint16_t channels,
+	                     std::uint32_t frames) override;
+
+private:
+	//! Redimensionne l'historique pour un nombre de canaux
+	void setChannels(std::uint16_t channels);
+	//! Convolue le bloc d'entrée complet de chaque canal
+	void processBlock();
+
+private:
+	FFT* m_pFFT; //!< Transformée de taille 2 × bloc
+	std::uint32_t m_uBlockSize; //!< Taille des partitions
+	std::uint32_t m_uBins; //!< Nombre de points utiles du spectre (bloc + 1)
+	std::uint32_t m_uPartitions; //!< Nombre de partitions
+	std::uint16_t m_uIrChannels; //!< Nombre de canaux de la réponse
+	std::uint16_t m_uChannels; //!< Nombre de canaux du signal
+	std::uint32_t m_uFill; //!< Échantillons accumulés dans le bloc courant
+	std::uint32_t m_uHead; //!< Partition la plus récente des lignes à retard
+	float m_fDry; //!< Volume du signal sec
+	float m_fWet; //!< Volume du signal convolué
+
+	//! Spectres de la réponse [canal][partition][point]
+	std::vector<float> m_tblIrRe;
+	std::vector<float> m_tblIrIm;
+	//! Lignes à retard fréquentielles [canal][partition][point]
+	std::vector<float> m_tblDelayRe;
+	std::vector<float> m_tblDelayIm;
+	//! Entrées [canal][bloc précédent | bloc courant]
+	std::vector<float> m_tblInput;
+	//! Sorties convoluées du bloc précédent [canal][échantillon]
+	std::vector<float> m_tblOutput;
+	//! Mémoire de travail (FFT et accumulateur)
+	std::vector<float> m_tblWorkRe;
+	std::vector<float> m_tblWorkIm;
+	std::vector<float> m_tblAccRe;
+	std::vector<float> m_tblAccIm;
+};
+
+} // namespace KA3D
+
+#endif // CONVOLVER_H_INCLUDED
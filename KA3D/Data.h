@@ -27,8 +27,11 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <cstdint>
 
+#include <atomic>
+#include <string>
 #include <vector>
 #include <iostream>
 
@@ -41,7 +44,8 @@
 namespace KA3D
 {
 
-class DataPrivate;
+class Reader;
+class WaveFile;
 
 //! Liste des formats audio brute
 enum DataFormat {
@@ -49,12 +53,38 @@ enum DataFormat {
 	DF_MONO16, //!< Mono 16 bit par échantillon
 	DF_STEREO8, //!< Stéreo 8 bit par échantillon
 	DF_STEREO16, //!< Stéreo 16 bit par échantillon
+	DF_MONO_FLOAT32, //!< Mono flottant 32 bit par échantillon
+	DF_STEREO_FLOAT32, //!< Stéreo flottant 32 bit par échantillon
+	DF_QUAD8, //!< Quadriphonie 8 bit par échantillon
+	DF_QUAD16, //!< Quadriphonie 16 bit par échantillon
+	DF_QUAD_FLOAT32, //!< Quadriphonie flottant 32 bit par échantillon
+	DF_51CHN8, //!< 5.1 8 bit par échantillon
+	DF_51CHN16, //!< 5.1 16 bit par échantillon
+	DF_51CHN_FLOAT32, //!< 5.1 flottant 32 bit par échantillon
+	DF_61CHN8, //!< 6.1 8 bit par échantillon
+	DF_61CHN16, //!< 6.1 16 bit par échantillon
+	DF_61CHN_FLOAT32, //!< 6.1 flottant 32 bit par échantillon
+	DF_71CHN8, //!< 7.1 8 bit par échantillon
+	DF_71CHN16, //!< 7.1 16 bit par échantillon
+	DF_71CHN_FLOAT32, //!< 7.1 flottant 32 bit par échantillon
 
 	DF_LAST //!< Borne de fin
 };
 
+//! Marqueur dans des données audio (cf. Data::markers)
+struct Marker
+{
+	std::uint32_t id; //!< Identifiant du point (chunk cue : dwName)
+	std::uint32_t position; //!< Position (en échantillons par canal)
+	std::string label; //!< Nom (chunk labl de la liste adtl, vide sinon)
+};
+
 /**
  * @brief Classe représentant des données audio (une instance = une piste)
+ * Les données sont partagées par compteur de références intrusif :
+ * chaque #Source initialisée et chaque #Sound en détient une.
+ * La dernière libération (#unref) détruit l'objet ; si le buffer OpenAL
+ * est encore attaché à une source, sa suppression est différée (cf. #collect)
  */
 class Data
 {
@@ -87,18 +117,53 @@ public:
 	 */
 	static std::uint16_t formatPitch(DataFormat format) noexcept
 		__attribute__((pure));
+	/**
+	 * @brief Permet d'obtenir le format OpenAL (ALenum) d'un format audio
+	 * @param format Format audio (cf. #DataFormat)
+	 * @return Format OpenAL (AL_FORMAT_...)
+	 */
+	static std::int32_t formatAL(DataFormat format) noexcept
+		__attribute__((pure));
+	/**
+	 * @brief Permet de savoir si un format est lu nativement par le
+	 * périphérique (sinon il est converti à l'envoi, cf. #bufferData)
+	 * @param format Format audio (cf. #DataFormat)
+	 * @return Vrai si le format est supporté (contexte courant requis)
+	 */
+	static bool isFormatNative(DataFormat format) noexcept;
+	/**
+	 * @brief Envoie des données audio dans un buffer OpenAL
+	 * Les flottants sont convertis en 16 bits si le périphérique n'a pas
+	 * l'extension AL_EXT_float32 ; les formats multicanaux (quad, 5.1...)
+	 * exigent l'extension AL_EXT_MCFORMATS (exception sinon)
+	 * @param uHandle Nom OpenAL du buffer
+	 * @param format Format des données (cf. #DataFormat)
+	 * @param data Données brutes
+	 * @param size Taille des données en octets
+	 * @param freq Fréquence d'échantillonage des données
+	 */
+	static void bufferData(std::uint32_t uHandle, DataFormat format,
+	                       const void* data, std::size_t size,
+	                       std::int32_t freq);
 	/**
 	 * @brief Permet d'obtenir le format audio correspondant
 	 * Permet d'obtenir le format audio correspondant à
-	 * un nombre de canaux
+	 * un nombre de canaux (1, 2, 4 : quad, 6 : 5.1, 7 : 6.1, 8 : 7.1)
 	 * et un nombre d'octets par échantillon et par canaux
 	 * @param channels Nombre de canaux
 	 * @param bytesPerSample Nombre d'octets par échantillon et par canaux
+	 * (4 : flottant 32 bit)
 	 * @return Format audio (cf. #DataFormat) correspondant aux paramètre
 	 */
 	static DataFormat
 	formatFromPerSample(std::uint16_t channels, std::uint16_t bytesPerSample)
 		noexcept __attribute__((pure));
+	/**
+	 * @brief Permet de savoir si les boucles partielles (#setLoopPoints)
+	 * sont jouées par le périphérique (extension AL_SOFT_loop_points)
+	 * @return Vrai si l'extension est présente (contexte courant requis)
+	 */
+	static bool isLoopPointsSupported() noexcept;
 
 public:
 	Data(Data& other) noexcept = delete; //!< Copie interdite
@@ -109,7 +174,8 @@ public:
 	 * @param tblData Données brutes
 	 * @param format Format des données brute (cf. #DataFormat)
 	 * @param freq Fréquence d'échantillonage des données
-	 * @return Pointeur alloué dynamiquement (avec new) vers le buffer de donnée
+	 * @return Pointeur vers les données, avec une référence détenue par
+	 * l'appelant (à libérer avec #unref)
 	 */
 	static Data* fromData(const std::vector<std::uint8_t>& tblData,
 	                      DataFormat format, std::int32_t freq);
@@ -117,27 +183,92 @@ public:
 	/**
 	 * @brief Permet de charger des données audio à partir d'un contenue wav
 	 * @param file Flux contenant le fichier audio
-	 * @return Pointeur alloué dynamiquement (avec new) vers le buffer de donnée
+	 * @return Pointeur vers les données, avec une référence détenue par
+	 * l'appelant (à libérer avec #unref)
 	 */
 	static Data* fromWav(std::iostream& file);
+	/**
+	 * @brief Permet de charger des données audio à partir d'un contenue wav
+	 * @param reader Source du fichier audio (mémoire, descripteur...)
+	 * @return Pointeur vers les données, avec une référence détenue par
+	 * l'appelant (à libérer avec #unref)
+	 */
+	static Data* fromWav(Reader& reader);
 
 	/**
-	 * @brief Destructeur
+	 * @brief Supprime les buffers dont la suppression a été différée
+	 * Un buffer encore attaché à une source en cours de lecture ne peut pas
+	 * être supprimé (AL_INVALID_OPERATION) : il est mis en attente et
+	 * cette fonction réessaye de le libérer (rendu à la réserve de buffers
+	 * du contexte, ou supprimé). Elle est appelée par
+	 * Source::Quit et Listener::Quit, et peut l'être à chaque image.
+	 * @return Nombre de buffers toujours en attente
 	 */
-	~Data() noexcept;
+	static std::size_t collect();
+
+	/**
+	 * @brief Ajoute une référence sur les données
+	 */
+	void ref() noexcept;
+	/**
+	 * @brief Retire une référence sur les données
+	 * Détruit les données quand plus aucune référence n'est détenue
+	 * (l'objet ne doit plus être utilisé après l'appel)
+	 */
+	void unref() noexcept;
+	/**
+	 * @brief Permet d'obtenir le nombre de références détenues
+	 */
+	std::uint32_t refCount() const noexcept;
+
+	/**
+	 * @brief Retourne le nom OpenAL du buffer
+	 */
+	std::uint32_t handle() const noexcept;
 
 	/**
-	 * @brief Retourne les données interne privée de la classe
-	 * @return Pointeur vers AudioDataPrivate
+	 * @brief Permet de définir une boucle sur une partie des données
+	 * Avec AL_SOFT_loop_points, une source en boucle (Source::setAutoLoop)
+	 * joue le début des données puis répète [start, end[ sans coupure ;
+	 * sans l'extension, elle boucle sur tout le buffer.
+	 * À définir avant d'attacher les données à une source
+	 * (définie par #fromWav si le fichier a un chunk smpl)
+	 * @param start Début de la boucle (en échantillons par canal)
+	 * @param end Fin de la boucle, exclue (en échantillons par canal)
 	 */
-	DataPrivate* data() noexcept;
+	void setLoopPoints(std::uint32_t start, std::uint32_t end);
+	//! Début de la boucle (en échantillons par canal)
+	std::uint32_t loopStart() const noexcept;
+	//! Fin de la boucle, exclue (0 : boucle sur tout le buffer)
+	std::uint32_t loopEnd() const noexcept;
+
+	/**
+	 * @brief Permet de définir les marqueurs des données (cf. MarkerDispatcher)
+	 * À définir avant de jouer les données (définis par #fromWav si le
+	 * fichier a un chunk cue)
+	 * @param tblMarkers Marqueurs (triés par position)
+	 */
+	void setMarkers(std::vector<Marker> tblMarkers);
+	//! Marqueurs des données, triés par position
+	const std::vector<Marker>& markers() const noexcept;
+	//! Fréquence d'échantillonage des données
+	std::int32_t frequency() const noexcept;
 
 private:
+	//! Charge les données d'un fichier wave (cf. #fromWav)
+	static Data* fromWave(WaveFile& waveFile);
 	//! Constructeur privée, utiliser fromData, fromWav, fromOgg...
-	Data(DataPrivate* pData) noexcept;
+	Data(std::uint32_t uHandle, std::int32_t freq) noexcept;
+	//! Destructeur privée, utiliser #unref
+	~Data() noexcept;
 
 private:
-	DataPrivate* m_pData;
+	std::uint32_t m_uHandle; //!< Nom OpenAL du buffer (stocké dans l'objet)
+	std::atomic<std::uint32_t> m_uRefCount; //!< Nombre de références
+	std::uint32_t m_uLoopStart; //!< Début de la boucle (échantillons)
+	std::uint32_t m_uLoopEnd; //!< Fin de la boucle (0 : tout le buffer)
+	std::vector<Marker> m_tblMarkers; //!< Marqueurs (triés par position)
+	std::int32_t m_iFrequency; //!< Fréquence d'échantillonage
 };
 
 } // namespace KA3D
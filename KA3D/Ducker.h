@@ -0,0 +1,145 @@
+#ifndef DUCKER_H_INCLUDED
+#define DUCKER_H_INCLUDED
+/**
+ *
+ * @file Ducker.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'atténuation par déclenchement (ducking) (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <mutex>
+#include <vector>
+
+#include "Updater.h"
+
+namespace KA3D
+{
+
+class Bus;
+
+/**
+ * @brief Atténuation de bus par déclenchement (« sidechain ducking »)
+ * Un suiveur d'enveloppe observe un bus déclencheur (ex : voix) et
+ * atténue des bus cibles (ex : musique) avec une attaque et un relâchement,
+ * sans travail du jeu à chaque image.
+ *
+ * Le niveau du déclencheur est, au choix :
+ * - l'état de lecture des sons du bus déclencheur (#update(float)), évalué
+ *   à chaque pas de l'Updater (cf. Updater::add) ;
+ * - le niveau RMS mesuré sur les échantillons par le mixeur logiciel
+ *   (cf. Mixer::addDucker, groupe de voix déclencheur), ou tout autre
+ *   niveau fourni par #update(float, float).
+ */
+class Ducker : public UpdateTask
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param fDepth Volume des cibles lorsque l'atténuation est complète
+	 * @param fAttack Durée de l'attaque en secondes
+	 * @param fRelease Durée du relâchement en secondes
+	 * @param fThreshold Niveau (RMS) à partir duquel le déclencheur est actif
+	 */
+	Ducker(float fDepth = 0.3f, float fAttack = 0.05f, float fRelease = 0.5f,
+	       float fThreshold = 0.01f);
+	//! Copie interdite
+	Ducker(const Ducker& other) = delete;
+	//! Copie interdite
+	Ducker& operator=(const Ducker& other) = delete;
+	/**
+	 * @brief Destructeur (rend leur volume aux bus cibles)
+	 * Retirer d'abord le ducker de l'Updater (cf. Updater::remove)
+	 */
+	virtual ~Ducker() noexcept;
+
+	/**
+	 * @brief Permet de définir le bus déclencheur (cf. #update(float))
+	 * @param pBus Bus déclencheur (sous-arbre compris), nullptr : aucun
+	 */
+	void setTrigger(Bus* pBus) noexcept;
+	/**
+	 * @brief Ajoute un bus cible
+	 * @param bus Bus atténué (cf. Bus::setDuckGain)
+	 */
+	void addTarget(Bus& bus);
+	/**
+	 * @brief Retire un bus cible et lui rend son volume
+	 * @param bus Bus atténué
+	 */
+	void removeTarget(Bus& bus) noexcept;
+
+	/**
+	 * @brief Permet de définir le volume des cibles à l'atténuation complète
+	 */
+	void setDepth(float fDepth) noexcept;
+	/**
+	 * @brief Permet de définir les durées d'attaque et de relâchement
+	 * @param fAttack Durée de l'attaque en secondes
+	 * @param fRelease Durée du relâchement en secondes
+	 */
+	void setTimes(float fAttack, float fRelease) noexcept;
+	/**
+	 * @brief Permet de définir le seuil de déclenchement (niveau RMS)
+	 */
+	void setThreshold(float fThreshold) noexcept;
+
+	/**
+	 * @brief Avance l'enveloppe selon l'état de lecture du déclencheur
+	 * Le déclencheur est actif si l'un de ses sons est en lecture
+	 * @param fDelta Temps écoulé en secondes
+	 */
+	void update(float fDelta) override;
+	/**
+	 * @brief Avance l'enveloppe selon un niveau mesuré
+	 * @param fDelta Temps écoulé en secondes
+	 * @param fLevel Niveau RMS du déclencheur
+	 */
+	void update(float fDelta, float fLevel) noexcept;
+
+	/**
+	 * @brief Enveloppe courante (0 : aucune atténuation, 1 : complète)
+	 */
+	float envelope() const noexcept;
+	/**
+	 * @brief Volume courant appliqué aux cibles
+	 */
+	float gain() const noexcept;
+
+private:
+	//! Volume correspondant à l'enveloppe (sous #m_mutex)
+	float targetGain() const noexcept;
+
+	float m_fDepth; //!< Volume à l'atténuation complète
+	float m_fAttack; //!< Durée de l'attaque (secondes)
+	float m_fRelease; //!< Durée du relâchement (secondes)
+	float m_fThreshold; //!< Seuil de déclenchement
+	float m_fEnvelope; //!< Enveloppe (0 à 1)
+	Bus* m_pTrigger; //!< Bus déclencheur
+	std::vector<Bus*> m_tblTargets; //!< Bus cibles
+	mutable std::mutex m_mutex; //!< Protection (#update depuis l'Updater)
+};
+
+} // namespace KA3D
+
+#endif // DUCKER_H_INCLUDED
@@ -0,0 +1,289 @@
+#ifndef EFFECTS_H_INCLUDED
+#define EFFECTS_H_INCLUDED
+/**
+ *
+ * @file Effects.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les effets auxiliaires (EFX) et les zones de réverbération (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <vector>
+
+#include "Source.h"
+
+namespace KA3D
+{
+
+//! Préréglages de réverbération (EFX-Util.h, REVERB_PRESET_*)
+enum ReverbPreset {
+	RP_GENERIC, //!< Générique
+	RP_PADDEDCELL, //!< Cellule capitonnée
+	RP_ROOM, //!< Pièce
+	RP_BATHROOM, //!< Salle de bain
+	RP_LIVINGROOM, //!< Salon
+	RP_STONEROOM, //!< Pièce en pierre
+	RP_AUDITORIUM, //!< Auditorium
+	RP_CONCERTHALL, //!< Salle de concert
+	RP_CAVE, //!< Grotte
+	RP_ARENA, //!< Arène
+	RP_HANGAR, //!< Hangar
+	RP_CARPETTEDHALLWAY, //!< Couloir moquetté
+	RP_HALLWAY, //!< Couloir
+	RP_STONECORRIDOR, //!< Corridor en pierre
+	RP_ALLEY, //!< Ruelle
+	RP_FOREST, //!< Forêt
+	RP_CITY, //!< Ville
+	RP_MOUNTAINS, //!< Montagnes
+	RP_QUARRY, //!< Carrière
+	RP_PLAIN, //!< Plaine
+	RP_PARKINGLOT, //!< Parking
+	RP_SEWERPIPE, //!< Égout
+	RP_UNDERWATER, //!< Sous l'eau
+	RP_DRUGGED, //!< Drogué
+	RP_DIZZY, //!< Étourdi
+	RP_PSYCHOTIC, //!< Psychotique
+
+	RP_LAST //!< Borne de fin
+};
+
+//! Paramètres d'un écho (cf. AL_ECHO_* dans efx.h)
+struct EchoProperties
+{
+	float fDelay; //!< Délai du premier écho (0 à 0.207 s)
+	float fLRDelay; //!< Délai entre échos gauche et droite (0 à 0.404 s)
+	float fDamping; //!< Atténuation des aigus (0 à 0.99)
+	float fFeedback; //!< Réinjection (0 à 1)
+	float fSpread; //!< Étalement stéreo (-1 à 1)
+};
+
+//! Préréglages d'écho
+enum EchoPreset {
+	EP_DEFAULT, //!< Valeurs par défaut d'EFX
+	EP_SLAPBACK, //!< Écho court et unique (mur proche)
+	EP_CANYON, //!< Échos longs et nombreux
+
+	EP_LAST //!< Borne de fin
+};
+
+//! Type d'effet chargé dans un emplacement
+enum EffectType {
+	ET_NONE, //!< Aucun effet
+	ET_REVERB, //!< Réverbération (cf. Effects::setReverb)
+	ET_ECHO //!< Écho (cf. Effects::setEcho)
+};
+
+//! Effet chargé dans un emplacement (cf. Effects::slotEffect)
+struct SlotEffect
+{
+	EffectType type; //!< Type d'effet
+	ReverbPreset reverb; //!< Préréglage de réverbération (ET_REVERB)
+	EchoProperties echo; //!< Paramètres de l'écho (ET_ECHO)
+};
+
+/**
+ * @brief Effets auxiliaires partagés (extension ALC_EXT_EFX)
+ * Un petit nombre fixe d'emplacements d'effets est créé à l'initialisation ;
+ * les sources y sont reliées par leurs envois auxiliaires au lieu d'avoir
+ * chacune leurs effets : le nombre d'instances d'effets (et donc le coût)
+ * reste borné quel que soit le nombre de sources.
+ * Les premiers emplacements sont pilotés par les zones de réverbération
+ * (cf. #addZone, #update) : les zones les plus proches de l'écouteur y sont
+ * chargées et mélangées par le volume de chaque emplacement.
+ * Les emplacements suivants sont libres (#setReverb, #setEcho).
+ */
+class Effects
+{
+public:
+	/**
+	 * @brief Permet de savoir si l'extension ALC_EXT_EFX est disponible
+	 * sur le contexte actif
+	 */
+	static bool isSupported() noexcept;
+	/**
+	 * @brief Permet d'obtenir les paramètres d'un préréglage d'écho
+	 * @param preset Préréglage (cf. #EchoPreset)
+	 */
+	static EchoProperties echoPreset(EchoPreset preset) noexcept;
+
+public:
+	/**
+	 * @brief Constructeur
+	 * @param zoneSlots Nombre d'emplacements pilotés par les zones
+	 * @param freeSlots Nombre d'emplacements libres
+	 */
+	Effects(std::uint16_t zoneSlots = 2, std::uint16_t freeSlots = 0);
+	//! Copie interdite
+	Effects(const Effects& other) = delete;
+	//! Copie interdite
+	Effects& operator=(const Effects& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	~Effects() noexcept;
+
+	/**
+	 * @brief Crée les emplacements et les effets (contexte actif requis)
+	 * @throw std::runtime_error si ALC_EXT_EFX n'est pas disponible
+	 */
+	void Init();
+	/**
+	 * @brief Supprime les emplacements et les effets
+	 * Les sources reliées doivent avoir été détachées (#detach) ou libérées
+	 */
+	void Quit();
+
+	/**
+	 * @brief Nombre total d'emplacements (zones puis libres)
+	 */
+	std::uint16_t slotCount() const noexcept;
+	/**
+	 * @brief Nombre d'emplacements pilotés par les zones (les premiers)
+	 */
+	std::uint16_t zoneSlotCount() const noexcept;
+	/**
+	 * @brief Nombre d'envois auxiliaires par source accordé par le pilote
+	 */
+	std::uint16_t maxSends() const noexcept;
+
+	/**
+	 * @brief Charge une réverbération dans un emplacement libre
+	 * @param slot Numéro de l'emplacement
+	 * @param preset Préréglage (cf. #ReverbPreset)
+	 */
+	void setReverb(std::uint16_t slot, ReverbPreset preset);
+	/**
+	 * @brief Charge un écho dans un emplacement libre
+	 * @param slot Numéro de l'emplacement
+	 * @param echo Paramètres de l'écho
+	 */
+	void setEcho(std::uint16_t slot, const EchoProperties& echo);
+	/**
+	 * @brief Permet de définir le volume d'un emplacement libre
+	 * @param slot Numéro de l'emplacement
+	 * @param fGain Volume (0 à 1)
+	 */
+	void setSlotGain(std::uint16_t slot, float fGain);
+	/**
+	 * @brief Permet d'obtenir le volume appliqué à un emplacement
+	 * @param slot Numéro de l'emplacement
+	 */
+	float slotGain(std::uint16_t slot) const noexcept;
+	/**
+	 * @brief Permet d'obtenir l'effet chargé dans un emplacement
+	 * @param slot Numéro de l'emplacement
+	 */
+	const SlotEffect& slotEffect(std::uint16_t slot) const noexcept;
+	/**
+	 * @brief Charge dans un emplacement libre une réverbération
+	 * intermédiaire entre deux préréglages (paramètres interpolés)
+	 * L'emplacement retient le préréglage le plus proche (cf. #slotEffect)
+	 * @param slot Numéro de l'emplacement
+	 * @param from Préréglage de départ
+	 * @param to Préréglage d'arrivée
+	 * @param t Position entre les deux (0 : from, 1 : to)
+	 */
+	void blendReverb(std::uint16_t slot, ReverbPreset from, ReverbPreset to,
+	                 float t);
+
+	/**
+	 * @brief Relie les envois d'une source aux emplacements (envoi i
+	 * vers emplacement i, dans la limite de #maxSends)
+	 * @param source Source initialisée
+	 */
+	void attach(Source& source);
+	/**
+	 * @brief Relie un envoi d'une source à un emplacement
+	 * @param source Source initialisée
+	 * @param send Numéro de l'envoi (< #maxSends)
+	 * @param slot Numéro de l'emplacement
+	 */
+	void attach(Source& source, std::uint16_t send, std::uint16_t slot);
+	/**
+	 * @brief Détache tous les envois d'une source
+	 * @param source Source initialisée
+	 */
+	void detach(Source& source);
+
+	/**
+	 * @brief Ajoute une zone de réverbération sphérique
+	 * @param preset Réverbération de la zone
+	 * @param xpos Coordonnée x du centre
+	 * @param ypos Coordonnée y du centre
+	 * @param zpos Coordonnée z du centre
+	 * @param fRadius Rayon dans lequel la zone est entièrement active
+	 * @param fFade Largeur du fondu au delà du rayon
+	 * @return Identifiant de la zone
+	 */
+	std::uint32_t addZone(ReverbPreset preset, float xpos, float ypos,
+	                      float zpos, float fRadius, float fFade);
+	/**
+	 * @brief Retire une zone de réverbération
+	 * @param zone Identifiant de la zone
+	 */
+	void removeZone(std::uint32_t zone) noexcept;
+	/**
+	 * @brief Met à jour les emplacements des zones selon l'écouteur
+	 * Les zones de plus fort poids sont chargées dans les emplacements de
+	 * zones (un effet n'est rechargé que si la zone de l'emplacement
+	 * change) et leurs volumes sont mélangés selon la distance.
+	 * À appeler à chaque image (ou quand l'écouteur se déplace).
+	 * @param xpos Coordonnée x de l'écouteur
+	 * @param ypos Coordonnée y de l'écouteur
+	 * @param zpos Coordonnée z de l'écouteur
+	 */
+	void update(float xpos, float ypos, float zpos);
+
+private:
+	//! Zone de réverbération
+	struct Zone
+	{
+		ReverbPreset preset; //!< Réverbération
+		float tblPosition[3]; //!< Centre
+		float fRadius; //!< Rayon
+		float fFade; //!< Largeur du fondu
+		bool isUsed; //!< Zone existante (sinon identifiant libre)
+	};
+
+	//! Charge une réverbération dans un emplacement (sans vérification)
+	void loadReverb(std::uint16_t slot, ReverbPreset preset);
+	//! Applique le volume d'un emplacement s'il a changé
+	void applyGain(std::uint16_t slot, float fGain);
+
+private:
+	std::uint16_t m_uZoneSlots; //!< Nombre d'emplacements de zones
+	std::uint16_t m_uSlots; //!< Nombre total d'emplacements
+	std::vector<std::uint32_t> m_tblSlots; //!< Emplacements OpenAL
+	std::vector<std::uint32_t> m_tblEffects; //!< Effet de chaque emplacement
+	std::vector<float> m_tblGains; //!< Volume appliqué à chaque emplacement
+	std::vector<SlotEffect> m_tblSlotEffects; //!< Effet de chaque emplacement
+	std::vector<std::int32_t> m_tblSlotZone; //!< Zone chargée (-1 : aucune)
+	std::vector<Zone> m_tblZones; //!< Zones (indice = identifiant)
+	std::vector<float> m_tblWeights; //!< Poids des zones (réutilisé)
+	std::vector<std::int32_t> m_tblSelected; //!< Zones retenues (réutilisé)
+};
+
+} // namespace KA3D
+
+#endif // EFFECTS_H_INCLUDED
@@ -0,0 +1,150 @@
+#ifndef LATENCYMONITOR_H_INCLUDED
+#define LATENCYMONITOR_H_INCLUDED
+/**
+ *
+ * @file LatencyMonitor.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la mesure de latence de lecture (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+#include "Source.h"
+
+namespace KA3D
+{
+
+/**
+ * @brief Mesure de la latence entre l'appel de lecture et la sortie audio
+ * Les lectures passent par #play, qui relève l'horloge du périphérique.
+ * #update (à appeler régulièrement, par exemple à chaque image) détecte
+ * le début effectif de la lecture à partir de la position de la source et
+ * de l'horloge correspondante, puis ajoute la latence de sortie.
+ * Les dernières mesures (fenêtre glissante) forment un histogramme.
+ * Nécessite ALC_SOFT_device_clock et AL_SOFT_source_latency.
+ */
+class LatencyMonitor
+{
+public:
+	/**
+	 * @brief Permet de savoir si la mesure est possible sur le contexte actif
+	 */
+	static bool isSupported() noexcept;
+
+public:
+	/**
+	 * @brief Constructeur
+	 * @param window Nombre de mesures conservées (fenêtre glissante)
+	 * @param bucketWidth Largeur d'une classe de l'histogramme (en secondes)
+	 * @param bucketCount Nombre de classes (la dernière regroupe le reste)
+	 */
+	LatencyMonitor(std::size_t window = 256, double bucketWidth = 0.001,
+	               std::size_t bucketCount = 64);
+	//! Copie interdite
+	LatencyMonitor(const LatencyMonitor& other) = delete;
+	//! Copie interdite
+	LatencyMonitor& operator=(const LatencyMonitor& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	~LatencyMonitor() noexcept;
+
+	/**
+	 * @brief Lit une source en relevant l'horloge du périphérique
+	 * @param source Source à lire (doit rester initialisée jusqu'à la mesure)
+	 */
+	void play(Source& source);
+	/**
+	 * @brief Termine les mesures des lectures ayant effectivement démarré
+	 * Les sources déjà stoppées sans mesure possible sont abandonnées
+	 */
+	void update();
+	/**
+	 * @brief Efface toutes les mesures
+	 */
+	void reset() noexcept;
+
+	/**
+	 * @brief Nombre de mesures dans la fenêtre
+	 */
+	std::size_t count() const noexcept;
+	/**
+	 * @brief Nombre de lectures en attente de mesure
+	 */
+	std::size_t pending() const noexcept;
+	/**
+	 * @brief Latence minimum de la fenêtre (en secondes)
+	 */
+	double min() const noexcept;
+	/**
+	 * @brief Latence maximum de la fenêtre (en secondes)
+	 */
+	double max() const noexcept;
+	/**
+	 * @brief Latence moyenne de la fenêtre (en secondes)
+	 */
+	double mean() const noexcept;
+	/**
+	 * @brief Centile de latence de la fenêtre
+	 * @param fraction Fraction entre 0 et 1 (0.5 : médiane, 0.99...)
+	 * @return Latence en secondes
+	 */
+	double percentile(double fraction) const;
+	/**
+	 * @brief Histogramme des latences de la fenêtre
+	 * La classe i compte les latences dans [i*bucketWidth, (i+1)*bucketWidth[
+	 * @return Nombre de mesures par classe
+	 */
+	std::vector<std::uint32_t> histogram() const;
+	/**
+	 * @brief Largeur d'une classe de l'histogramme (en secondes)
+	 */
+	double bucketWidth() const noexcept;
+
+private:
+	//! Ajoute une mesure dans la fenêtre glissante
+	void addSample(double latency);
+
+private:
+	//! Lecture en attente de mesure
+	struct Pending
+	{
+		Source* pSource; //!< Source lue
+		std::int64_t clock; //!< Horloge lors de l'appel (ns)
+		float pitch; //!< Facteur de pitch de la source
+	};
+
+	std::vector<Pending> m_tblPending; //!< Lectures en attente
+	std::vector<double> m_tblSamples; //!< Fenêtre glissante (circulaire)
+	std::size_t m_uWindow; //!< Taille de la fenêtre
+	std::size_t m_uNext; //!< Prochaine case de la fenêtre
+	double m_fBucketWidth; //!< Largeur d'une classe
+	std::size_t m_uBucketCount; //!< Nombre de classes
+};
+
+} // namespace KA3D
+
+#endif // LATENCYMONITOR_H_INCLUDED
@@ -27,6 +27,8 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstdint>
+
 #include <list>
 #include <string>
 
@@ -156,6 +158,26 @@ public:
 	 * @param iMonoSource Nombre de source stéreo exigé
 	 */
 	void setStereoSource(int iStereoSource);
+	/**
+	 * @brief Permet de définir le nombre d'envois auxiliaires par source
+	 * (extension ALC_EXT_EFX, cf. #Effects). Le pilote peut en accorder moins.
+	 * Cette attribut doit être définit avant l'initialisation
+	 * @param iSends Nombre d'envois auxiliaires demandé
+	 */
+	void setAuxiliarySends(int iSends);
+	/**
+	 * @brief Permet de définir le nombre de sources pré-allouées
+	 * Cette attribut doit être définit avant l'initialisation
+	 * Par défaut (0), la somme des sources mono et stéreo demandées
+	 * @param iSources Nombre de sources générées en un lot à l'initialisation
+	 */
+	void setSourcePool(int iSources);
+	/**
+	 * @brief Permet de définir le nombre de buffers pré-alloués
+	 * Cette attribut doit être définit avant l'initialisation
+	 * @param iBuffers Nombre de buffers générés en un lot à l'initialisation
+	 */
+	void setBufferPool(int iBuffers);
 
 	/**
 	 * @brief Permet de rendre actif ou inactif l'écouteur
@@ -184,6 +206,33 @@ public:
 	 * @return Nom du périphérique
 	 */
 	std::string device() const;
+
+	/**
+	 * @brief Permet de savoir si l'horloge du périphérique est disponible
+	 * (extension ALC_SOFT_device_clock)
+	 */
+	bool hasDeviceClock() const noexcept;
+	/**
+	 * @brief Permet d'obtenir l'horloge du périphérique
+	 * Temps écoulé depuis l'ouverture du périphérique, en nanosecondes,
+	 * au rythme des échantillons réellement mixés
+	 * @throw std::runtime_error si ALC_SOFT_device_clock est absent
+	 */
+	std::int64_t deviceClock() const;
+	/**
+	 * @brief Permet d'obtenir la latence de sortie du périphérique
+	 * Délai (en nanosecondes) entre le mixage d'un échantillon et sa sortie
+	 * @throw std::runtime_error si ALC_SOFT_device_clock est absent
+	 */
+	std::int64_t deviceLatency() const;
+	/**
+	 * @brief Permet d'obtenir l'horloge et la latence en une seule lecture
+	 * (les deux valeurs sont cohérentes entre elles)
+	 * @param[out] clock Horloge du périphérique en nanosecondes
+	 * @param[out] latency Latence de sortie en nanosecondes
+	 * @throw std::runtime_error si ALC_SOFT_device_clock est absent
+	 */
+	void deviceClockLatency(std::int64_t& clock, std::int64_t& latency) const;
 	/**
 	 * @brief Permet de définir le volume général de l'écouteur
 	 * Valeur de référence du volume :
@@ -284,6 +333,8 @@ private:
 private:
 	Context* m_pData; //!< Données interne à la classe
 	int** m_tblAttrib; //!< Attributs du contexte de l'écouteur
+	int m_iSourcePool; //!< Nombre de sources pré-allouées (0 : automatique)
+	int m_iBufferPool; //!< Nombre de buffers pré-alloués (0 : automatique)
 };
 
 } // namespace KA3D
@@ -0,0 +1,170 @@
+#ifndef MARKERDISPATCHER_H_INCLUDED
+#define MARKERDISPATCHER_H_INCLUDED
+/**
+ *
+ * @file MarkerDispatcher.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la livraison des marqueurs de lecture (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "Data.h"
+#include "Source.h"
+#include "Updater.h"
+
+namespace KA3D
+{
+
+//! Marqueur atteint par une source (cf. MarkerDispatcher)
+struct MarkerEvent
+{
+	Source* pSource; //!< Source ayant joué le marqueur
+	Marker marker; //!< Marqueur atteint
+	std::int64_t clock; //!< Horloge du périphérique où il est entendu (ns)
+};
+
+/**
+ * @brief Fonction recevant les marqueurs atteints (cf. MarkerDispatcher)
+ * @param event Marqueur atteint
+ * @param pUserData Donnée utilisateur (cf. MarkerDispatcher::setCallback)
+ */
+typedef void (*MarkerCallback)(const MarkerEvent& event, void* pUserData);
+
+/**
+ * @brief Livraison des marqueurs (cf. Data::markers) des sources jouées
+ * L'heure de chaque marqueur est prévue à partir de la position de la
+ * source, de l'horloge du périphérique correspondante et de la latence de
+ * sortie : la source n'est interrogée qu'à l'échéance prévue (ou toutes
+ * les \a resyncMs au plus), pas à chaque image. Les marqueurs entendus
+ * sont mis en file par #update (tâche de l'Updater, cf. Updater::add) et
+ * livrés par #dispatch, depuis le fil de l'appelant.
+ * Au rebouclage d'une source, les marqueurs de fin de boucle non encore
+ * livrés le sont à la détection. Après Source::setOffset, appeler de
+ * nouveau #watch.
+ * Nécessite ALC_SOFT_device_clock et AL_SOFT_source_latency.
+ */
+class MarkerDispatcher : public UpdateTask
+{
+public:
+	/**
+	 * @brief Permet de savoir si la livraison est possible sur le contexte
+	 * actif
+	 */
+	static bool isSupported() noexcept;
+
+public:
+	/**
+	 * @brief Constructeur
+	 * @param resyncMs Intervalle maximum entre deux relevés d'une source
+	 * (changements de pitch, pause...)
+	 */
+	explicit MarkerDispatcher(std::uint32_t resyncMs = 250);
+	//! Copie interdite
+	MarkerDispatcher(const MarkerDispatcher& other) = delete;
+	//! Copie interdite
+	MarkerDispatcher& operator=(const MarkerDispatcher& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	virtual ~MarkerDispatcher() noexcept;
+
+	/**
+	 * @brief Permet de définir la fonction recevant les marqueurs
+	 * @param callback Fonction appelée par #dispatch (nullptr : aucune)
+	 * @param pUserData Donnée utilisateur transmise à la fonction
+	 */
+	void setCallback(MarkerCallback callback, void* pUserData = nullptr);
+
+	/**
+	 * @brief Suit les marqueurs d'une source (après Source::play)
+	 * Les marqueurs déjà passés sont ignorés ; la source est oubliée
+	 * une fois stoppée
+	 * @param source Source initialisée (doit le rester jusqu'à #unwatch)
+	 */
+	void watch(Source& source);
+	/**
+	 * @brief Oublie une source (obligatoire avant Source::Quit ou la
+	 * destruction de la source)
+	 * @param source Source
+	 */
+	void unwatch(const Source& source) noexcept;
+	/**
+	 * @brief Nombre de sources suivies
+	 */
+	std::size_t watched() const;
+
+	/**
+	 * @brief Livre les marqueurs en file à la fonction (cf. #setCallback)
+	 * @return Nombre de marqueurs livrés
+	 */
+	std::size_t dispatch();
+
+	/**
+	 * @brief Met en file les marqueurs entendus (appelé par l'Updater)
+	 * @param fDelta Temps écoulé depuis le dernier pas (non utilisé)
+	 */
+	void update(float fDelta) override;
+
+private:
+	//! Source suivie
+	struct Watch
+	{
+		Source* pSource; //!< Source
+		Data* pData; //!< Données de la source (marqueurs)
+		std::size_t uNext; //!< Prochain marqueur
+		std::uint32_t uLoopStart; //!< Début de la boucle jouée
+		std::uint32_t uLoopEnd; //!< Fin de la boucle jouée (0 : fin)
+		double fSyncPos; //!< Position relevée (échantillons)
+		std::int64_t syncClock; //!< Horloge où elle est entendue (ns)
+		double fRate; //!< Échantillons par seconde (pitch compris)
+		std::int64_t due; //!< Prochain relevé (ns)
+		bool isDone; //!< Source stoppée
+	};
+
+	//! Relève la position d'une source et met en file les marqueurs
+	void resync(Watch& watch, std::int64_t clock, std::int64_t latency);
+	//! Heure (horloge du périphérique) où une position est entendue
+	std::int64_t audibleClock(const Watch& watch, double position)
+		const noexcept;
+	//! Met en file un marqueur
+	void push(Watch& watch, const Marker& marker, std::int64_t clock);
+
+private:
+	std::int64_t m_resyncNs; //!< Intervalle maximum entre deux relevés
+	std::vector<Watch> m_tblWatches; //!< Sources suivies
+	std::deque<MarkerEvent> m_tblEvents; //!< Marqueurs à livrer
+	MarkerCallback m_callback; //!< Fonction recevant les marqueurs
+	void* m_pUserData; //!< Donnée utilisateur de la fonction
+	mutable std::mutex m_mutex; //!< Protection des sources et de la file
+};
+
+} // namespace KA3D
+
+#endif // MARKERDISPATCHER_H_INCLUDED
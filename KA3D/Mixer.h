@@ -0,0 +1,374 @@
+#ifndef MIXER_H_INCLUDED
+#define MIXER_H_INCLUDED
+/**
+ *
+ * @file Mixer.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant le mixeur logiciel (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <vector>
+
+#include "Listener.h"
+#include "MixerBuffer.h"
+#include "MixerEffect.h"
+
+namespace KA3D
+{
+
+class Ducker;
+class MixerPrivate;
+
+//! Identifiant d'une voix du mixeur logiciel (0 : aucune voix)
+typedef std::uint32_t MixerVoice;
+
+/**
+ * @brief Fonction recevant le signal rendu par #Mixer::process
+ * @param pSamples Échantillons flottants entrelacés
+ * @param frames Nombre d'échantillons par canal
+ * @param pUserData Donnée utilisateur (cf. #Mixer::setCallback)
+ */
+typedef void (*MixerCallback)(const float* pSamples, std::uint32_t frames,
+                              void* pUserData);
+
+/**
+ * @brief Mixeur logiciel, alternative à OpenAL
+ * Mixe des voix (lecture d'un #MixerBuffer) en flottant avec le même
+ * modèle qu'OpenAL : gain, pitch, atténuation (cf. #DistanceModel), cônes
+ * et effet doppler. Le signal est obtenu en tirant des échantillons avec
+ * #render (ex : depuis la fonction de rappel d'une API audio) ou poussé
+ * vers une fonction de rappel par #process.
+ * Les paramètres sont évalués une fois par bloc, les gains variant
+ * linéairement au cours du bloc.
+ * @note Le mixeur n'est pas protégé contre les accès concurrents : les
+ * voix doivent être modifiées depuis le fil qui appelle #render.
+ */
+class Mixer
+{
+public:
+	//! Taille par défaut d'un bloc de mixage (en échantillons)
+	static constexpr std::uint32_t DEFAULT_BLOCK_SIZE = 256;
+	//! Nombre de groupes de voix (cf. #setVoiceGroup)
+	static constexpr std::uint16_t GROUP_COUNT = 8;
+
+public:
+	/**
+	 * @brief Constructeur
+	 * @param frequency Fréquence de la sortie en Hertz
+	 * @param channels Nombre de canaux de la sortie (1 ou 2)
+	 * @param blockSize Taille maximale d'un bloc de mixage
+	 */
+	Mixer(std::uint32_t frequency = 44100, std::uint16_t channels = 2,
+	      std::uint32_t blockSize = DEFAULT_BLOCK_SIZE);
+	//! Copie interdite
+	Mixer(const Mixer& other) = delete;
+	//! Copie interdite
+	Mixer& operator=(const Mixer& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	~Mixer() noexcept;
+
+	/**
+	 * @brief Fréquence de la sortie en Hertz
+	 */
+	std::uint32_t frequency() const noexcept;
+	/**
+	 * @brief Nombre de canaux de la sortie
+	 */
+	std::uint16_t channels() const noexcept;
+
+	/**
+	 * @brief Active le bus ambisonique intermédiaire
+	 * Les voix mono sont encodées (format B, ACN/SN3D) dans un bus partagé
+	 * avec un simple vecteur de gains, puis le bus est décodé une seule fois
+	 * par bloc vers la sortie : le coût par voix ne dépend plus du décodeur.
+	 * Le décodeur par défaut utilise deux cardioïdes virtuelles (stéreo).
+	 * @param order Ordre ambisonique : 0 (désactivé, panoramique direct)
+	 * à 3 (16 canaux)
+	 * @throw std::runtime_error si l'ordre n'est pas supporté
+	 */
+	void setAmbisonicOrder(std::uint16_t order);
+	/**
+	 * @brief Ordre du bus ambisonique (0 : désactivé)
+	 */
+	std::uint16_t ambisonicOrder() const noexcept;
+	/**
+	 * @brief Permet de définir la matrice de décodage du bus ambisonique
+	 * Exemple : décodage vers une disposition de haut-parleurs
+	 * Remise à la valeur par défaut par #setAmbisonicOrder
+	 * @param tblMatrix Gains [sortie][canal ACN], #channels × (ordre+1)²
+	 * @throw std::runtime_error si la taille de la matrice est incorrecte
+	 */
+	void setAmbisonicDecoder(const std::vector<float>& tblMatrix);
+
+	/**
+	 * @brief Ajoute un effet au bus de sortie (ex : #Convolver)
+	 * Les effets sont appliqués dans l'ordre d'ajout, une fois par bloc,
+	 * après le décodage ambisonique. L'effet n'est pas détruit par le mixeur.
+	 * @param pEffect Effet à ajouter
+	 */
+	void addEffect(MixerEffect* pEffect);
+	/**
+	 * @brief Retire un effet du bus de sortie
+	 * @param pEffect Effet à retirer
+	 */
+	void removeEffect(MixerEffect* pEffect) noexcept;
+
+	/**
+	 * @brief Permet de définir le groupe d'une voix (0 par défaut)
+	 * Les groupes (musique, voix...) ont un volume commun et un niveau
+	 * mesuré sur les échantillons mixés
+	 * @param voice Voix
+	 * @param group Groupe (< #GROUP_COUNT)
+	 */
+	void setVoiceGroup(MixerVoice voice, std::uint16_t group) noexcept;
+	/**
+	 * @brief Permet de définir le volume d'un groupe
+	 * @param group Groupe (< #GROUP_COUNT)
+	 * @param fGain Volume multiplié à celui des voix du groupe
+	 */
+	void setGroupGain(std::uint16_t group, float fGain) noexcept;
+	/**
+	 * @brief Niveau RMS des voix d'un groupe sur le dernier bloc mixé
+	 * (après volume et atténuation, avant panoramique)
+	 * @param group Groupe (< #GROUP_COUNT)
+	 */
+	float groupLevel(std::uint16_t group) const noexcept;
+	/**
+	 * @brief Ajoute une atténuation par déclenchement évaluée à chaque bloc
+	 * Le niveau du groupe déclencheur fait avancer l'enveloppe, dont le
+	 * volume est multiplié à celui du groupe cible (#setGroupGain) au bloc
+	 * suivant
+	 * @param pDucker Atténuation (doit rester valide jusqu'à #removeDucker)
+	 * @param trigger Groupe déclencheur (< #GROUP_COUNT)
+	 * @param target Groupe atténué (< #GROUP_COUNT)
+	 */
+	void addDucker(Ducker* pDucker, std::uint16_t trigger,
+	               std::uint16_t target);
+	/**
+	 * @brief Retire une atténuation et rend son volume au groupe cible
+	 * @param pDucker Atténuation
+	 */
+	void removeDucker(Ducker* pDucker) noexcept;
+
+	/**
+	 * @brief Permet de définir le nombre de fils de mixage
+	 * Les voix sont mixées par lots répartis entre les fils (vol de tâches) ;
+	 * le signal rendu est identique quel que soit le nombre de fils.
+	 * @param threads Nombre de fils, appelant de #render compris
+	 * (0 : nombre de cœurs de la machine, 1 : pas de fil supplémentaire)
+	 */
+	void setThreadCount(std::uint32_t threads);
+	/**
+	 * @brief Nombre de fils de mixage, appelant de #render compris
+	 */
+	std::uint32_t threadCount() const noexcept;
+
+	/**
+	 * @brief Rend les échantillons suivants (mode « pull »)
+	 * @param[out] pOut Échantillons flottants entrelacés
+	 * (frames × #channels valeurs)
+	 * @param frames Nombre d'échantillons par canal à rendre
+	 */
+	void render(float* pOut, std::uint32_t frames);
+	/**
+	 * @brief Permet de définir la fonction recevant le signal de #process
+	 * @param callback Fonction de rappel (nullptr pour aucune)
+	 * @param pUserData Donnée transmise à la fonction de rappel
+	 */
+	void setCallback(MixerCallback callback, void* pUserData = nullptr);
+	/**
+	 * @brief Rend des échantillons et les pousse vers la fonction de rappel
+	 * La fonction de rappel est appelée une fois par bloc de mixage
+	 * @param frames Nombre d'échantillons par canal à rendre
+	 */
+	void process(std::uint32_t frames);
+
+	/**
+	 * @brief Crée une voix lisant des données audio
+	 * Les données (mono ou stéreo) doivent rester valides tant que la voix
+	 * existe. Seules les données mono sont spatialisées (comme OpenAL).
+	 * @param pBuffer Données audio
+	 * @return Identifiant de la voix (à libérer avec #removeVoice)
+	 */
+	MixerVoice addVoice(const MixerBuffer* pBuffer);
+	/**
+	 * @brief Détruit une voix (l'identifiant pourra être réutilisé)
+	 * @param voice Identifiant de la voix
+	 */
+	void removeVoice(MixerVoice voice) noexcept;
+
+	/**
+	 * @brief Permet de lire la voix
+	 */
+	void play(MixerVoice voice) noexcept;
+	/**
+	 * @brief Permet de mettre en pause la voix
+	 */
+	void pause(MixerVoice voice) noexcept;
+	/**
+	 * @brief Permet de stopper la lecture de la voix
+	 */
+	void stop(MixerVoice voice) noexcept;
+	/**
+	 * @brief Remet au début la voix (et l'arrête)
+	 */
+	void rewind(MixerVoice voice) noexcept;
+	/**
+	 * @brief Permet de savoir si la voix est en cours de lecture
+	 */
+	bool isPlaying(MixerVoice voice) const noexcept;
+	/**
+	 * @brief Permet de savoir si la voix est en pause
+	 */
+	bool isPaused(MixerVoice voice) const noexcept;
+	/**
+	 * @brief Permet de savoir si la voix est stoppée
+	 */
+	bool isStopped(MixerVoice voice) const noexcept;
+
+	/**
+	 * @brief Permet de définir la position de la voix
+	 */
+	void setPosition(MixerVoice voice, float xpos, float ypos, float zpos)
+		noexcept;
+	/**
+	 * @brief Permet de définir la vitesse (vecteur vitesse) de la voix
+	 */
+	void setVelocity(MixerVoice voice, float xvel, float yvel, float zvel)
+		noexcept;
+	/**
+	 * @brief Permet de définir la direction de la voix (cône)
+	 * Un vecteur nul rend la voix omnidirectionnelle
+	 */
+	void setDirection(MixerVoice voice, float xat, float yat, float zat)
+		noexcept;
+	/**
+	 * @brief Permet de définir le pitch de la voix
+	 * @param factor facteur multiplicateur du pitch
+	 */
+	void setPitch(MixerVoice voice, float factor) noexcept;
+	/**
+	 * @brief Permet de définir le volume de la voix
+	 */
+	void setGain(MixerVoice voice, float fGain) noexcept;
+	/**
+	 * @brief Distance au delà de laquelle l'atténuation n'évolue plus
+	 */
+	void setMaxDistance(MixerVoice voice, float fMaxDistance) noexcept;
+	/**
+	 * @brief Facteur de l'atténuation avec la distance
+	 */
+	void setRollOffFactor(MixerVoice voice, float fRollOff) noexcept;
+	/**
+	 * @brief Distance à laquelle le volume n'est pas atténué
+	 */
+	void setReferenceDistance(MixerVoice voice, float fRefDistance) noexcept;
+	/**
+	 * @brief Volume minimum de la voix après atténuation
+	 */
+	void setMinGain(MixerVoice voice, float fMinGain) noexcept;
+	/**
+	 * @brief Volume maximum de la voix après atténuation
+	 */
+	void setMaxGain(MixerVoice voice, float fMaxGain) noexcept;
+	/**
+	 * @brief Volume à l'extérieur du cône extérieur
+	 */
+	void setConeOuterGain(MixerVoice voice, float fConeOuterGain) noexcept;
+	/**
+	 * @brief Angle (en degrés) du cône intérieur (volume non atténué)
+	 */
+	void setConeInnerAngle(MixerVoice voice, float fConeInnerAngle) noexcept;
+	/**
+	 * @brief Angle (en degrés) du cône extérieur
+	 */
+	void setConeOuterAngle(MixerVoice voice, float fConeOuterAngle) noexcept;
+	/**
+	 * @brief Permet de définir si la position est relative à l'écouteur
+	 */
+	void setRelative(MixerVoice voice, bool isRelative) noexcept;
+	/**
+	 * @brief Permet de définir la position de lecture (en échantillons)
+	 */
+	void setOffset(MixerVoice voice, std::uint32_t sample) noexcept;
+	/**
+	 * @brief Permet de définir si la voix reboucle à la fin
+	 * (sur la boucle du buffer, cf. MixerBuffer::setLoopPoints)
+	 */
+	void setAutoLoop(MixerVoice voice, bool isLooping) noexcept;
+	/**
+	 * @brief Permet d'obtenir la position de lecture (en échantillons)
+	 */
+	std::uint32_t offset(MixerVoice voice) const noexcept;
+
+	/**
+	 * @brief Permet de définir le volume général de l'écouteur
+	 */
+	void setListenerGain(float gain) noexcept;
+	/**
+	 * @brief Permet de définir la position de l'écouteur
+	 */
+	void setListenerPosition(float xpos, float ypos, float zpos) noexcept;
+	/**
+	 * @brief Permet de définir la vitesse de l'écouteur
+	 */
+	void setListenerVelocity(float xvel, float yvel, float zvel) noexcept;
+	/**
+	 * @brief Permet de définir l'orientation de l'écouteur
+	 * @param xat x du vecteur représentant la direction de l'écouteur
+	 * @param yat y du vecteur représentant la direction de l'écouteur
+	 * @param zat z du vecteur représentant la direction de l'écouteur
+	 * @param xup x du vecteur représentant l'axe vertical
+	 * @param yup y du vecteur représentant l'axe vertical
+	 * @param zup z du vecteur représentant l'axe vertical
+	 */
+	void setListenerOrientation(float xat, float yat, float zat,
+	                            float xup, float yup, float zup) noexcept;
+	/**
+	 * @brief Permet de définir le facteur d'éxagération de l'effet doppler
+	 */
+	void setDopplerFactor(float factor) noexcept;
+	/**
+	 * @brief Permet de définir la vitesse du son (en "unité" par seconde)
+	 */
+	void setSpeedSound(float fSpeedSound) noexcept;
+	/**
+	 * @brief Permet de définir le modèle d'atténuation (voir #DistanceModel)
+	 */
+	void setDistanceModel(DistanceModel model) noexcept;
+
+private:
+	//! Entrelace le bus de sortie dans pOut
+	void interleave(float* pOut, std::uint32_t frames) const noexcept;
+
+private:
+	MixerPrivate* m_pData; //!< Données interne à la classe
+};
+
+} // namespace KA3D
+
+#endif // MIXER_H_INCLUDED
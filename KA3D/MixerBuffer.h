@@ -0,0 +1,133 @@
+#ifndef MIXERBUFFER_H_INCLUDED
+#define MIXERBUFFER_H_INCLUDED
+/**
+ *
+ * @file MixerBuffer.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les données audio du mixeur logiciel (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <iostream>
+#include <vector>
+
+#include "Data.h"
+
+namespace KA3D
+{
+
+class Reader;
+
+/**
+ * @brief Données audio du mixeur logiciel (cf. #Mixer)
+ * Contrairement à #Data, les échantillons restent en mémoire centrale,
+ * convertis en flottants et rangés par canal (planaire) pour le mixage.
+ */
+class MixerBuffer
+{
+public:
+	/**
+	 * @brief Permet de charger des données audio à partir d'un tableau d'octet
+	 * @param tblData Données brutes
+	 * @param format Format des données brute (cf. #DataFormat)
+	 * @param freq Fréquence d'échantillonage des données
+	 * @return Pointeur alloué dynamiquement (avec new) vers les données
+	 */
+	static MixerBuffer* fromData(const std::vector<std::uint8_t>& tblData,
+	                             DataFormat format, std::uint32_t freq);
+	/**
+	 * @brief Permet de charger des données audio à partir d'un contenue wav
+	 * (boucle du chunk smpl comprise, cf. #setLoopPoints)
+	 * @param file Flux contenant le fichier audio
+	 * @return Pointeur alloué dynamiquement (avec new) vers les données
+	 */
+	static MixerBuffer* fromWav(std::iostream& file);
+	/**
+	 * @brief Permet de charger des données audio à partir d'un contenue wav
+	 * @param reader Source du fichier audio (mémoire, descripteur...)
+	 * @return Pointeur alloué dynamiquement (avec new) vers les données
+	 */
+	static MixerBuffer* fromWav(Reader& reader);
+
+public:
+	/**
+	 * @brief Constructeur (échantillons flottants planaires)
+	 * @param tblSamples Échantillons, canal après canal
+	 * @param channels Nombre de canaux
+	 * @param freq Fréquence d'échantillonage
+	 */
+	MixerBuffer(std::vector<float> tblSamples, std::uint16_t channels,
+	            std::uint32_t freq);
+	//! Copie interdite
+	MixerBuffer(const MixerBuffer& other) = delete;
+	//! Copie interdite
+	MixerBuffer& operator=(const MixerBuffer& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	~MixerBuffer() noexcept;
+
+	/**
+	 * @brief Permet d'obtenir les échantillons d'un canal
+	 * @param channel Numéro du canal
+	 */
+	const float* channel(std::uint16_t channel) const noexcept;
+	/**
+	 * @brief Nombre de canaux
+	 */
+	std::uint16_t channels() const noexcept;
+	/**
+	 * @brief Nombre d'échantillons par canal
+	 */
+	std::uint32_t frames() const noexcept;
+	/**
+	 * @brief Fréquence d'échantillonage
+	 */
+	std::uint32_t frequency() const noexcept;
+
+	/**
+	 * @brief Permet de définir une boucle sur une partie des données
+	 * Une voix en boucle (Mixer::setAutoLoop) joue le début des données
+	 * puis répète [start, end[ (à définir avant de jouer le buffer)
+	 * @param start Début de la boucle (en échantillons par canal)
+	 * @param end Fin de la boucle, exclue (en échantillons par canal)
+	 */
+	void setLoopPoints(std::uint32_t start, std::uint32_t end);
+	//! Début de la boucle (0 par défaut)
+	std::uint32_t loopStart() const noexcept;
+	//! Fin de la boucle, exclue (#frames par défaut)
+	std::uint32_t loopEnd() const noexcept;
+
+private:
+	std::vector<float> m_tblSamples; //!< Échantillons (planaires)
+	std::uint16_t m_uChannels; //!< Nombre de canaux
+	std::uint32_t m_uFrames; //!< Nombre d'échantillons par canal
+	std::uint32_t m_uFrequency; //!< Fréquence d'échantillonage
+	std::uint32_t m_uLoopStart; //!< Début de la boucle
+	std::uint32_t m_uLoopEnd; //!< Fin de la boucle (exclue)
+};
+
+} // namespace KA3D
+
+#endif // MIXERBUFFER_H_INCLUDED
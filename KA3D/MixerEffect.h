@@ -1,12 +1,12 @@
-#ifndef AUDIODATAPRIVATE_H_INCLUDED
-#define AUDIODATAPRIVATE_H_INCLUDED
+#ifndef MIXEREFFECT_H_INCLUDED
+#define MIXEREFFECT_H_INCLUDED
 /**
  *
- * @file DataPrivate.h
+ * @file MixerEffect.h
  * @author karfouilla
- * @version α.0.1
- * @date 27 avril 2019
- * @brief Fichier contenant la classe de gestion privée des données audio (H)
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'interface des effets du mixeur logiciel (H)
  *
  */
 ////////////////////////////////////////////////////////////////////////////////
@@ -27,21 +27,33 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <AL/al.h>
+#include <cstdint>
 
 namespace KA3D
 {
 
-class DataPrivate
+/**
+ * @brief Effet appliqué au bus de sortie du mixeur logiciel
+ * (cf. Mixer::addEffect), ou à tout signal planaire
+ */
+class MixerEffect
 {
 public:
-	DataPrivate() noexcept: handle(0) { }
-	~DataPrivate() noexcept { }
+	/**
+	 * @brief Destructeur
+	 */
+	virtual ~MixerEffect() noexcept;
 
-public:
-	ALuint handle;
+	/**
+	 * @brief Traite un bloc de signal (en place)
+	 * @param tblChannels Échantillons de chaque canal
+	 * @param channels Nombre de canaux
+	 * @param frames Nombre d'échantillons par canal
+	 */
+	virtual void process(float* const* tblChannels, std::uint16_t channels,
+	                     std::uint32_t frames) = 0;
 };
 
 } // namespace KA3D
 
-#endif // AUDIODATAPRIVATE_H_INCLUDED
+#endif // MIXEREFFECT_H_INCLUDED
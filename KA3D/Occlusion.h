@@ -0,0 +1,209 @@
+#ifndef OCCLUSION_H_INCLUDED
+#define OCCLUSION_H_INCLUDED
+/**
+ *
+ * @file Occlusion.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'occultation des sources par le décor (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstdint>
+
+#include <functional>
+#include <vector>
+
+#include "Source.h"
+
+namespace KA3D
+{
+
+//! Statistiques de la dernière mise à jour de l'occultation
+struct OcclusionStats
+{
+	std::uint32_t uQueries; //!< Requêtes de rayon effectuées
+	std::uint32_t uBudget; //!< Budget de requêtes par mise à jour
+	std::uint32_t uSources; //!< Sources suivies
+	std::uint32_t uFilterUpdates; //!< Filtres envoyés au pilote
+};
+
+/**
+ * @brief Occultation et obstruction des sources (filtres passe-bas EFX)
+ * Le décor n'est pas connu de KAudio3D : une fonction de l'utilisateur
+ * lance un rayon de l'écouteur vers la source et retourne l'occultation
+ * (son traversant un mur : atténuation globale et des aigus) et
+ * l'obstruction (obstacle contourné : atténuation des aigus) entre 0 et 1.
+ *
+ * Les requêtes sont coûteuses : seules #budget sources sont interrogées à
+ * chaque #update, à tour de rôle ; les valeurs sont lissées entre deux
+ * requêtes. Les filtres sont créés en une fois à l'initialisation (un par
+ * source suivie) et ne sont renvoyés au pilote que si leur valeur change.
+ */
+class Occlusion
+{
+public:
+	/**
+	 * @brief Requête de rayon de l'utilisateur
+	 * @param tblFrom Position de l'écouteur
+	 * @param tblTo Position de la source
+	 * @param[out] fOcclusion Occultation (0 : aucune, 1 : totale)
+	 * @param[out] fObstruction Obstruction (0 : aucune, 1 : totale)
+	 */
+	typedef std::function<void(const float* tblFrom, const float* tblTo,
+	                           float& fOcclusion, float& fObstruction)>
+		RayQuery;
+
+	/**
+	 * @brief Permet de savoir si l'extension ALC_EXT_EFX est disponible
+	 * sur le contexte actif
+	 */
+	static bool isSupported() noexcept;
+
+public:
+	/**
+	 * @brief Constructeur
+	 * @param query Requête de rayon
+	 * @param budget Nombre de requêtes par mise à jour
+	 */
+	Occlusion(const RayQuery& query, std::uint32_t budget = 16);
+	//! Copie interdite
+	Occlusion(const Occlusion& other) = delete;
+	//! Copie interdite
+	Occlusion& operator=(const Occlusion& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	~Occlusion() noexcept;
+
+	/**
+	 * @brief Crée les filtres (contexte actif requis)
+	 * @param maxSources Nombre maximum de sources suivies
+	 * @throw std::runtime_error si ALC_EXT_EFX n'est pas disponible
+	 */
+	void Init(std::uint32_t maxSources);
+	/**
+	 * @brief Détache les filtres des sources suivies et les supprime
+	 */
+	void Quit();
+
+	/**
+	 * @brief Permet de définir le nombre de requêtes par mise à jour
+	 * @param budget Nombre de requêtes (au moins 1)
+	 */
+	void setBudget(std::uint32_t budget) noexcept;
+	/**
+	 * @brief Permet d'obtenir le nombre de requêtes par mise à jour
+	 */
+	std::uint32_t budget() const noexcept;
+	/**
+	 * @brief Permet de définir la constante de temps du lissage
+	 * @param fTime Constante de temps en secondes (0 : pas de lissage)
+	 */
+	void setSmoothing(float fTime) noexcept;
+	/**
+	 * @brief Permet de définir les atténuations d'une occultation totale
+	 * @param fGain Volume global (0 à 1)
+	 * @param fGainHF Volume des aigus (0 à 1)
+	 */
+	void setOcclusionFilter(float fGain, float fGainHF) noexcept;
+	/**
+	 * @brief Permet de définir l'atténuation d'une obstruction totale
+	 * @param fGainHF Volume des aigus (0 à 1)
+	 */
+	void setObstructionFilter(float fGainHF) noexcept;
+
+	/**
+	 * @brief Suit une source
+	 * La source peut être quittée puis réinitialisée sans #remove : son
+	 * ancienne source OpenAL est rendue sans filtre et le filtre est
+	 * rattaché à la nouvelle au prochain #update.
+	 * @param source Source à suivre
+	 * @return Identifiant de la source suivie
+	 * @throw std::runtime_error si toutes les places sont prises
+	 */
+	std::uint32_t add(Source& source);
+	/**
+	 * @brief Ne suit plus une source et lui retire son filtre
+	 * @param id Identifiant retourné par #add
+	 */
+	void remove(std::uint32_t id);
+	/**
+	 * @brief Permet d'obtenir l'occultation lissée d'une source suivie
+	 * @param id Identifiant retourné par #add
+	 */
+	float occlusion(std::uint32_t id) const noexcept;
+	/**
+	 * @brief Permet d'obtenir l'obstruction lissée d'une source suivie
+	 * @param id Identifiant retourné par #add
+	 */
+	float obstruction(std::uint32_t id) const noexcept;
+
+	/**
+	 * @brief Interroge les sources suivantes (dans la limite du budget),
+	 * lisse toutes les valeurs et met à jour les filtres modifiés
+	 * À appeler à chaque image.
+	 * @param xpos Coordonnée x de l'écouteur
+	 * @param ypos Coordonnée y de l'écouteur
+	 * @param zpos Coordonnée z de l'écouteur
+	 * @param fDelta Temps écoulé depuis la dernière mise à jour (secondes)
+	 */
+	void update(float xpos, float ypos, float zpos, float fDelta);
+	/**
+	 * @brief Statistiques de la dernière mise à jour
+	 */
+	const OcclusionStats& stats() const noexcept;
+
+private:
+	//! Source suivie
+	struct Entry
+	{
+		Source* pSource; //!< Source (nullptr : place libre)
+		float fTargetOcclusion; //!< Dernière occultation mesurée
+		float fTargetObstruction; //!< Dernière obstruction mesurée
+		float fOcclusion; //!< Occultation lissée
+		float fObstruction; //!< Obstruction lissée
+		float fGain; //!< Volume envoyé au filtre
+		float fGainHF; //!< Volume des aigus envoyé au filtre
+		bool isFiltered; //!< Filtre attaché à la source
+		std::uint32_t uHandle; //!< Source OpenAL portant le filtre
+	};
+
+	//! Calcule et applique le filtre d'une source s'il a changé
+	bool applyFilter(std::uint32_t id);
+
+private:
+	RayQuery m_query; //!< Requête de rayon de l'utilisateur
+	std::uint32_t m_uBudget; //!< Requêtes par mise à jour
+	std::uint32_t m_uCursor; //!< Prochaine source à interroger
+	float m_fSmoothing; //!< Constante de temps du lissage
+	float m_fOcclusionGain; //!< Volume d'une occultation totale
+	float m_fOcclusionGainHF; //!< Volume des aigus d'une occultation totale
+	float m_fObstructionGainHF; //!< Volume des aigus d'une obstruction totale
+	std::vector<Entry> m_tblEntries; //!< Sources suivies (indice = id)
+	std::vector<std::uint32_t> m_tblFilters; //!< Filtre de chaque place
+	OcclusionStats m_stats; //!< Statistiques de la dernière mise à jour
+};
+
+} // namespace KA3D
+
+#endif // OCCLUSION_H_INCLUDED
@@ -0,0 +1,78 @@
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+/**
+ *
+ * @file Profiler.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant le profilage interne de la bibliothèque (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+
+namespace KA3D
+{
+
+/**
+ * @brief Accès aux mesures de profilage de KAudio3D
+ * Le profilage est optionnel : compilé seulement avec KA3D_PROFILING
+ * (option CMake du même nom). Sans cette option, aucune mesure n'est
+ * faite et les fonctions d'export produisent un résultat vide.
+ *
+ * Les compteurs (appels AL, vérifications d'erreur, octets lus...) sont
+ * propres à chaque thread et incrémentés sans verrou ; les chronomètres
+ * de portée (Data::fromWav, WaveFile::read...) sont enregistrés dans un
+ * tampon par thread.
+ */
+class Profiler
+{
+public:
+	/**
+	 * @brief Permet de savoir si le profilage a été compilé
+	 */
+	static bool isEnabled() noexcept;
+	/**
+	 * @brief Marque la fin d'une image
+	 * Les compteurs de l'image écoulée sont conservés pour le résumé
+	 * et comme événements de compteur dans la trace (16384 dernières
+	 * images au plus)
+	 */
+	static void frame();
+	/**
+	 * @brief Efface toutes les mesures (compteurs, images et événements)
+	 */
+	static void reset();
+	/**
+	 * @brief Écrit la trace au format JSON de Chrome (chrome://tracing)
+	 * @param out Flux de sortie
+	 */
+	static void writeChromeTrace(std::ostream& out);
+	/**
+	 * @brief Écrit un résumé texte (compteurs par image, temps par portée)
+	 * @param out Flux de sortie
+	 */
+	static void writeSummary(std::ostream& out);
+};
+
+} // namespace KA3D
+
+#endif // PROFILER_H_INCLUDED
@@ -0,0 +1,184 @@
+#ifndef READER_H_INCLUDED
+#define READER_H_INCLUDED
+/**
+ *
+ * @file Reader.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les sources de lecture des fichiers audio (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <iostream>
+#include <vector>
+
+namespace KA3D
+{
+
+/**
+ * @brief Source d'octets lue par position (cf. WaveFile)
+ * Plus légère qu'un std::iostream : un appel par lecture, sans état de
+ * flux ni locale. Les positions sont relatives au début de la source.
+ */
+class Reader
+{
+public:
+	//! Destructeur
+	virtual ~Reader() noexcept { }
+	/**
+	 * @brief Lit des octets à une position
+	 * @param offset Position depuis le début de la source
+	 * @param[out] data Destination des octets lus
+	 * @param size Nombre d'octets à lire
+	 * @return Nombre d'octets lus (moins que \a size en fin de source)
+	 * @throw std::runtime_error en cas d'erreur de lecture
+	 */
+	virtual std::size_t readAt(std::uint64_t offset, void* data,
+	                           std::size_t size) = 0;
+};
+
+/**
+ * @brief Lecture d'un bloc en mémoire (copie directe, sans copie préalable)
+ * Les données doivent rester valides tant que la source est utilisée
+ */
+class SpanReader : public Reader
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param data Début du bloc
+	 * @param size Taille du bloc en octets
+	 */
+	SpanReader(const void* data, std::size_t size) noexcept;
+	std::size_t readAt(std::uint64_t offset, void* data,
+	                   std::size_t size) override;
+
+protected:
+	const std::uint8_t* m_pData; //!< Début du bloc
+	std::size_t m_uSize; //!< Taille du bloc
+};
+
+/**
+ * @brief Lecture d'un std::istream (compatibilité, cf. WaveFile)
+ * La position de départ est celle du flux à la première lecture ; le
+ * flux n'est déplacé que si la lecture n'est pas consécutive
+ */
+class StreamReader : public Reader
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param refStream Flux lu (doit rester valide)
+	 */
+	explicit StreamReader(std::istream& refStream) noexcept;
+	std::size_t readAt(std::uint64_t offset, void* data,
+	                   std::size_t size) override;
+	/**
+	 * @brief Place le curseur du flux à une position de la source
+	 * @param offset Position depuis le début de la source
+	 */
+	void seek(std::uint64_t offset);
+
+private:
+	std::istream& m_refStream; //!< Flux lu
+	std::uint64_t m_uPos; //!< Position du flux depuis le départ
+};
+
+/**
+ * @brief Lecture par blocs d'une autre source (petites lectures groupées)
+ * Les lectures plus grandes qu'un bloc sont transmises directement
+ */
+class BufferedReader : public Reader
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param refSource Source lue (doit rester valide)
+	 * @param blockSize Taille d'un bloc en octets
+	 */
+	explicit BufferedReader(Reader& refSource,
+	                        std::size_t blockSize = 64 * 1024);
+	std::size_t readAt(std::uint64_t offset, void* data,
+	                   std::size_t size) override;
+
+private:
+	Reader& m_refSource; //!< Source lue
+	std::vector<std::uint8_t> m_tblBlock; //!< Bloc en cache
+	std::uint64_t m_uBlockPos; //!< Position du bloc dans la source
+	std::size_t m_uBlockSize; //!< Octets valides du bloc
+};
+
+#ifndef _WIN32
+/**
+ * @brief Lecture d'un descripteur de fichier avec pread (POSIX)
+ * Sans curseur partagé : plusieurs lecteurs peuvent utiliser le même
+ * descripteur (ex : portions d'un fichier d'archive)
+ */
+class FdReader : public Reader
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param fd Descripteur ouvert en lecture (non fermé par la source)
+	 * @param base Position du début de la source dans le fichier
+	 */
+	explicit FdReader(int fd, std::uint64_t base = 0) noexcept;
+	std::size_t readAt(std::uint64_t offset, void* data,
+	                   std::size_t size) override;
+
+private:
+	int m_fd; //!< Descripteur lu
+	std::uint64_t m_uBase; //!< Début de la source dans le fichier
+};
+
+/**
+ * @brief Lecture d'un fichier projeté en mémoire (mmap, POSIX)
+ */
+class MmapReader : public SpanReader
+{
+public:
+	//! Constructeur (aucun fichier, cf. #Init)
+	MmapReader() noexcept;
+	//! Copie interdite
+	MmapReader(const MmapReader& other) = delete;
+	//! Copie interdite
+	MmapReader& operator=(const MmapReader& other) = delete;
+	//! Destructeur (cf. #Quit)
+	virtual ~MmapReader() noexcept;
+	/**
+	 * @brief Projette un fichier en mémoire
+	 * @param szPath Chemin du fichier
+	 */
+	void Init(const char* szPath);
+	/**
+	 * @brief Libère la projection
+	 */
+	void Quit() noexcept;
+};
+#endif // _WIN32
+
+} // namespace KA3D
+
+#endif // READER_H_INCLUDED
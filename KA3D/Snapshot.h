@@ -0,0 +1,173 @@
+#ifndef SNAPSHOT_H_INCLUDED
+#define SNAPSHOT_H_INCLUDED
+/**
+ *
+ * @file Snapshot.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les instantanés de mixage et leurs transitions (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstdint>
+
+#include <mutex>
+#include <vector>
+
+#include "Bus.h"
+#include "Effects.h"
+#include "Listener.h"
+#include "Updater.h"
+
+namespace KA3D
+{
+
+//! Volume d'un bus dans un instantané
+struct SnapshotBus
+{
+	Bus* pBus; //!< Bus
+	float fGain; //!< Volume propre du bus
+};
+
+//! Emplacement d'effet libre dans un instantané
+struct SnapshotSlot
+{
+	std::uint16_t slot; //!< Numéro de l'emplacement (cf. Effects)
+	float fGain; //!< Volume de l'emplacement
+	SlotEffect effect; //!< Effet chargé (réverbération, écho)
+};
+
+/**
+ * @brief Instantané de mixage (menu pause, sous l'eau, ralenti...)
+ * Les bus et emplacements absents de l'instantané ne sont pas modifiés.
+ * Seuls les emplacements libres en font partie : ceux des zones de
+ * réverbération sont pilotés par Effects::update selon l'écouteur.
+ */
+struct MixSnapshot
+{
+	float fListenerGain; //!< Volume général (Listener::setGain)
+	float fDopplerFactor; //!< Facteur doppler (Listener::setDopplerFactor)
+	float fSpeedSound; //!< Vitesse du son (Listener::setSpeedSound)
+	std::vector<SnapshotBus> tblBuses; //!< Volumes des bus
+	std::vector<SnapshotSlot> tblSlots; //!< Emplacements d'effets libres
+};
+
+/**
+ * @brief Transitions entre instantanés de mixage
+ * #transition prépare une interpolation depuis l'état courant ; #update
+ * (à chaque pas de l'Updater, cf. Updater::add) interpole et n'envoie au
+ * pilote que les valeurs qui ont changé, en un seul lot
+ * (AL_SOFT_deferred_updates si disponible), bus compris (Bus::flush).
+ */
+class Snapshots : public UpdateTask
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param listener Écouteur (contexte actif)
+	 * @param pRoot Racine de l'arbre de bus (nullptr : aucun)
+	 * @param pEffects Effets auxiliaires (nullptr : aucun)
+	 */
+	Snapshots(Listener& listener, Bus* pRoot = nullptr,
+	          Effects* pEffects = nullptr);
+	//! Copie interdite
+	Snapshots(const Snapshots& other) = delete;
+	//! Copie interdite
+	Snapshots& operator=(const Snapshots& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	virtual ~Snapshots() noexcept;
+
+	/**
+	 * @brief Capture l'état courant (écouteur, tous les bus de l'arbre,
+	 * volume et effet des emplacements libres)
+	 */
+	MixSnapshot capture() const;
+	/**
+	 * @brief Démarre une transition vers un instantané
+	 * Remplace la transition en cours, depuis les valeurs courantes.
+	 * Les paramètres de deux réverbérations ou de deux échos sont
+	 * interpolés ; un changement de type d'effet a lieu à mi-parcours.
+	 * @param snapshot Instantané cible
+	 * @param fDuration Durée en secondes (0 : au prochain #update)
+	 */
+	void transition(const MixSnapshot& snapshot, float fDuration);
+	/**
+	 * @brief Permet de savoir si une transition est en cours
+	 */
+	bool isTransitioning() const;
+
+	/**
+	 * @brief Avance la transition et applique les valeurs modifiées
+	 * @param fDelta Temps écoulé en secondes
+	 */
+	void update(float fDelta) override;
+
+private:
+	//! Valeur interpolée
+	struct Field
+	{
+		float fFrom; //!< Valeur de départ
+		float fTo; //!< Valeur cible
+		float fApplied; //!< Dernière valeur envoyée
+	};
+	//! Bus interpolé
+	struct BusField
+	{
+		Bus* pBus; //!< Bus
+		Field value; //!< Volume
+	};
+	//! Emplacement interpolé
+	struct SlotField
+	{
+		std::uint16_t slot; //!< Emplacement
+		Field value; //!< Volume
+		SlotEffect from; //!< Effet de départ
+		SlotEffect to; //!< Effet d'arrivée
+		bool isBlending; //!< Effets différents : interpolés
+		Field blend; //!< Position entre les deux effets (0 à 1)
+	};
+
+	//! Interpole un champ, vrai si la valeur a changé depuis le dernier envoi
+	static bool step(Field& field, float t) noexcept;
+	//! Applique l'effet d'un emplacement à la position t (0 à 1)
+	void applyEffect(const SlotField& field, float t);
+
+private:
+	Listener& m_listener; //!< Écouteur
+	Bus* m_pRoot; //!< Racine de l'arbre de bus
+	Effects* m_pEffects; //!< Effets auxiliaires
+	mutable std::mutex m_mutex; //!< Protection de la transition
+	Field m_listenerGain; //!< Volume général
+	Field m_dopplerFactor; //!< Facteur doppler
+	Field m_speedSound; //!< Vitesse du son
+	std::vector<BusField> m_tblBuses; //!< Bus de la transition
+	std::vector<SlotField> m_tblSlots; //!< Emplacements de la transition
+	float m_fElapsed; //!< Temps écoulé de la transition
+	float m_fDuration; //!< Durée de la transition
+	bool m_isActive; //!< Transition en cours
+};
+
+} // namespace KA3D
+
+#endif // SNAPSHOT_H_INCLUDED
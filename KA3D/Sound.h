@@ -29,11 +29,15 @@
 
 #include <cstdint>
 
+#include <vector>
+
 #include "Source.h"
 
 namespace KA3D
 {
 
+class Bus;
+
 //! Instance sonore
 typedef uint32_t SoundInstance;
 
@@ -90,7 +94,10 @@ public:
 
 	/**
 	 * @brief Permet de définir les données audio (avant initialisation)
-	 * @param pData Données audio
+	 * Le son détient une référence sur les données jusqu'à #Quit
+	 * @param pData Données audio (nullptr : retire les données)
+	 * @param removeData true si le son s'approprie la référence de
+	 * l'appelant, false s'il ajoute la sienne (cf. Data::ref)
 	 */
 	void setData(Data* pData, bool removeData) noexcept;
 
@@ -100,6 +107,28 @@ public:
 	 */
 	void setConfig(SourceConfigure* pConfig);
 
+	/**
+	 * @brief Assigne le son à un bus de mixage
+	 * Le volume effectif du bus est appliqué à toutes les instances
+	 * @param pBus Bus (nullptr : aucun bus)
+	 */
+	void setBus(Bus* pBus);
+	/**
+	 * @brief Permet d'obtenir le bus du son (nullptr si aucun)
+	 */
+	Bus* bus() const noexcept;
+	/**
+	 * @brief Applique le volume effectif du bus à toutes les instances
+	 * (appelé par Bus::flush)
+	 * @param fBusGain Volume effectif du bus
+	 */
+	void setBusGain(float fBusGain);
+
+	/**
+	 * @brief Permet de savoir si une instance du son est en lecture
+	 */
+	bool isPlaying() const;
+
 	/**
 	 * @brief Permet de définir les données à partir d'un flux en wav
 	 * @param file Flux à lire
@@ -111,6 +140,14 @@ public:
 	 */
 	void play();
 
+	/**
+	 * @brief Permet d'obtenir la prochaine instance à jouer (sans la jouer)
+	 * L'instance est chargée si besoin et le son passe à l'instance suivante,
+	 * permet de démarrer plusieurs sons ensemble (cf. #SoundGroup)
+	 * @return Source de l'instance
+	 */
+	Source& next();
+
 	/**
 	 * @brief Initialise le son
 	 * @param forceLoad données audio
@@ -130,12 +167,13 @@ protected:
 	void loadSource(SoundInstance instance);
 
 private:
-	Source* m_tblSources; //!< Tableau des sources
+	std::vector<Source> m_tblSources; //!< Tableau (contigu) des sources
 	Data* m_pData; //!< Données audio
 	SourceConfigure* m_pConfig; //!< Configurateur de la source
+	Bus* m_pBus; //!< Bus de mixage (nullptr : aucun)
 	uint32_t m_uInstanceMax; //!< Nombre d'instance simultanée maximum
 	SoundInstance m_uCurrent; //!< Prochaine instance
-	bool m_removeData; //!< Est-ce qu'on supprimer les données audio
+	bool m_removeData; //!< Est-ce que la référence de l'appelant est reprise
 };
 
 }
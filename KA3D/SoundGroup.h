@@ -0,0 +1,136 @@
+#ifndef SOUNDGROUP_H_INCLUDED
+#define SOUNDGROUP_H_INCLUDED
+/**
+ *
+ * @file SoundGroup.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la gestion groupée de sources sonores (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+#include "Sound.h"
+#include "Source.h"
+
+namespace KA3D
+{
+
+/**
+ * @brief Groupe de voix démarrées, mises en pause ou stoppées ensemble
+ * Un seul appel au pilote (alSourcePlayv, alSourcePausev...) pour toutes
+ * les voix du groupe : elles démarrent dans la même période de mixage.
+ * Exemple : les couches mécanique, queue et basse d'une arme.
+ */
+class SoundGroup
+{
+public:
+	/**
+	 * @brief Permet de savoir si le démarrage programmé est disponible
+	 * (extension AL_SOFT_source_start_delay, cf. #playAt)
+	 */
+	static bool isScheduleSupported() noexcept;
+
+public:
+	/**
+	 * @brief Constructeur
+	 */
+	SoundGroup();
+	//! Copie interdite
+	SoundGroup(const SoundGroup& other) = delete;
+	//! Copie interdite
+	SoundGroup& operator=(const SoundGroup& other) = delete;
+	/**
+	 * @brief Destructeur
+	 */
+	~SoundGroup() noexcept;
+
+	/**
+	 * @brief Ajoute une source au groupe (elle doit être initialisée)
+	 * @param pSource Source à ajouter
+	 */
+	void add(Source* pSource);
+	/**
+	 * @brief Ajoute un son au groupe
+	 * À chaque démarrage, la prochaine instance du son est jouée
+	 * @param pSound Son à ajouter
+	 */
+	void add(Sound* pSound);
+	/**
+	 * @brief Retire toutes les sources et tous les sons du groupe
+	 */
+	void clear() noexcept;
+	/**
+	 * @brief Nombre de sources et de sons du groupe
+	 */
+	std::size_t size() const noexcept;
+
+	/**
+	 * @brief Démarre toutes les voix du groupe (alSourcePlayv)
+	 */
+	void play();
+	/**
+	 * @brief Démarre toutes les voix du groupe à un instant précis
+	 * @param deviceTime Horloge du périphérique (en nanosecondes)
+	 * à laquelle démarrer (cf. ALC_SOFT_device_clock)
+	 * @throw std::runtime_error si l'extension n'est pas disponible
+	 */
+	void playAt(std::int64_t deviceTime);
+	/**
+	 * @brief Démarre toutes les voix du groupe après un délai
+	 * @param delay Délai en nanosecondes par rapport à l'horloge actuelle
+	 * du périphérique
+	 * @throw std::runtime_error si l'extension n'est pas disponible
+	 */
+	void playIn(std::int64_t delay);
+	/**
+	 * @brief Met en pause les voix du groupe (alSourcePausev)
+	 */
+	void pause();
+	/**
+	 * @brief Stoppe les voix du groupe (alSourceStopv)
+	 */
+	void stop();
+	/**
+	 * @brief Remet au début les voix du groupe (alSourceRewindv)
+	 */
+	void rewind();
+
+private:
+	//! Choisit les instances des sons à démarrer et remplit m_tblHandles
+	void resolve();
+	//! Remplit m_tblHandles avec les voix démarrées par le groupe
+	void gather();
+
+private:
+	std::vector<Source*> m_tblSources; //!< Sources du groupe
+	std::vector<Sound*> m_tblSounds; //!< Sons du groupe
+	std::vector<Source*> m_tblInstances; //!< Dernière instance de chaque son
+	std::vector<std::uint32_t> m_tblHandles; //!< Noms OpenAL (réutilisé)
+};
+
+} // namespace KA3D
+
+#endif // SOUNDGROUP_H_INCLUDED
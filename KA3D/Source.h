@@ -29,15 +29,18 @@
 
 #include <cstdint>
 
+#include <atomic>
+#include <mutex>
+
 #include "Data.h"
 
 namespace KA3D
 {
 
-class DataPrivate;
-
 /**
  * @brief Classe représentant une source audio
+ * Objet valeur déplaçable : le nom OpenAL est stocké dans l'objet,
+ * les sources peuvent être rangées de façon contiguë (std::vector...)
  */
 class Source
 {
@@ -45,11 +48,21 @@ public:
 	/**
 	 * @brief Constructeur
 	 */
-	Source();
+	Source() noexcept;
 	//! Copie interdite
 	Source(const Source& other) noexcept = delete;
 	//! Copie interdite
 	Source& operator=(const Source& other) noexcept = delete;
+	/**
+	 * @brief Constructeur de déplacement
+	 * @param other Source déplacée (non initialisée après l'appel)
+	 */
+	Source(Source&& other) noexcept;
+	/**
+	 * @brief Affectation par déplacement (échange les deux sources)
+	 * @param other Source déplacée
+	 */
+	Source& operator=(Source&& other) noexcept;
 	/**
 	 * @brief Destructeur
 	 */
@@ -57,6 +70,7 @@ public:
 
 	/**
 	 * @brief Initialise la source audio avec des données audio
+	 * La source détient une référence sur les données jusqu'à #Quit
 	 * @param pData données audio
 	 */
 	void Init(Data* pData);
@@ -65,10 +79,18 @@ public:
 	 * @brief Permet de savoir si la source a été initialisée
 	 */
 	bool isInitialized() const noexcept;
+	/**
+	 * @brief Retourne le nom OpenAL de la source (0 si non initialisée)
+	 */
+	std::uint32_t handle() const noexcept;
+	/**
+	 * @brief Données de la source (nullptr si non initialisée)
+	 */
+	Data* data() const noexcept;
 
 	/**
 	 * @brief Permet de libérer la mémoire initialisé par #Init
-	 * @note Ne libère pas la mémoire de #AudioData en paramètre de #Init
+	 * @note Libère la référence détenue sur les #Data en paramètre de #Init
 	 */
 	void Quit();
 	/**
@@ -119,9 +141,19 @@ public:
 	 * 0	volume minimum (pas de son)
 	 * 1	volume standard
 	 * > 1	amplification (peut conduire à une saturation du son)
+	 * Le volume envoyé au pilote est multiplié par celui du bus (cf. Bus)
+	 * Peut être appelé pendant un Bus::flush d'un autre fil (ex : Updater)
 	 * @param fGain Volume de la source
 	 */
 	void setGain(float fGain);
+	/**
+	 * @brief Permet de définir le volume hérité du bus de la source
+	 * Appelé par Bus::flush : le pilote n'est appelé que si le volume
+	 * change et que la source est initialisée (sinon il est appliqué
+	 * par #Init)
+	 * @param fBusGain Volume effectif du bus
+	 */
+	void setBusGain(float fBusGain);
 	/**
 	 * @brief Définit la distance maximum d'atténuation (cf. #DistanceModel)
 	 * @param fMaxDistance distance max d'atténuation
@@ -213,9 +245,13 @@ public:
 	 */
 	float pitch() const;
 	/**
-	 * @brief Permet d'obtenir le volume de la source
+	 * @brief Permet d'obtenir le volume de la source (sans celui du bus)
 	 */
 	float gain() const;
+	/**
+	 * @brief Permet d'obtenir le volume hérité du bus de la source
+	 */
+	float busGain() const noexcept;
 	/**
 	 * @brief Permet d'obtenir la distance maximum (cf. #DistanceModel)
 	 */
@@ -265,6 +301,28 @@ public:
 	 */
 	bool isLooping() const;
 
+	/**
+	 * @brief Permet de savoir si les positions avec latence sont disponibles
+	 * (extension AL_SOFT_source_latency)
+	 */
+	static bool hasOffsetLatency() noexcept;
+	/**
+	 * @brief Permet d'obtenir la position dans l'audio et la latence
+	 * La position est celle du mixage, l'audio correspondant sera entendu
+	 * après \a latency secondes
+	 * @param[out] second Position dans l'audio (en secondes)
+	 * @param[out] latency Latence de sortie (en secondes)
+	 * @throw std::runtime_error si AL_SOFT_source_latency est absent
+	 */
+	void offsetLatency(double& second, double& latency) const;
+	/**
+	 * @brief Permet d'obtenir la position dans l'audio et l'horloge
+	 * @param[out] second Position dans l'audio (en secondes)
+	 * @param[out] clock Horloge du périphérique correspondante (en secondes)
+	 * @throw std::runtime_error si ALC_SOFT_device_clock est absent
+	 */
+	void offsetClock(double& second, double& clock) const;
+
 	/**
 	 * @brief Permet de savoir si la lecture est en cours
 	 */
@@ -284,7 +342,11 @@ public:
 
 private:
 	Data* m_pData; //!< Données de la source audio
-	DataPrivate* m_pSource; //!< Contenu privé de la source audio
+	std::uint32_t m_uHandle; //!< Nom OpenAL de la source
+	std::atomic<float> m_fGain; //!< Volume propre de la source
+	std::atomic<float> m_fBusGain; //!< Volume hérité du bus
+	//! Sérialise le calcul et l'envoi du volume (Bus::flush, rampes...)
+	std::mutex m_mutexGain;
 };
 
 } // namespace KA3D
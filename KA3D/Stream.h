@@ -0,0 +1,189 @@
+#ifndef STREAM_H_INCLUDED
+#define STREAM_H_INCLUDED
+/**
+ *
+ * @file Stream.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la lecture en flux de fichiers wave (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstdint>
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Data.h"
+#include "Updater.h"
+#include "WaveFile.h"
+
+namespace KA3D
+{
+
+/**
+ * @brief Lecture en flux d'un fichier wave (RIFF, RF64 ou Wave64)
+ * Le fichier n'est jamais chargé entièrement : une source OpenAL lit une
+ * file de quelques buffers qui sont remplis au fur et à mesure à partir
+ * du fichier (tampon de lecture réutilisé, aucune allocation par bloc).
+ * #refill doit être appelé régulièrement, directement ou par un Updater
+ * (cf. Updater::add), plus souvent que la durée de la file.
+ * Le flux et le fichier doivent rester valides jusqu'à #Quit.
+ */
+class Stream : public UpdateTask
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param bufferCount Nombre de buffers dans la file (2 minimum)
+	 * @param bufferMs Durée de chaque buffer en millisecondes
+	 */
+	explicit Stream(std::uint32_t bufferCount = 4,
+	                std::uint32_t bufferMs = 250) noexcept;
+	//! Copie interdite
+	Stream(const Stream& other) = delete;
+	//! Copie interdite
+	Stream& operator=(const Stream& other) = delete;
+	//! Destructeur
+	virtual ~Stream() noexcept;
+
+	/**
+	 * @brief Ouvre le fichier wave et remplit la file de buffers
+	 * Prend une source de la réserve du contexte courant
+	 * @param file Flux contenant le fichier audio (lu progressivement)
+	 */
+	void Init(std::iostream& file);
+	/**
+	 * @brief Ouvre le fichier wave et remplit la file de buffers
+	 * @param reader Source du fichier audio (mémoire, descripteur...),
+	 * doit rester valide jusqu'à #Quit
+	 */
+	void Init(Reader& reader);
+	/**
+	 * @brief Permet de savoir si le flux est initialisé
+	 */
+	bool isInitialized() const noexcept;
+	/**
+	 * @brief Retourne le nom OpenAL de la source (0 si non initialisée)
+	 */
+	std::uint32_t handle() const noexcept;
+	/**
+	 * @brief Arrête la lecture et libère la source et les buffers
+	 */
+	void Quit();
+
+	/**
+	 * @brief Démarre (ou reprend) la lecture
+	 * Repart du début si la fin du fichier a été jouée
+	 */
+	void play();
+	/**
+	 * @brief Met en pause la lecture
+	 */
+	void pause();
+	/**
+	 * @brief Arrête la lecture et revient au début du fichier
+	 */
+	void stop();
+	/**
+	 * @brief Permet de savoir si le flux est en lecture
+	 * (faux une fois la fin du fichier jouée, hors boucle)
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * @brief Lecture en boucle (sans coupure : la fin du fichier et le
+	 * début sont enchaînés dans le même buffer) ; si le fichier définit
+	 * une boucle (chunk smpl), le début est joué une fois puis la boucle
+	 * est répétée
+	 */
+	void setLooping(bool isLooping) noexcept;
+	/**
+	 * @brief Permet de savoir si la lecture est en boucle
+	 */
+	bool isLooping() const noexcept;
+
+	/**
+	 * @brief Permet de définir le volume de la source
+	 * @param fGain volume (1 : volume original)
+	 */
+	void setGain(float fGain);
+	/**
+	 * @brief Permet de définir la position de la source
+	 */
+	void setPosition(float xpos, float ypos, float zpos);
+	/**
+	 * @brief Définit si la position est relative à l'écouteur
+	 */
+	void setRelative(bool isRelative);
+
+	/**
+	 * @brief Recycle les buffers joués : les remplit avec la suite du
+	 * fichier et les remet dans la file ; relance la source après une
+	 * famine (file vide avant la fin du fichier)
+	 */
+	void refill();
+	/**
+	 * @brief Tâche de l'Updater : appelle #refill
+	 * @param fDelta Temps écoulé depuis le dernier pas (secondes)
+	 */
+	virtual void update(float fDelta) override;
+
+	/**
+	 * @brief Format des données audio du fichier
+	 */
+	DataFormat format() const noexcept;
+	/**
+	 * @brief Fréquence d'échantillonage du fichier
+	 */
+	std::uint32_t samplesPerSec() const noexcept;
+	/**
+	 * @brief Taille des données audio du fichier en octets
+	 */
+	std::uint64_t size() const noexcept;
+
+private:
+	void open(WaveFile* pWave);
+	bool fill(std::uint32_t uBuffer);
+	void queue(std::uint32_t uBuffer);
+	void restart();
+
+private:
+	std::uint32_t m_uBufferCount; //!< Nombre de buffers dans la file
+	std::uint32_t m_uBufferMs; //!< Durée d'un buffer en millisecondes
+	std::unique_ptr<WaveFile> m_pWave; //!< Fichier lu
+	std::uint32_t m_uHandle; //!< Nom OpenAL de la source
+	std::vector<std::uint32_t> m_tblBuffers; //!< Buffers OpenAL du flux
+	std::vector<std::uint32_t> m_tblFree; //!< Buffers hors de la file
+	std::vector<std::uint8_t> m_tblScratch; //!< Tampon de lecture réutilisé
+	std::uint32_t m_uQueued; //!< Nombre de buffers dans la file
+	bool m_isLooping; //!< Lecture en boucle
+	bool m_isPlaying; //!< Lecture demandée (relance après famine)
+	bool m_isEnded; //!< Fin du fichier atteinte (hors boucle)
+	mutable std::mutex m_mutex; //!< Protège la file (fil de l'Updater)
+};
+
+} // namespace KA3D
+
+#endif // STREAM_H_INCLUDED
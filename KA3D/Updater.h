@@ -0,0 +1,199 @@
+#ifndef UPDATER_H_INCLUDED
+#define UPDATER_H_INCLUDED
+/**
+ *
+ * @file Updater.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant le fil de mise à jour audio (rampes) (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstdint>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Source.h"
+
+namespace KA3D
+{
+
+class Bus;
+
+/**
+ * @brief Tâche exécutée à chaque pas de l'Updater (cf. Updater::add)
+ * Hériter et redéfinir #update
+ */
+class UpdateTask
+{
+public:
+	//! Destructeur
+	virtual ~UpdateTask() noexcept { }
+	/**
+	 * @brief Fonction appelée à chaque pas, depuis le fil de mise à jour
+	 * @param fDelta Temps écoulé depuis le dernier pas (secondes)
+	 */
+	virtual void update(float fDelta) = 0;
+};
+
+/**
+ * @brief Fil de mise à jour audio : rampes de paramètres des sources
+ * Un fondu (#fadeTo) ou un glissement de pitch (#pitchTo) est une seule
+ * commande : l'interpolation est faite par le fil de mise à jour à pas
+ * fixe, indépendamment de la fréquence d'images du jeu, au lieu d'un
+ * appel à Source::setGain par image.
+ * Les sources doivent rester initialisées (et à la même adresse) tant
+ * qu'une rampe est active : #cancel est obligatoire avant Source::Quit
+ * ou la destruction de la source.
+ * Chaque pas est fait sous le verrou des appels OpenAL du contexte : les
+ * erreurs du pilote ne sont pas mêlées à celles des autres fils.
+ * Le fil exécute aussi des tâches à chaque pas (#add : atténuations par
+ * déclenchement, transitions d'instantanés...) puis applique les volumes
+ * de l'arbre de bus (#setBus).
+ */
+class Updater
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param tickMs Pas de mise à jour en millisecondes
+	 */
+	explicit Updater(std::uint32_t tickMs = 10);
+	//! Copie interdite
+	Updater(const Updater& other) = delete;
+	//! Copie interdite
+	Updater& operator=(const Updater& other) = delete;
+	/**
+	 * @brief Destructeur (arrête le fil)
+	 */
+	~Updater() noexcept;
+
+	/**
+	 * @brief Démarre le fil de mise à jour
+	 * @param isThreaded Faux : pas de fil, l'utilisateur appelle #tick
+	 */
+	void Init(bool isThreaded = true);
+	/**
+	 * @brief Arrête le fil de mise à jour et abandonne les rampes
+	 */
+	void Quit();
+
+	/**
+	 * @brief Pas de mise à jour en millisecondes
+	 */
+	std::uint32_t tickMs() const noexcept;
+
+	/**
+	 * @brief Fondu du volume d'une source
+	 * Remplace une rampe de volume en cours (depuis sa valeur actuelle)
+	 * @param source Source initialisée
+	 * @param fGain Volume final
+	 * @param durationMs Durée en millisecondes (0 : immédiat)
+	 */
+	void fadeTo(Source& source, float fGain, std::uint32_t durationMs);
+	/**
+	 * @brief Glissement du pitch d'une source
+	 * Remplace une rampe de pitch en cours (depuis sa valeur actuelle)
+	 * @param source Source initialisée
+	 * @param fPitch Facteur de pitch final
+	 * @param durationMs Durée en millisecondes (0 : immédiat)
+	 */
+	void pitchTo(Source& source, float fPitch, std::uint32_t durationMs);
+	/**
+	 * @brief Abandonne les rampes d'une source (obligatoire avant
+	 * Source::Quit ou la destruction de la source)
+	 * Les paramètres gardent leur valeur courante
+	 * @param source Source
+	 */
+	void cancel(const Source& source) noexcept;
+	/**
+	 * @brief Exécute une tâche à chaque pas (ex : Ducker, Snapshots)
+	 * @param task Tâche (doit rester valide jusqu'à #remove)
+	 */
+	void add(UpdateTask& task);
+	/**
+	 * @brief Retire une tâche
+	 * @param task Tâche
+	 */
+	void remove(UpdateTask& task) noexcept;
+	/**
+	 * @brief Applique les volumes de l'arbre de bus à chaque pas
+	 * @param pRoot Racine de l'arbre (nullptr : aucun)
+	 */
+	void setBus(Bus* pRoot) noexcept;
+
+	/**
+	 * @brief Nombre de rampes actives
+	 */
+	std::size_t activeRamps() const;
+
+	/**
+	 * @brief Avance les rampes (appelé par le fil de mise à jour)
+	 * @param fDelta Temps écoulé depuis le dernier pas (secondes)
+	 */
+	void tick(float fDelta);
+
+private:
+	//! Paramètre interpolé
+	enum RampTarget {
+		RT_GAIN, //!< Volume (Source::setGain)
+		RT_PITCH //!< Pitch (Source::setPitch)
+	};
+
+	//! Rampe d'un paramètre d'une source
+	struct Ramp
+	{
+		Source* pSource; //!< Source
+		RampTarget target; //!< Paramètre
+		float fFrom; //!< Valeur de départ
+		float fTo; //!< Valeur finale
+		float fElapsed; //!< Temps écoulé (secondes)
+		float fDuration; //!< Durée (secondes)
+	};
+
+	//! Ajoute ou remplace une rampe
+	void start(Source& source, RampTarget target, float fTo,
+	           std::uint32_t durationMs);
+	//! Avance les rampes (verrou détenu)
+	void advance(float fDelta);
+	//! Il y a du travail à chaque pas (verrou détenu)
+	bool isBusy() const noexcept;
+	//! Boucle du fil de mise à jour
+	void threadLoop();
+
+private:
+	std::uint32_t m_uTickMs; //!< Pas de mise à jour
+	std::vector<Ramp> m_tblRamps; //!< Rampes actives
+	std::vector<UpdateTask*> m_tblTasks; //!< Tâches exécutées à chaque pas
+	Bus* m_pBus; //!< Racine de l'arbre de bus (nullptr : aucun)
+	mutable std::mutex m_mutex; //!< Protection des rampes
+	std::condition_variable m_cvWake; //!< Signal de rampe ou d'arrêt
+	std::thread m_thread; //!< Fil de mise à jour
+	bool m_isStopping; //!< Arrêt du fil demandé
+};
+
+} // namespace KA3D
+
+#endif // UPDATER_H_INCLUDED
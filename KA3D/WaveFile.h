@@ -29,8 +29,11 @@
 
 #include <cstdint>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include "Data.h"
+#include "Reader.h"
 
 #ifndef __GNUC__
 #ifndef __clang__
@@ -41,18 +44,60 @@
 namespace KA3D
 {
 
+//! Conteneurs de fichiers wave
+enum WaveContainer {
+	WC_RIFF, //!< RIFF/WAVE (tailles 32 bits, fichiers jusqu'à 4 Go)
+	WC_RF64, //!< RF64 (EBU Tech 3306, tailles 64 bits dans le chunk ds64)
+	WC_WAVE64 //!< Sony Wave64 (chunks identifiés par GUID, tailles 64 bits)
+};
+
 /**
- * Classe de gestion des fichiers .wav (RIFF/WAVE)
+ * Entrée du répertoire des chunks d'un fichier wave (cf. WaveFile::chunks)
+ */
+struct WaveChunk
+{
+	char tag[4]; //!< Identifiant (Wave64 : début du GUID, zéros si inconnu)
+	std::uint64_t offset; //!< Position des données depuis le début du wave
+	std::uint64_t size; //!< Taille des données (sans en-tête ni alignement)
+};
+
+/**
+ * Classe de gestion des fichiers .wav (RIFF/WAVE, RF64 et Wave64)
+ * Le conteneur est détecté à la lecture ; à l'écriture, un fichier RIFF
+ * trop grand pour des tailles 32 bits est écrit en RF64.
+ * Formats lus : PCM 8, 16 et 24 bits, flottants 32 bits (IEEE_FLOAT),
+ * y compris en WAVE_FORMAT_EXTENSIBLE ; mono, stéréo, quad, 5.1, 6.1 et
+ * 7.1 (disposition des canaux vérifiée, cf. #channelMask). Le 24 bits est converti à la
+ * lecture en flottants (#format, #size, #seek et #read en octets de
+ * flottants).
+ * À la lecture, le début du fichier est lu en une fois (#PREFIX_SIZE) et
+ * tous les chunks sont indexés à l'ouverture (cf. #chunks). La première
+ * boucle (avant) du chunk smpl est lue (cf. #hasLoop), ainsi que les
+ * marqueurs du chunk cue et leurs noms (liste adtl, cf. #markers).
+ * La lecture passe par un #Reader (mémoire, descripteur, projection...) ;
+ * un std::iostream est lu au travers d'un #StreamReader.
  */
 class WaveFile
 {
 public:
+	//! Taille inconnue (cf. #setSize) : écriture en flux, les tailles
+	//! des en-têtes sont écrites à la fermeture (flux positionnable)
+	static constexpr std::uint64_t SIZE_UNKNOWN = UINT64_MAX;
+	//! Taille du début de fichier lu en une fois à l'ouverture en lecture
+	//! (en-têtes et chunks de métadonnées, puis premières données audio)
+	static constexpr std::uint64_t PREFIX_SIZE = 16 * 1024;
 	/**
 	 * Permet de lire/écrire dans un fichier en wave
 	 * @param pFile fichier à ouvrir (peut être une portion de fichier)
 	 * @param isClose Est-ce qu'on ferme le fichier à la fin (lors de close)
 	 */
 	WaveFile(std::iostream& refFile) noexcept;
+	/**
+	 * Permet de lire un fichier wave depuis une source sans flux
+	 * (mémoire, descripteur, projection : cf. #Reader), en lecture seule
+	 * @param refReader Source du fichier (doit rester valide)
+	 */
+	WaveFile(Reader& refReader) noexcept;
 
 	//! Copie interdite
 	WaveFile(const WaveFile& other) noexcept = delete;
@@ -68,7 +113,10 @@ public:
 	 * infos accessible dans les attributs (format, samplesPerSec et size)
 	 *  - En écriture : écrit les en-têtes dans le fichiers wave
 	 * les informations des en-têtes doivent avoir été renseigné avant
-	 * dans les attributs (format, samplesPerSec et size)
+	 * dans les attributs (format, samplesPerSec et size) ; avec une taille
+	 * #SIZE_UNKNOWN, des en-têtes provisoires sont écrits puis corrigés
+	 * par #close (un fichier RIFF réserve la place d'un chunk ds64 pour
+	 * passer en RF64 s'il dépasse 4 Go)
 	 */
 	virtual void open(std::ios_base::openmode mode);
 	/**
@@ -93,7 +141,8 @@ public:
 	/**
 	 * @brief Permet d'écrire les données audio du wave
 	 * Le total des données ajouté dans le fichier ne doit pas dépasser
-	 * la taille spécifié au début pour les en-tête (voir #size)
+	 * la taille spécifié au début pour les en-tête (voir #size),
+	 * sauf si elle est inconnue (#SIZE_UNKNOWN)
 	 * @param data Données audio à écrire (voir #format pour le format)
 	 * @param size Taille des données à écrire
 	 */
@@ -104,6 +153,8 @@ public:
 	 * Si le flux de fichier doit être fermé, il sera fermé,
 	 * sinon, le curseur est placé à la fin de ce fichier wave
 	 * (permettant ainsi de lire d'autres données située après)
+	 * En écriture, complète l'alignement du chunk de données et, en flux
+	 * (#SIZE_UNKNOWN), réécrit les en-têtes avec les tailles définitives
 	 */
 	virtual void close();
 
@@ -115,7 +166,10 @@ public:
 	void setFormat(DataFormat format) noexcept;
 	//! Permet de définir la taille des données audio en octets
 	//! (à définir en mode écriteur et avant ouverture du fichier)
-	void setSize(std::uint32_t dwSize) noexcept;
+	void setSize(std::uint64_t uSize) noexcept;
+	//! Permet de définir le conteneur du fichier (WC_RIFF par défaut)
+	//! (à définir en mode écriteur et avant ouverture du fichier)
+	void setContainer(WaveContainer container) noexcept;
 	//! Permet d'obtenir la fréquence d'échantillonage
 	//! (disponible après ouverture en mode lecture)
 	std::uint32_t samplesPerSec() const noexcept;
@@ -123,46 +177,112 @@ public:
 	//! (disponible après ouverture en mode lecture)
 	DataFormat format() const noexcept;
 	//! Permet d'obtenir la taille (en octets) données audio
+	//! (disponible après ouverture en mode lecture ; en écriture en flux,
+	//! taille déjà écrite)
+	std::uint64_t size() const noexcept;
+	//! Permet d'obtenir le conteneur du fichier
+	//! (disponible après ouverture)
+	WaveContainer container() const noexcept;
+	//! Permet d'obtenir la disposition des canaux (masque SPEAKER_* de
+	//! WAVE_FORMAT_EXTENSIBLE, ex : 0x3F pour le 5.1)
+	//! (disponible après ouverture)
+	std::uint32_t channelMask() const noexcept;
+	//! Permet de savoir si le fichier définit une boucle (chunk smpl)
+	//! (disponible après ouverture en mode lecture)
+	bool hasLoop() const noexcept;
+	//! Permet d'obtenir le début de la boucle (en échantillons par canal)
+	std::uint32_t loopStart() const noexcept;
+	//! Permet d'obtenir la fin de la boucle (en échantillons par canal,
+	//! exclue : le smpl donne le dernier échantillon joué)
+	std::uint32_t loopEnd() const noexcept;
+	//! Permet d'obtenir les marqueurs (chunk cue), triés par position
 	//! (disponible après ouverture en mode lecture)
-	std::uint32_t size() const noexcept;
+	const std::vector<Marker>& markers() const noexcept;
+
+	//! Permet d'obtenir le répertoire des chunks, dans l'ordre du fichier
+	//! (disponible après ouverture en mode lecture)
+	const std::vector<WaveChunk>& chunks() const noexcept;
+	/**
+	 * @brief Permet de chercher un chunk dans le répertoire
+	 * @param tag Identifiant du chunk (4 caractères, ex : "smpl", "cue ")
+	 * @return Le premier chunk de ce type, nullptr s'il est absent
+	 */
+	const WaveChunk* findChunk(const char* tag) const noexcept
+		__attribute__((nonnull));
+	/**
+	 * @brief Permet de lire le contenu d'un chunk (mode lecture)
+	 * La position dans les données audio n'est pas modifiée
+	 * @param chunk Chunk à lire (cf. #chunks)
+	 * @param[out] tblData Contenu du chunk
+	 */
+	void chunkData(const WaveChunk& chunk, std::vector<std::uint8_t>& tblData);
 
 private:
+	explicit WaveFile(Reader* pReader) noexcept;
+
 	void rawRead(void* data, std::uint64_t size, std::uint64_t n = 1);
 	void rawWrite(const void* data, std::uint64_t size, std::uint64_t n = 1);
 
 
 	void readHeaders();
-
-	void skipRead(std::uint32_t size);
-	void skipWord();
+	void indexChunks(std::uint64_t pos);
+	void readLoop(std::uint64_t frames);
+	void readMarkers(std::uint64_t frames);
+	void readLabels();
 
 	void readWord(std::uint16_t& word);
 	void readDWord(std::uint32_t& dword);
+	void readQWord(std::uint64_t& qword);
 
 	void readChunk(std::uint8_t* chunk);
 	void checkChunk(const std::uint8_t* chunk);
+	bool isChunk(const std::uint8_t* chunk, const std::uint8_t* value) const
+		noexcept;
 
-	void nextChunk(std::uint8_t* chunk, std::uint32_t& cksz);
-	void checkNextChunk(const std::uint8_t* chunk, std::uint32_t& cksz);
-	void findNextChunk(const std::uint8_t* chunk, std::uint32_t& cksz);
+	void nextChunk(std::uint8_t* chunk, std::uint64_t& cksz);
+	void checkNextChunk(const std::uint8_t* chunk, std::uint64_t& cksz);
+	const WaveChunk& requireChunk(const char* tag) const;
+	std::uint64_t paddedSize(std::uint64_t cksz) const noexcept;
+	std::uint64_t formatBytes(std::uint64_t fileBytes) const noexcept;
+	std::uint64_t readS24(float* data, std::uint64_t count);
 
 
 	void writeHeaders();
 
 	void writeWord(std::uint16_t word);
 	void writeDWord(std::uint32_t dword);
+	void writeQWord(std::uint64_t qword);
+
+	void writePadding(std::uint64_t size);
 
 	void writeChunk(const std::uint8_t* chunk);
-	void writeChunk(const std::uint8_t* chunk, std::uint32_t cksz);
+	void writeChunk(const std::uint8_t* chunk, std::uint64_t cksz);
 
 private:
-	std::iostream& m_refFile; //!< Flux du wave
-	std::uint32_t m_uFileSize; //!< Taille du flux RIFF/WAVE
-	std::uint32_t m_uFileRemaining; //!< Nombre d'octets restant (à lire/écrire)
+	std::iostream* m_pFile; //!< Flux du wave (nullptr : lecture seule)
+	Reader* m_pReader; //!< Source lue (lecture)
+	std::unique_ptr<StreamReader> m_pStreamReader; //!< Lecture du flux
+	WaveContainer m_container; //!< Conteneur du fichier
+	std::uint64_t m_uFileSize; //!< Taille du flux RIFF/WAVE
+	std::uint64_t m_uFileRemaining; //!< Nombre d'octets restant à écrire
+	std::uint64_t m_uDataSize64; //!< Taille des données du chunk ds64 (RF64)
 	std::uint32_t m_uSamplesPerSec; //!< Fréquence d'échantillonage de l'audio
 	DataFormat m_format; //!< Format des données audio
-	std::uint32_t m_uSize; //!< Taille (en octets) des données audio
-	std::uint32_t m_uRemaining; //!< Nombre d'octets restant (à lire ou écrire)
+	std::uint64_t m_uSize; //!< Taille (en octets) des données audio
+	std::uint64_t m_uRemaining; //!< Nombre d'octets restant (à lire ou écrire)
+	std::uint16_t m_uFileBytes; //!< Octets par échantillon dans le fichier
+	std::uint32_t m_uChannelMask; //!< Disposition des canaux
+	std::ios_base::openmode m_mode; //!< Mode d'ouverture (lecture/écriture)
+	bool m_isStreaming; //!< Écriture en flux (taille inconnue à l'ouverture)
+	std::iostream::pos_type m_headerPos; //!< Position des en-têtes (flux)
+	std::vector<std::uint8_t> m_tblScratch; //!< Tampon de conversion
+	std::vector<std::uint8_t> m_tblPrefix; //!< Début du fichier (lecture)
+	std::uint64_t m_uPos; //!< Position de lecture depuis le début du wave
+	std::uint64_t m_uWaveEnd; //!< Fin du wave depuis son début (lecture)
+	std::vector<WaveChunk> m_tblChunks; //!< Répertoire des chunks
+	std::uint32_t m_uLoopStart; //!< Début de la boucle (échantillons)
+	std::uint32_t m_uLoopEnd; //!< Fin de la boucle (0 : aucune boucle)
+	std::vector<Marker> m_tblMarkers; //!< Marqueurs (triés par position)
 };
 
 } // namespace KA3D
@@ -0,0 +1,133 @@
+#ifndef WAVEWRITER_H_INCLUDED
+#define WAVEWRITER_H_INCLUDED
+/**
+ *
+ * @file WaveWriter.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'écriture de fichiers wave en arrière-plan (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Data.h"
+#include "WaveFile.h"
+
+namespace KA3D
+{
+
+/**
+ * @brief Écriture d'un fichier wave par un fil en arrière-plan
+ * Les données (capture, rendu hors ligne...) sont copiées dans un bloc ;
+ * chaque bloc plein est confié au fil d'écriture, qui l'écrit dans le
+ * fichier (taille inconnue à l'ouverture, cf. WaveFile::SIZE_UNKNOWN)
+ * puis le rend pour être réutilisé. L'appelant n'attend jamais le disque :
+ * si tous les blocs sont en attente d'écriture, un nouveau bloc est alloué.
+ * Une erreur d'écriture est relancée par l'appel suivant (#write, #flush
+ * ou #Quit).
+ */
+class WaveWriter
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param blockSize Taille d'un bloc confié au fil d'écriture (octets)
+	 */
+	explicit WaveWriter(std::size_t blockSize = 1024 * 1024);
+	//! Copie interdite
+	WaveWriter(const WaveWriter& other) = delete;
+	//! Copie interdite
+	WaveWriter& operator=(const WaveWriter& other) = delete;
+	/**
+	 * @brief Destructeur (termine l'écriture, les erreurs sont ignorées)
+	 */
+	~WaveWriter() noexcept;
+
+	/**
+	 * @brief Écrit les en-têtes provisoires et démarre le fil d'écriture
+	 * @param file Flux de sortie positionnable (valide jusqu'à #Quit)
+	 * @param format Format des données audio (cf. #DataFormat)
+	 * @param samplesPerSec Fréquence d'échantillonage
+	 * @param container Conteneur du fichier (cf. #WaveContainer)
+	 */
+	void Init(std::iostream& file, DataFormat format,
+	          std::uint32_t samplesPerSec, WaveContainer container = WC_RIFF);
+	/**
+	 * @brief Termine l'écriture : écrit les blocs en attente, corrige les
+	 * en-têtes (cf. WaveFile::close) et arrête le fil
+	 */
+	void Quit();
+
+	/**
+	 * @brief Ajoute des données audio (au format donné à #Init)
+	 * @param data Données à écrire (copiées)
+	 * @param size Taille des données en octets
+	 */
+	void write(const void* data, std::uint64_t size) __attribute__((nonnull));
+	/**
+	 * @brief Confie le bloc en cours au fil et attend que tout soit écrit
+	 */
+	void flush();
+
+	/**
+	 * @brief Nombre d'octets audio reçus par #write
+	 */
+	std::uint64_t size() const noexcept;
+	/**
+	 * @brief Nombre de blocs en attente d'écriture
+	 */
+	std::size_t pending() const;
+
+private:
+	void submit(std::unique_lock<std::mutex>& lock);
+	void rethrow();
+	void threadLoop();
+
+private:
+	std::size_t m_uBlockSize; //!< Taille d'un bloc
+	std::unique_ptr<WaveFile> m_pWave; //!< Fichier écrit (par le fil)
+	std::vector<std::uint8_t> m_tblCurrent; //!< Bloc rempli par l'appelant
+	std::deque<std::vector<std::uint8_t>> m_tblQueue; //!< Blocs à écrire
+	std::vector<std::vector<std::uint8_t>> m_tblFree; //!< Blocs réutilisables
+	std::uint64_t m_uSize; //!< Octets reçus
+	bool m_isWriting; //!< Le fil écrit un bloc
+	bool m_isStopping; //!< Demande d'arrêt du fil
+	std::exception_ptr m_pError; //!< Erreur d'écriture du fil
+	mutable std::mutex m_mutex; //!< Protège la file de blocs
+	std::condition_variable m_cvWork; //!< Réveil du fil
+	std::condition_variable m_cvIdle; //!< Fin d'écriture (cf. #flush)
+	std::thread m_thread; //!< Fil d'écriture
+};
+
+} // namespace KA3D
+
+#endif // WAVEWRITER_H_INCLUDED
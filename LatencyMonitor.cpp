@@ -0,0 +1,195 @@
+/**
+ *
+ * @file LatencyMonitor.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la mesure de latence de lecture (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/LatencyMonitor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "Context.h"
+#include "Extensions.h"
+
+namespace KA3D
+{
+
+const double NANOSECOND = 1e-9;
+
+LatencyMonitor::LatencyMonitor(std::size_t window, double bucketWidth,
+                               std::size_t bucketCount):
+	m_tblPending(),
+	m_tblSamples(),
+	m_uWindow(window),
+	m_uNext(0),
+	m_fBucketWidth(bucketWidth),
+	m_uBucketCount(bucketCount)
+{
+	assert(window > 0 && bucketWidth > 0. && bucketCount > 0);
+	m_tblSamples.reserve(window);
+}
+
+LatencyMonitor::~LatencyMonitor() noexcept
+{ }
+
+bool LatencyMonitor::isSupported() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().alcGetInteger64vSOFT &&
+	       pContext->extensions().alGetSourcedvSOFT;
+}
+
+void LatencyMonitor::play(Source& source)
+{
+	Context* pContext(Context::current());
+	if(!pContext)
+		throw std::runtime_error("No current audio context");
+
+	Pending entry;
+	entry.pSource = &source;
+	entry.pitch = source.pitch();
+	entry.clock = pContext->deviceClock();
+	source.play();
+	m_tblPending.push_back(entry);
+}
+
+void LatencyMonitor::update()
+{
+	Context* pContext(Context::current());
+	if(!pContext || m_tblPending.empty())
+		return;
+
+	std::int64_t clock, latency;
+	pContext->deviceClockLatency(clock, latency);
+
+	auto it(m_tblPending.begin());
+	while(it != m_tblPending.end())
+	{
+		double second, sourceClock;
+		it->pSource->offsetClock(second, sourceClock);
+
+		if(second > 0.)
+		{
+			// Début de lecture sur l'horloge, puis sortie après la latence
+			double start(sourceClock - second/it->pitch);
+			double audible(start + latency*NANOSECOND);
+			addSample(std::max(0., audible - it->clock*NANOSECOND));
+			it = m_tblPending.erase(it);
+		}
+		else if(it->pSource->isStopped())
+		{
+			it = m_tblPending.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void LatencyMonitor::reset() noexcept
+{
+	m_tblPending.clear();
+	m_tblSamples.clear();
+	m_uNext = 0;
+}
+
+void LatencyMonitor::addSample(double latency)
+{
+	if(m_tblSamples.size() < m_uWindow)
+		m_tblSamples.push_back(latency);
+	else
+		m_tblSamples[m_uNext] = latency;
+	m_uNext = (m_uNext + 1) % m_uWindow;
+}
+
+std::size_t LatencyMonitor::count() const noexcept
+{
+	return m_tblSamples.size();
+}
+
+std::size_t LatencyMonitor::pending() const noexcept
+{
+	return m_tblPending.size();
+}
+
+double LatencyMonitor::min() const noexcept
+{
+	if(m_tblSamples.empty())
+		return 0.;
+	return *std::min_element(m_tblSamples.begin(), m_tblSamples.end());
+}
+
+double LatencyMonitor::max() const noexcept
+{
+	if(m_tblSamples.empty())
+		return 0.;
+	return *std::max_element(m_tblSamples.begin(), m_tblSamples.end());
+}
+
+double LatencyMonitor::mean() const noexcept
+{
+	if(m_tblSamples.empty())
+		return 0.;
+	return std::accumulate(m_tblSamples.begin(), m_tblSamples.end(), 0.) /
+	       static_cast<double>(m_tblSamples.size());
+}
+
+double LatencyMonitor::percentile(double fraction) const
+{
+	if(m_tblSamples.empty())
+		return 0.;
+
+	std::vector<double> tblSorted(m_tblSamples);
+	fraction = std::min(std::max(fraction, 0.), 1.);
+	std::size_t rank(static_cast<std::size_t>(
+		fraction * static_cast<double>(tblSorted.size() - 1) + .5));
+	std::nth_element(tblSorted.begin(), tblSorted.begin() + rank,
+	                 tblSorted.end());
+	return tblSorted[rank];
+}
+
+std::vector<std::uint32_t> LatencyMonitor::histogram() const
+{
+	std::vector<std::uint32_t> tblBuckets(m_uBucketCount, 0);
+	for(double latency : m_tblSamples)
+	{
+		std::size_t bucket(static_cast<std::size_t>(latency/m_fBucketWidth));
+		++tblBuckets[std::min(bucket, m_uBucketCount-1)];
+	}
+	return tblBuckets;
+}
+
+double LatencyMonitor::bucketWidth() const noexcept
+{
+	return m_fBucketWidth;
+}
+
+} // namespace KA3D
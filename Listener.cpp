@@ -27,6 +27,8 @@
 
 #include "KA3D/Listener.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <list>
 #include <sstream>
@@ -38,6 +40,9 @@
 
 #include "Context.h"
 #include "Error.h"
+#include "Extensions.h"
+#include "ProfilerPrivate.h"
+#include "KA3D/Data.h"
 
 namespace KA3D
 {
@@ -63,16 +68,22 @@ ALint tblContextAttributes[] = {
 	ALC_REFRESH,
 	ALC_SYNC,
 	ALC_MONO_SOURCES,
-	ALC_STEREO_SOURCES
+	ALC_STEREO_SOURCES,
+	ALC_MAX_AUXILIARY_SENDS
 };
 
-const int CONTEXT_ATTRIBUTES_COUNT = 5;
+const int CONTEXT_ATTRIBUTES_COUNT = 6;
+
+//! Taille des réserves de sources/buffers sans indication
+const int DEFAULT_POOL_SIZE = 16;
 
 Listener* Listener::pCurrent(nullptr);
 
 Listener::Listener(const char* deviceName):
 	m_pData(new Context(deviceName)),
-	m_tblAttrib(nullptr)
+	m_tblAttrib(nullptr),
+	m_iSourcePool(0),
+	m_iBufferPool(0)
 { }
 
 Listener::~Listener() noexcept
@@ -88,8 +99,21 @@ Listener::~Listener() noexcept
 
 void Listener::Init()
 {
+	KA3D_PROFILE_SCOPE("Listener::Init");
 	try
 	{
+		// Taille des réserves : indications du nombre de sources si présentes
+		int iSources(0);
+		if(m_tblAttrib && m_tblAttrib[3])
+			iSources += *m_tblAttrib[3];
+		if(m_tblAttrib && m_tblAttrib[4])
+			iSources += *m_tblAttrib[4];
+		if(iSources <= 0)
+			iSources = DEFAULT_POOL_SIZE;
+		if(m_iSourcePool > 0)
+			iSources = m_iSourcePool;
+		int iBuffers(m_iBufferPool > 0 ? m_iBufferPool : DEFAULT_POOL_SIZE);
+
 		if(m_tblAttrib)
 		{
 			// Comptage des attributs
@@ -98,8 +122,8 @@ void Listener::Init()
 				if(m_tblAttrib[i])
 					++nbAttr;
 
-			// Allocation de la nouvelle structure (clé+valeur)
-			int* attrib = new int[2*nbAttr];
+			// Allocation de la nouvelle structure (clé+valeur+terminateur)
+			int* attrib = new int[2*nbAttr+1];
 
 			// Copie dans la nouvelle structure
 			int num(0);
@@ -111,6 +135,7 @@ void Listener::Init()
 					attrib[num++] = *m_tblAttrib[i];
 				}
 			}
+			attrib[num] = 0;
 
 			m_pData->Init(attrib);
 
@@ -119,6 +144,7 @@ void Listener::Init()
 			for(int i=0; i<CONTEXT_ATTRIBUTES_COUNT; ++i)
 				delete m_tblAttrib[i];
 			delete[] m_tblAttrib;
+			m_tblAttrib = nullptr;
 		}
 		else
 		{
@@ -126,6 +152,10 @@ void Listener::Init()
 		}
 		m_pData->makeCurrent();
 		pCurrent = this;
+
+		// Pré-allocation par lot des sources et buffers
+		m_pData->reserve(static_cast<std::size_t>(iSources),
+		                 static_cast<std::size_t>(iBuffers));
 	}
 	catch(std::exception& e)
 	{
@@ -140,7 +170,13 @@ void Listener::Quit()
 	try
 	{
 		if(this == pCurrent)
+		{
+			// Derniers buffers en attente de suppression
+			Data::collect();
+			m_pData->sources().clear();
+			m_pData->buffers().clear();
 			m_pData->clearCurrent();
+		}
 		m_pData->Quit();
 	}
 	catch(std::exception& e)
@@ -177,10 +213,33 @@ std::string Listener::device() const
 	return std::string(alcGetString(m_pData->device(), ALC_DEVICE_SPECIFIER));
 }
 
+bool Listener::hasDeviceClock() const noexcept
+{
+	return m_pData->extensions().alcGetInteger64vSOFT;
+}
+
+std::int64_t Listener::deviceClock() const
+{
+	return m_pData->deviceClock();
+}
+
+std::int64_t Listener::deviceLatency() const
+{
+	std::int64_t clock, latency;
+	m_pData->deviceClockLatency(clock, latency);
+	return latency;
+}
+
+void Listener::deviceClockLatency(std::int64_t& clock,
+                                  std::int64_t& latency) const
+{
+	m_pData->deviceClockLatency(clock, latency);
+}
+
 void Listener::setFrequency(int iFrequency)
 {
 	if(!m_tblAttrib)
-		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT];
+		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT]();
 	if(!m_tblAttrib[0])
 		m_tblAttrib[0] = new int(iFrequency);
 	else
@@ -190,7 +249,7 @@ void Listener::setFrequency(int iFrequency)
 void Listener::setRefresh(int iRefresh)
 {
 	if(!m_tblAttrib)
-		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT];
+		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT]();
 	if(!m_tblAttrib[1])
 		m_tblAttrib[1] = new int(iRefresh);
 	else
@@ -200,7 +259,7 @@ void Listener::setRefresh(int iRefresh)
 void Listener::setSync(bool isSync)
 {
 	if(!m_tblAttrib)
-		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT];
+		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT]();
 	if(!m_tblAttrib[2])
 		m_tblAttrib[2] = new int(isSync ? AL_TRUE : AL_FALSE);
 	else
@@ -210,7 +269,7 @@ void Listener::setSync(bool isSync)
 void Listener::setMonoSource(int iMonoSource)
 {
 	if(!m_tblAttrib)
-		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT];
+		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT]();
 	if(!m_tblAttrib[3])
 		m_tblAttrib[3] = new int(iMonoSource);
 	else
@@ -220,13 +279,33 @@ void Listener::setMonoSource(int iMonoSource)
 void Listener::setStereoSource(int iStereoSource)
 {
 	if(!m_tblAttrib)
-		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT];
+		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT]();
 	if(!m_tblAttrib[4])
 		m_tblAttrib[4] = new int(iStereoSource);
 	else
 		*m_tblAttrib[4] = iStereoSource;
 }
 
+void Listener::setAuxiliarySends(int iSends)
+{
+	if(!m_tblAttrib)
+		m_tblAttrib = new int*[CONTEXT_ATTRIBUTES_COUNT]();
+	if(!m_tblAttrib[5])
+		m_tblAttrib[5] = new int(iSends);
+	else
+		*m_tblAttrib[5] = iSends;
+}
+
+void Listener::setSourcePool(int iSources)
+{
+	m_iSourcePool = iSources;
+}
+
+void Listener::setBufferPool(int iBuffers)
+{
+	m_iBufferPool = iBuffers;
+}
+
 void Listener::makeCurrent(bool enable)
 {
 	if(enable)
@@ -263,18 +342,24 @@ Listener* Listener::current() noexcept
 
 void Listener::setGain(float gain)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	alListenerf(AL_GAIN, gain);
 	checkALError();
 }
 
 void Listener::setPosition(float xpos, float ypos, float zpos)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	alListener3f(AL_POSITION, xpos, ypos, zpos);
 	checkALError();
 }
 
 void Listener::setVelocity(float xvel, float yvel, float zvel)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	alListener3f(AL_VELOCITY, xvel, yvel, zvel);
 	checkALError();
 }
@@ -282,6 +367,8 @@ void Listener::setVelocity(float xvel, float yvel, float zvel)
 void Listener::setOrientation(float xat, float yat, float zat,
 	                               float xup, float yup, float zup)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	ALfloat orientation[] = {xat, yat, zat, xup, yup, zup};
 	alListenerfv(AL_ORIENTATION, orientation);
 	checkALError();
@@ -289,24 +376,32 @@ void Listener::setOrientation(float xat, float yat, float zat,
 
 void Listener::setDopplerFactor(float factor)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	alDopplerFactor(factor);
 	checkALError();
 }
 
 void Listener::setSpeedSound(float fSpeedSound)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	alSpeedOfSound(fSpeedSound);
 	checkALError();
 }
 
 void Listener::setDistanceModel(DistanceModel model)
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_SET);
+	ContextLock contextLock;
 	alDistanceModel(tblDistanceModel[model].alValue);
 	checkALError();
 }
 
 float Listener::gain() const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	float val;
 	alGetListenerf(AL_GAIN, &val);
 	checkALError();
@@ -315,12 +410,16 @@ float Listener::gain() const
 
 void Listener::position(float& xpos, float& ypos, float& zpos) const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	alGetListener3f(AL_POSITION, &xpos, &ypos, &zpos);
 	checkALError();
 }
 
 void Listener::velocity(float& xvel, float& yvel, float& zvel) const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	alGetListener3f(AL_VELOCITY, &xvel, &yvel, &zvel);
 	checkALError();
 }
@@ -328,6 +427,8 @@ void Listener::velocity(float& xvel, float& yvel, float& zvel) const
 void Listener::orientation(float& xat, float& yat, float& zat,
                                 float& xup, float& yup, float& zup) const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	float vals[6];
 	alGetListenerfv(AL_ORIENTATION, vals);
 	checkALError();
@@ -341,6 +442,8 @@ void Listener::orientation(float& xat, float& yat, float& zat,
 
 float Listener::dopplerFactor() const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	float val = alGetFloat(AL_DOPPLER_FACTOR);
 	checkALError();
 	return val;
@@ -348,6 +451,8 @@ float Listener::dopplerFactor() const
 
 float Listener::speedSound() const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	float val = alGetFloat(AL_SPEED_OF_SOUND);
 	checkALError();
 	return val;
@@ -355,6 +460,8 @@ float Listener::speedSound() const
 
 DistanceModel Listener::distanceModel() const
 {
+	KA3D_PROFILE_COUNT(PC_LISTENER_GET);
+	ContextLock contextLock;
 	ALenum model = alGetInteger(AL_DISTANCE_MODEL);
 	checkALError();
 	switch(model)
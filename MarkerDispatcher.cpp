@@ -0,0 +1,273 @@
+/**
+ *
+ * @file MarkerDispatcher.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la livraison des marqueurs de lecture (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/MarkerDispatcher.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "Context.h"
+#include "Extensions.h"
+
+namespace KA3D
+{
+
+const double NANOSECONDS_PER_SECOND = 1e9;
+
+// Premier marqueur à partir d'une position
+static std::size_t firstMarker(const std::vector<Marker>& tblMarkers,
+                               double position) noexcept
+{
+	return std::lower_bound(tblMarkers.begin(), tblMarkers.end(), position,
+	                        [](const Marker& marker, double value)
+	                        { return marker.position < value; })
+	       - tblMarkers.begin();
+}
+
+MarkerDispatcher::MarkerDispatcher(std::uint32_t resyncMs):
+	m_resyncNs(static_cast<std::int64_t>(resyncMs) * 1000000),
+	m_tblWatches(),
+	m_tblEvents(),
+	m_callback(nullptr),
+	m_pUserData(nullptr),
+	m_mutex()
+{ }
+
+MarkerDispatcher::~MarkerDispatcher() noexcept
+{ }
+
+bool MarkerDispatcher::isSupported() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().alcGetInteger64vSOFT &&
+	       pContext->extensions().alGetSourcedvSOFT;
+}
+
+void MarkerDispatcher::setCallback(MarkerCallback callback, void* pUserData)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_callback = callback;
+	m_pUserData = pUserData;
+}
+
+void MarkerDispatcher::watch(Source& source)
+{
+	Data* pData(source.data());
+	if(!pData)
+		throw std::runtime_error("Unable to watch markers: "
+		                         "source not initialized");
+	if(!isSupported())
+		throw std::runtime_error("Unable to watch markers: "
+		                         "ALC_SOFT_device_clock or "
+		                         "AL_SOFT_source_latency not supported");
+
+	Watch entry;
+	entry.pSource = &source;
+	entry.pData = pData;
+	entry.fSyncPos = static_cast<double>(source.offset());
+	entry.uNext = firstMarker(pData->markers(), entry.fSyncPos);
+	// Boucle partielle seulement si le périphérique la joue
+	bool hasLoop(Data::isLoopPointsSupported() && pData->loopEnd() > 0);
+	entry.uLoopStart = hasLoop ? pData->loopStart() : 0;
+	entry.uLoopEnd = hasLoop ? pData->loopEnd() : 0;
+	entry.syncClock = 0;
+	entry.fRate = 0.; // Premier relevé au prochain pas
+	entry.due = 0;
+	entry.isDone = false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(Watch& watch : m_tblWatches)
+	{
+		if(watch.pSource == &source)
+		{
+			watch = entry;
+			return;
+		}
+	}
+	m_tblWatches.push_back(entry);
+}
+
+void MarkerDispatcher::unwatch(const Source& source) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_tblWatches.erase(std::remove_if(m_tblWatches.begin(), m_tblWatches.end(),
+		[&source](const Watch& watch) { return watch.pSource == &source; }),
+		m_tblWatches.end());
+}
+
+std::size_t MarkerDispatcher::watched() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_tblWatches.size();
+}
+
+std::size_t MarkerDispatcher::dispatch()
+{
+	std::deque<MarkerEvent> tblEvents;
+	MarkerCallback callback;
+	void* pUserData;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		tblEvents.swap(m_tblEvents);
+		callback = m_callback;
+		pUserData = m_pUserData;
+	}
+
+	// Hors verrou : la fonction peut suivre de nouvelles sources
+	if(callback)
+		for(const MarkerEvent& event : tblEvents)
+			callback(event, pUserData);
+	return tblEvents.size();
+}
+
+void MarkerDispatcher::update(float fDelta)
+{
+	(void)fDelta;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Context* pContext(Context::current());
+	if(!pContext || m_tblWatches.empty())
+		return;
+
+	// Une seule lecture de l'horloge par pas, sources relevées à échéance
+	std::int64_t clock, latency;
+	pContext->deviceClockLatency(clock, latency);
+	for(Watch& watch : m_tblWatches)
+	{
+		if(clock < watch.due)
+			continue;
+		try
+		{
+			resync(watch, clock, latency);
+		}
+		catch(std::runtime_error& )
+		{
+			// Erreur du pilote sur cette source : elle est oubliée
+			watch.isDone = true;
+		}
+	}
+	m_tblWatches.erase(std::remove_if(m_tblWatches.begin(), m_tblWatches.end(),
+		[](const Watch& watch) { return watch.isDone; }), m_tblWatches.end());
+}
+
+void MarkerDispatcher::resync(Watch& watch, std::int64_t clock,
+                              std::int64_t latency)
+{
+	const std::vector<Marker>& tblMarkers(watch.pData->markers());
+	Source& source(*watch.pSource);
+
+	if(!source.isPlaying())
+	{
+		if(source.isStopped())
+		{
+			// Fin de lecture : marqueurs entendus d'après le dernier relevé
+			while(watch.fRate > 0. && watch.uNext < tblMarkers.size())
+			{
+				const Marker& marker(tblMarkers[watch.uNext]);
+				std::int64_t markerClock(audibleClock(watch, marker.position));
+				if(markerClock > clock)
+					break;
+				push(watch, marker, markerClock);
+			}
+			watch.isDone = true;
+		}
+		else
+		{
+			watch.due = clock + m_resyncNs; // En pause
+		}
+		return;
+	}
+
+	double second, sourceClock;
+	source.offsetClock(second, sourceClock);
+	bool isLooping(source.isLooping());
+	double freq(static_cast<double>(watch.pData->frequency()));
+	double position(second * freq);
+
+	// Position revenue en arrière : rebouclage ou déplacement
+	if(watch.fRate > 0. && position < watch.fSyncPos)
+	{
+		if(isLooping)
+		{
+			while(watch.uNext < tblMarkers.size() &&
+			      (watch.uLoopEnd == 0 ||
+			       tblMarkers[watch.uNext].position < watch.uLoopEnd))
+				push(watch, tblMarkers[watch.uNext], clock);
+			watch.uNext = firstMarker(tblMarkers, watch.uLoopStart);
+		}
+		else
+		{
+			watch.uNext = firstMarker(tblMarkers, position);
+		}
+	}
+
+	watch.fSyncPos = position;
+	watch.syncClock = static_cast<std::int64_t>(
+		sourceClock * NANOSECONDS_PER_SECOND) + latency;
+	watch.fRate = freq * source.pitch();
+
+	// Marqueurs déjà entendus
+	while(watch.uNext < tblMarkers.size())
+	{
+		const Marker& marker(tblMarkers[watch.uNext]);
+		std::int64_t markerClock(audibleClock(watch, marker.position));
+		if(markerClock > clock)
+			break;
+		push(watch, marker, markerClock);
+	}
+
+	// Prochain relevé : marqueur suivant, au plus tard après m_resyncNs
+	watch.due = clock + m_resyncNs;
+	if(watch.uNext < tblMarkers.size())
+		watch.due = std::min(watch.due, audibleClock(watch,
+		                     tblMarkers[watch.uNext].position));
+	else if(!isLooping)
+		watch.isDone = true; // Plus aucun marqueur à venir
+}
+
+std::int64_t MarkerDispatcher::audibleClock(const Watch& watch,
+                                            double position) const noexcept
+{
+	if(watch.fRate <= 0.)
+		return watch.syncClock;
+	return watch.syncClock + static_cast<std::int64_t>(
+		(position - watch.fSyncPos) / watch.fRate * NANOSECONDS_PER_SECOND);
+}
+
+void MarkerDispatcher::push(Watch& watch, const Marker& marker,
+                            std::int64_t clock)
+{
+	MarkerEvent event = {watch.pSource, marker, clock};
+	m_tblEvents.push_back(event);
+	++watch.uNext;
+}
+
+} // namespace KA3D
@@ -0,0 +1,340 @@
+#ifndef MIXKERNELS_H_INCLUDED
+#define MIXKERNELS_H_INCLUDED
+/**
+ *
+ * @file MixKernels.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les noyaux de calcul vectoriels du mixeur (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  include <xmmintrin.h>
+#  define KA3D_MIX_SSE
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define KA3D_MIX_SSE2
+#endif
+
+namespace KA3D
+{
+
+/**
+ * @brief Ajoute un signal pondéré par un gain variant linéairement
+ * dst[i] += src[i] * (gain + step*i)
+ * La rampe évite les discontinuités (« zipper noise ») entre deux blocs
+ * @param dst Signal de destination (accumulation)
+ * @param src Signal à ajouter
+ * @param count Nombre d'échantillons
+ * @param gain Gain du premier échantillon
+ * @param step Variation du gain par échantillon
+ */
+static inline void mixGainRamp(float* dst, const float* src,
+                               std::uint32_t count, float gain,
+                               float step) noexcept
+{
+	std::uint32_t i(0);
+#ifdef KA3D_MIX_SSE
+	__m128 vGain(_mm_setr_ps(gain, gain+step, gain+2.f*step, gain+3.f*step));
+	const __m128 vStep(_mm_set1_ps(4.f*step));
+	for(; i+4<=count; i+=4)
+	{
+		__m128 vSrc(_mm_loadu_ps(src + i));
+		__m128 vDst(_mm_loadu_ps(dst + i));
+		_mm_storeu_ps(dst + i, _mm_add_ps(vDst, _mm_mul_ps(vSrc, vGain)));
+		vGain = _mm_add_ps(vGain, vStep);
+	}
+#endif
+	for(; i<count; ++i)
+		dst[i] += src[i] * (gain + step*static_cast<float>(i));
+}
+
+/**
+ * @brief Ajoute un signal à un autre (dst[i] += src[i])
+ * @param dst Signal de destination (accumulation)
+ * @param src Signal à ajouter
+ * @param count Nombre d'échantillons
+ */
+static inline void mixAdd(float* dst, const float* src,
+                          std::uint32_t count) noexcept
+{
+	std::uint32_t i(0);
+#ifdef KA3D_MIX_SSE
+	for(; i+4<=count; i+=4)
+		_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i),
+		                                  _mm_loadu_ps(src + i)));
+#endif
+	for(; i<count; ++i)
+		dst[i] += src[i];
+}
+
+/**
+ * @brief Multiplie un signal par un gain constant (dst[i] *= gain)
+ * @param dst Signal à modifier
+ * @param count Nombre d'échantillons
+ * @param gain Gain à appliquer
+ */
+static inline void mixScale(float* dst, std::uint32_t count,
+                            float gain) noexcept
+{
+	std::uint32_t i(0);
+#ifdef KA3D_MIX_SSE
+	const __m128 vGain(_mm_set1_ps(gain));
+	for(; i+4<=count; i+=4)
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), vGain));
+#endif
+	for(; i<count; ++i)
+		dst[i] *= gain;
+}
+
+/**
+ * @brief Somme des carrés d'un signal (énergie, pour le calcul RMS)
+ * @param src Signal
+ * @param count Nombre d'échantillons
+ * @return Somme des src[i]²
+ */
+static inline float mixSumSquares(const float* src,
+                                  std::uint32_t count) noexcept
+{
+	std::uint32_t i(0);
+	float sum(0.f);
+#ifdef KA3D_MIX_SSE
+	__m128 vSum(_mm_setzero_ps());
+	for(; i+4<=count; i+=4)
+	{
+		__m128 vSrc(_mm_loadu_ps(src + i));
+		vSum = _mm_add_ps(vSum, _mm_mul_ps(vSrc, vSrc));
+	}
+	float tblSum[4];
+	_mm_storeu_ps(tblSum, vSum);
+	sum = (tblSum[0] + tblSum[1]) + (tblSum[2] + tblSum[3]);
+#endif
+	for(; i<count; ++i)
+		sum += src[i] * src[i];
+	return sum;
+}
+
+/**
+ * @brief Rééchantillonne un canal par interpolation linéaire
+ * @param dst Signal de destination (count échantillons)
+ * @param src Signal source
+ * @param frames Nombre d'échantillons du signal source
+ * @param position Position de lecture (en échantillons source), avancée
+ * @param step Pas de lecture (rapport des fréquences × hauteur)
+ * @param count Nombre d'échantillons à produire
+ * @param isLooping Est-ce que la lecture reboucle sur [loopStart, loopEnd[
+ * @param loopStart Début de la boucle
+ * @param loopEnd Fin de la boucle, exclue (<= frames)
+ * @return Nombre d'échantillons produits (< count si la fin est atteinte)
+ */
+static inline std::uint32_t mixResample(float* dst, const float* src,
+                                        std::uint32_t frames, double& position,
+                                        double step, std::uint32_t count,
+                                        bool isLooping, std::uint32_t loopStart,
+                                        std::uint32_t loopEnd) noexcept
+{
+	std::uint32_t end(isLooping ? loopEnd : frames);
+	std::uint32_t i(0);
+	for(; i<count; ++i)
+	{
+		if(position >= end)
+		{
+			if(!isLooping || loopEnd <= loopStart)
+				break;
+			while(position >= end)
+				position -= loopEnd - loopStart;
+		}
+		std::uint32_t index(static_cast<std::uint32_t>(position));
+		float frac(static_cast<float>(position - index));
+		float a(src[index]);
+		float b(index+1 < end ? src[index+1]
+		                      : (isLooping ? src[loopStart] : 0.f));
+		dst[i] = a + (b - a)*frac;
+		position += step;
+	}
+	return i;
+}
+
+/**
+ * @brief Multiplie deux spectres et accumule le résultat (complexes séparés)
+ * acc[i] += a[i] * b[i]
+ * @param accRe Parties réelles de l'accumulateur
+ * @param accIm Parties imaginaires de l'accumulateur
+ * @param aRe Parties réelles du premier spectre
+ * @param aIm Parties imaginaires du premier spectre
+ * @param bRe Parties réelles du second spectre
+ * @param bIm Parties imaginaires du second spectre
+ * @param count Nombre de points
+ */
+static inline void mixComplexMulAdd(float* accRe, float* accIm,
+                                    const float* aRe, const float* aIm,
+                                    const float* bRe, const float* bIm,
+                                    std::uint32_t count) noexcept
+{
+	std::uint32_t i(0);
+#ifdef KA3D_MIX_SSE
+	for(; i+4<=count; i+=4)
+	{
+		__m128 ar(_mm_loadu_ps(aRe + i));
+		__m128 ai(_mm_loadu_ps(aIm + i));
+		__m128 br(_mm_loadu_ps(bRe + i));
+		__m128 bi(_mm_loadu_ps(bIm + i));
+		__m128 re(_mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+		__m128 im(_mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+		_mm_storeu_ps(accRe + i, _mm_add_ps(_mm_loadu_ps(accRe + i), re));
+		_mm_storeu_ps(accIm + i, _mm_add_ps(_mm_loadu_ps(accIm + i), im));
+	}
+#endif
+	for(; i<count; ++i)
+	{
+		accRe[i] += aRe[i]*bRe[i] - aIm[i]*bIm[i];
+		accIm[i] += aRe[i]*bIm[i] + aIm[i]*bRe[i];
+	}
+}
+
+/**
+ * @brief Applique un étage de papillons d'une FFT radix-2 (complexes séparés)
+ * @param re Parties réelles (size points, modifiées)
+ * @param im Parties imaginaires (size points, modifiées)
+ * @param size Taille de la FFT
+ * @param half Demi-taille des groupes de l'étage
+ * @param twRe Parties réelles des facteurs de rotation de l'étage (half)
+ * @param twIm Parties imaginaires des facteurs de rotation de l'étage (half)
+ */
+static inline void mixButterflies(float* re, float* im, std::uint32_t size,
+                                  std::uint32_t half, const float* twRe,
+                                  const float* twIm) noexcept
+{
+	for(std::uint32_t base=0; base<size; base+=2*half)
+	{
+		float* aRe(re + base);
+		float* aIm(im + base);
+		float* bRe(aRe + half);
+		float* bIm(aIm + half);
+		std::uint32_t j(0);
+#ifdef KA3D_MIX_SSE
+		for(; j+4<=half; j+=4)
+		{
+			__m128 wr(_mm_loadu_ps(twRe + j));
+			__m128 wi(_mm_loadu_ps(twIm + j));
+			__m128 br(_mm_loadu_ps(bRe + j));
+			__m128 bi(_mm_loadu_ps(bIm + j));
+			__m128 tr(_mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi)));
+			__m128 ti(_mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr)));
+			__m128 ar(_mm_loadu_ps(aRe + j));
+			__m128 ai(_mm_loadu_ps(aIm + j));
+			_mm_storeu_ps(aRe + j, _mm_add_ps(ar, tr));
+			_mm_storeu_ps(aIm + j, _mm_add_ps(ai, ti));
+			_mm_storeu_ps(bRe + j, _mm_sub_ps(ar, tr));
+			_mm_storeu_ps(bIm + j, _mm_sub_ps(ai, ti));
+		}
+#endif
+		for(; j<half; ++j)
+		{
+			float tr(bRe[j]*twRe[j] - bIm[j]*twIm[j]);
+			float ti(bRe[j]*twIm[j] + bIm[j]*twRe[j]);
+			bRe[j] = aRe[j] - tr;
+			bIm[j] = aIm[j] - ti;
+			aRe[j] += tr;
+			aIm[j] += ti;
+		}
+	}
+}
+
+/**
+ * @brief Convertit des flottants dans [-1, 1] en entiers 16 bits signés
+ * (arrondi au plus proche, saturé)
+ * @param dst Échantillons 16 bits (ordre natif)
+ * @param src Échantillons flottants
+ * @param count Nombre d'échantillons
+ */
+static inline void convertFloatToS16(std::int16_t* dst, const float* src,
+                                     std::uint32_t count) noexcept
+{
+	std::uint32_t i(0);
+#ifdef KA3D_MIX_SSE2
+	const __m128 vScale(_mm_set1_ps(32767.f));
+	for(; i+8<=count; i+=8)
+	{
+		__m128i lo(_mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), vScale)));
+		__m128i hi(_mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4),
+		                                      vScale)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+		                 _mm_packs_epi32(lo, hi));
+	}
+#endif
+	for(; i<count; ++i)
+	{
+		float value(src[i] * 32767.f);
+		value = value < -32768.f ? -32768.f : (value > 32767.f ? 32767.f : value);
+		dst[i] = static_cast<std::int16_t>(value < 0.f ? value - 0.5f
+		                                               : value + 0.5f);
+	}
+}
+
+/**
+ * @brief Convertit des échantillons 24 bits signés (petit-boutiste,
+ * 3 octets) en flottants dans [-1, 1[
+ * @param dst Échantillons flottants
+ * @param src Échantillons 24 bits
+ * @param count Nombre d'échantillons
+ */
+static inline void convertS24ToFloat(float* dst, const std::uint8_t* src,
+                                     std::uint32_t count) noexcept
+{
+	const float scale(1.f / 2147483648.f);
+	std::uint32_t i(0);
+#ifdef KA3D_MIX_SSE2
+	// Assemblage dans les 24 bits de poids fort, conversion par 4
+	const __m128 vScale(_mm_set1_ps(scale));
+	for(; i+4<=count; i+=4)
+	{
+		const std::uint8_t* p(src + 3*i);
+		__m128i v(_mm_setr_epi32(
+			static_cast<std::int32_t>(p[0] << 8 | p[1] << 16 |
+			                          static_cast<std::uint32_t>(p[2]) << 24),
+			static_cast<std::int32_t>(p[3] << 8 | p[4] << 16 |
+			                          static_cast<std::uint32_t>(p[5]) << 24),
+			static_cast<std::int32_t>(p[6] << 8 | p[7] << 16 |
+			                          static_cast<std::uint32_t>(p[8]) << 24),
+			static_cast<std::int32_t>(p[9] << 8 | p[10] << 16 |
+			                          static_cast<std::uint32_t>(p[11]) << 24)));
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), vScale));
+	}
+#endif
+	for(; i<count; ++i)
+	{
+		const std::uint8_t* p(src + 3*i);
+		std::int32_t value(static_cast<std::int32_t>(
+			p[0] << 8 | p[1] << 16 | static_cast<std::uint32_t>(p[2]) << 24));
+		dst[i] = static_cast<float>(value) * scale;
+	}
+}
+
+} // namespace KA3D
+
+#endif // MIXKERNELS_H_INCLUDED
@@ -0,0 +1,983 @@
+/**
+ *
+ * @file Mixer.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant le mixeur logiciel (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/Mixer.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "KA3D/Ducker.h"
+#include "MixKernels.h"
+#include "MixerPrivate.h"
+#include "ProfilerPrivate.h"
+#include "WorkStealingPool.h"
+
+namespace KA3D
+{
+
+MixerEffect::~MixerEffect() noexcept
+{ }
+
+static constexpr float PI = 3.14159265358979323846f;
+
+static inline float dot(const float a[3], const float b[3]) noexcept
+{
+	return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+static inline void cross(const float a[3], const float b[3],
+                         float out[3]) noexcept
+{
+	out[0] = a[1]*b[2] - a[2]*b[1];
+	out[1] = a[2]*b[0] - a[0]*b[2];
+	out[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static inline void normalize(float v[3]) noexcept
+{
+	float len(std::sqrt(dot(v, v)));
+	if(len > 0.f)
+	{
+		v[0] /= len;
+		v[1] /= len;
+		v[2] /= len;
+	}
+}
+
+static inline void set3(float v[3], float x, float y, float z) noexcept
+{
+	v[0] = x;
+	v[1] = y;
+	v[2] = z;
+}
+
+float mixerDistanceGain(DistanceModel model, float dist, float ref,
+                        float max, float rollOff) noexcept
+{
+	switch(model)
+	{
+	case DM_INVERSE_CLAMPED:
+		dist = std::max(ref, std::min(dist, max));
+		/* Falls through. */
+	case DM_INVERSE:
+	{
+		float denom(ref + rollOff*(dist - ref));
+		return denom > 0.f ? ref / denom : 1.f;
+	}
+	case DM_LINEAR_CLAMPED:
+		dist = std::max(ref, dist);
+		/* Falls through. */
+	case DM_LINEAR:
+		dist = std::min(dist, max);
+		if(max <= ref)
+			return 1.f;
+		return std::max(0.f, 1.f - rollOff*(dist - ref)/(max - ref));
+	case DM_EXPONENT_CLAMPED:
+		dist = std::max(ref, std::min(dist, max));
+		/* Falls through. */
+	case DM_EXPONENT:
+		if(dist <= 0.f || ref <= 0.f)
+			return 1.f;
+		return std::pow(dist / ref, -rollOff);
+	case DM_NONE:
+	default:
+		return 1.f;
+	}
+}
+
+void mixerEncodeAmbisonic(std::uint16_t order, float x, float y, float z,
+                          float* tblCoeff) noexcept
+{
+	assert(order >= 1 && order <= MIXER_MAX_AMBISONIC_ORDER);
+	tblCoeff[0] = 1.f;
+	tblCoeff[1] = y;
+	tblCoeff[2] = z;
+	tblCoeff[3] = x;
+	if(order < 2)
+		return;
+
+	const float SQRT3(1.73205080757f);
+	tblCoeff[4] = SQRT3 * x * y;
+	tblCoeff[5] = SQRT3 * y * z;
+	tblCoeff[6] = 0.5f * (3.f*z*z - 1.f);
+	tblCoeff[7] = SQRT3 * x * z;
+	tblCoeff[8] = 0.5f * SQRT3 * (x*x - y*y);
+	if(order < 3)
+		return;
+
+	const float SQRT5_8(0.79056941504f);
+	const float SQRT15(3.87298334621f);
+	const float SQRT3_8(0.61237243570f);
+	tblCoeff[9] = SQRT5_8 * y * (3.f*x*x - y*y);
+	tblCoeff[10] = SQRT15 * x * y * z;
+	tblCoeff[11] = SQRT3_8 * y * (5.f*z*z - 1.f);
+	tblCoeff[12] = 0.5f * z * (5.f*z*z - 3.f);
+	tblCoeff[13] = SQRT3_8 * x * (5.f*z*z - 1.f);
+	tblCoeff[14] = 0.5f * SQRT15 * z * (x*x - y*y);
+	tblCoeff[15] = SQRT5_8 * x * (x*x - 3.f*y*y);
+}
+
+void MixerVoiceData::reset(const MixerBuffer* pNewBuffer) noexcept
+{
+	pBuffer = pNewBuffer;
+	state = MVS_INITIAL;
+	position = 0.;
+	fGain = 1.f;
+	fPitch = 1.f;
+	fMinGain = 0.f;
+	fMaxGain = 1.f;
+	fRefDistance = 1.f;
+	fMaxDistance = 3.402823466e+38f;
+	fRollOff = 1.f;
+	fConeInnerAngle = 360.f;
+	fConeOuterAngle = 360.f;
+	fConeOuterGain = 0.f;
+	set3(tblPosition, 0.f, 0.f, 0.f);
+	set3(tblVelocity, 0.f, 0.f, 0.f);
+	set3(tblDirection, 0.f, 0.f, 0.f);
+	isRelative = false;
+	isLooping = false;
+	group = 0;
+	fEnergy = 0.f;
+	hasLastGain = false;
+}
+
+MixerPrivate::MixerPrivate(std::uint32_t frequency, std::uint16_t channels,
+                           std::uint32_t blockSize):
+	m_uFrequency(frequency),
+	m_uChannels(channels),
+	m_uBlockSize(blockSize),
+	m_uAmbiOrder(0),
+	m_uAmbiChannels(0),
+	m_uBusChannels(channels),
+	m_tblDecoder(),
+	m_tblVoices(),
+	m_tblFreeVoices(),
+	m_listener(),
+	m_tblBus(channels * blockSize),
+	m_tblPartialBus(),
+	m_tblScratch(MIXER_MAX_CHANNELS * blockSize),
+	m_tblActive(),
+	m_uBlockFrames(0),
+	m_pPool(nullptr),
+	m_tblOutput(),
+	m_tblEffects(),
+	m_tblGroupGain(),
+	m_tblDuckGain(),
+	m_tblGroupLevel(),
+	m_tblDuckers(),
+	m_callback(nullptr),
+	m_pUserData(nullptr)
+{
+	std::fill(m_tblGroupGain, m_tblGroupGain + Mixer::GROUP_COUNT, 1.f);
+	std::fill(m_tblDuckGain, m_tblDuckGain + Mixer::GROUP_COUNT, 1.f);
+	m_listener.fGain = 1.f;
+	set3(m_listener.tblPosition, 0.f, 0.f, 0.f);
+	set3(m_listener.tblVelocity, 0.f, 0.f, 0.f);
+	set3(m_listener.tblAt, 0.f, 0.f, -1.f);
+	set3(m_listener.tblUp, 0.f, 1.f, 0.f);
+	m_listener.fDopplerFactor = 1.f;
+	m_listener.fSpeedSound = 343.3f;
+	m_listener.distanceModel = DM_INVERSE_CLAMPED;
+}
+
+MixerPrivate::~MixerPrivate() noexcept
+{
+	delete m_pPool;
+}
+
+static void mixBatchTask(std::uint32_t batch, std::uint32_t worker,
+                         void* pUserData)
+{
+	static_cast<MixerPrivate*>(pUserData)->mixBatch(batch, worker);
+}
+
+void MixerPrivate::mixBatch(std::uint32_t batch, std::uint32_t worker)
+	noexcept
+{
+	KA3D_PROFILE_SCOPE("Mixer::mixBatch");
+	std::size_t busSize(m_uBusChannels * m_uBlockSize);
+	float* pBus(batch == 0 ? m_tblBus.data() :
+	            m_tblPartialBus.data() + (batch-1)*busSize);
+	float* pScratch(m_tblScratch.data() +
+	                worker*MIXER_MAX_CHANNELS*m_uBlockSize);
+
+	std::uint32_t end(std::min<std::uint32_t>(
+		(batch+1)*MIXER_BATCH_VOICES, m_tblActive.size()));
+	for(std::uint32_t i=batch*MIXER_BATCH_VOICES; i<end; ++i)
+		mixVoice(m_tblVoices[m_tblActive[i]], pBus, pScratch, m_uBlockFrames);
+}
+
+void MixerPrivate::mixBlock(std::uint32_t frames)
+{
+	m_tblActive.clear();
+	for(std::uint32_t i=0; i<m_tblVoices.size(); ++i)
+		if(m_tblVoices[i].pBuffer && m_tblVoices[i].state == MVS_PLAYING)
+			m_tblActive.push_back(i);
+
+	std::uint32_t batches((m_tblActive.size() + MIXER_BATCH_VOICES - 1) /
+	                      MIXER_BATCH_VOICES);
+	std::size_t busSize(m_uBusChannels * m_uBlockSize);
+	std::fill(m_tblBus.begin(), m_tblBus.end(), 0.f);
+	if(batches > 1)
+	{
+		if(m_tblPartialBus.size() < (batches-1)*busSize)
+			m_tblPartialBus.resize((batches-1)*busSize);
+		std::fill(m_tblPartialBus.begin(),
+		          m_tblPartialBus.begin() + (batches-1)*busSize, 0.f);
+	}
+
+	m_uBlockFrames = frames;
+	if(m_pPool && batches > 1)
+		m_pPool->run(batches, &mixBatchTask, this);
+	else
+	{
+		for(std::uint32_t b=0; b<batches; ++b)
+			mixBatch(b, 0);
+	}
+
+	// Réduction dans l'ordre des lots : résultat indépendant des fils
+	for(std::uint32_t b=1; b<batches; ++b)
+	{
+		const float* pPartial(m_tblPartialBus.data() + (b-1)*busSize);
+		for(std::uint16_t o=0; o<m_uBusChannels; ++o)
+		{
+			mixAdd(m_tblBus.data() + o*m_uBlockSize,
+			       pPartial + o*m_uBlockSize, frames);
+		}
+	}
+
+	updateGroups(frames);
+	if(m_uAmbiOrder > 0)
+		decodeAmbisonic(frames);
+
+	if(!m_tblEffects.empty())
+	{
+		float* tblChannels[MIXER_MAX_CHANNELS];
+		for(std::uint16_t o=0; o<m_uChannels; ++o)
+			tblChannels[o] = m_tblBus.data() + o*m_uBlockSize;
+		for(MixerEffect* pEffect : m_tblEffects)
+			pEffect->process(tblChannels, m_uChannels, frames);
+	}
+}
+
+void MixerPrivate::updateGroups(std::uint32_t frames) noexcept
+{
+	// Somme des énergies dans l'ordre des voix : résultat indépendant des fils
+	float tblEnergy[Mixer::GROUP_COUNT] = {};
+	for(std::uint32_t index : m_tblActive)
+		tblEnergy[m_tblVoices[index].group] += m_tblVoices[index].fEnergy;
+	for(std::uint16_t g=0; g<Mixer::GROUP_COUNT; ++g)
+		m_tblGroupLevel[g] = std::sqrt(tblEnergy[g]);
+
+	// Séparée du volume de l'utilisateur (Mixer::setGroupGain) : les deux se
+	// multiplient, comme le volume d'atténuation des bus OpenAL
+	float delta(static_cast<float>(frames) / m_uFrequency);
+	std::fill(m_tblDuckGain, m_tblDuckGain + Mixer::GROUP_COUNT, 1.f);
+	for(const MixerDucking& ducking : m_tblDuckers)
+	{
+		ducking.pDucker->update(delta, m_tblGroupLevel[ducking.trigger]);
+		m_tblDuckGain[ducking.target] *= ducking.pDucker->gain();
+	}
+}
+
+void MixerPrivate::decodeAmbisonic(std::uint32_t frames) noexcept
+{
+	KA3D_PROFILE_SCOPE("Mixer::decodeAmbisonic");
+	const float* pAmbi(m_tblBus.data() + m_uChannels*m_uBlockSize);
+	for(std::uint16_t o=0; o<m_uChannels; ++o)
+	{
+		float* pOut(m_tblBus.data() + o*m_uBlockSize);
+		for(std::uint16_t k=0; k<m_uAmbiChannels; ++k)
+		{
+			float gain(m_tblDecoder[o*m_uAmbiChannels + k]);
+			if(gain != 0.f)
+				mixGainRamp(pOut, pAmbi + k*m_uBlockSize, frames, gain, 0.f);
+		}
+	}
+}
+
+void MixerPrivate::setAmbisonicOrder(std::uint16_t order)
+{
+	m_uAmbiOrder = order;
+	m_uAmbiChannels = order > 0 ? (order+1)*(order+1) : 0;
+	m_uBusChannels = m_uChannels + m_uAmbiChannels;
+	m_tblBus.assign(m_uBusChannels * m_uBlockSize, 0.f);
+	m_tblPartialBus.clear();
+
+	// Décodage par défaut : microphones virtuels cardioïdes (1er ordre)
+	// orientés vers la gauche et la droite, ou omnidirectionnel en mono
+	m_tblDecoder.assign(m_uChannels * m_uAmbiChannels, 0.f);
+	if(order > 0)
+	{
+		if(m_uChannels == 1)
+			m_tblDecoder[0] = 1.f;
+		else
+		{
+			m_tblDecoder[0] = 0.5f; // W -> gauche
+			m_tblDecoder[1] = 0.5f; // Y -> gauche
+			m_tblDecoder[m_uAmbiChannels] = 0.5f; // W -> droite
+			m_tblDecoder[m_uAmbiChannels + 1] = -0.5f; // Y -> droite
+		}
+	}
+
+	for(MixerVoiceData& voice : m_tblVoices)
+		voice.hasLastGain = false;
+}
+
+MixerVoiceData& MixerPrivate::voice(MixerVoice id) noexcept
+{
+	assert(id > 0 && id <= m_tblVoices.size());
+	assert(m_tblVoices[id-1].pBuffer);
+	return m_tblVoices[id-1];
+}
+
+double MixerPrivate::spatialize(const MixerVoiceData& voice,
+                                float tblGain[MIXER_MAX_CHANNELS]
+                                             [MIXER_MAX_CHANNELS],
+                                float tblAmbiGain[MIXER_MAX_AMBISONIC_CHANNELS])
+	const noexcept
+{
+	const MixerListenerData& listener(m_listener);
+	std::uint16_t srcChannels(voice.pBuffer->channels());
+	double step(static_cast<double>(voice.pBuffer->frequency()) /
+	            m_uFrequency * voice.fPitch);
+
+	for(std::uint16_t c=0; c<MIXER_MAX_CHANNELS; ++c)
+		for(std::uint16_t o=0; o<MIXER_MAX_CHANNELS; ++o)
+			tblGain[c][o] = 0.f;
+	for(std::uint16_t k=0; k<m_uAmbiChannels; ++k)
+		tblAmbiGain[k] = 0.f;
+
+	// Données multicanal : pas de spatialisation (comme OpenAL)
+	if(srcChannels > 1)
+	{
+		float gain(std::max(voice.fMinGain,
+		                    std::min(voice.fGain, voice.fMaxGain)));
+		gain *= listener.fGain * m_tblGroupGain[voice.group]
+		        * m_tblDuckGain[voice.group];
+		for(std::uint16_t c=0; c<srcChannels; ++c)
+		{
+			if(m_uChannels == 1)
+				tblGain[c][0] = gain / srcChannels;
+			else
+				tblGain[c][c % m_uChannels] = gain;
+		}
+		return step;
+	}
+
+	// Vecteur écouteur -> voix, dans le repère de l'écouteur si absolue
+	float tblDelta[3];
+	float tblListenerVel[3];
+	if(voice.isRelative)
+	{
+		set3(tblDelta, voice.tblPosition[0], voice.tblPosition[1],
+		     voice.tblPosition[2]);
+		set3(tblListenerVel, 0.f, 0.f, 0.f);
+	}
+	else
+	{
+		set3(tblDelta, voice.tblPosition[0] - listener.tblPosition[0],
+		     voice.tblPosition[1] - listener.tblPosition[1],
+		     voice.tblPosition[2] - listener.tblPosition[2]);
+		set3(tblListenerVel, listener.tblVelocity[0],
+		     listener.tblVelocity[1], listener.tblVelocity[2]);
+	}
+	float dist(std::sqrt(dot(tblDelta, tblDelta)));
+
+	// Atténuation avec la distance
+	float gain(voice.fGain * mixerDistanceGain(listener.distanceModel, dist,
+	                                           voice.fRefDistance,
+	                                           voice.fMaxDistance,
+	                                           voice.fRollOff));
+
+	// Cône : angle entre la direction et le vecteur voix -> écouteur
+	float dirLength(std::sqrt(dot(voice.tblDirection, voice.tblDirection)));
+	if(dirLength > 0.f && dist > 0.f)
+	{
+		float cosAngle(-dot(voice.tblDirection, tblDelta) / (dirLength*dist));
+		cosAngle = std::max(-1.f, std::min(cosAngle, 1.f));
+		float angle(std::acos(cosAngle) * 360.f / PI); // angle total du cône
+		if(angle > voice.fConeInnerAngle)
+		{
+			if(angle >= voice.fConeOuterAngle ||
+			   voice.fConeOuterAngle <= voice.fConeInnerAngle)
+			{
+				gain *= voice.fConeOuterGain;
+			}
+			else
+			{
+				float t((angle - voice.fConeInnerAngle) /
+				        (voice.fConeOuterAngle - voice.fConeInnerAngle));
+				gain *= 1.f + t*(voice.fConeOuterGain - 1.f);
+			}
+		}
+	}
+	gain = std::max(voice.fMinGain, std::min(gain, voice.fMaxGain));
+	gain *= listener.fGain * m_tblGroupGain[voice.group]
+	        * m_tblDuckGain[voice.group];
+
+	// Effet doppler (formule de la spécification OpenAL 1.1)
+	if(listener.fDopplerFactor > 0.f && listener.fSpeedSound > 0.f &&
+	   dist > 0.f)
+	{
+		float limit(listener.fSpeedSound / listener.fDopplerFactor);
+		float vls(-dot(tblListenerVel, tblDelta) / dist);
+		float vss(-dot(voice.tblVelocity, tblDelta) / dist);
+		vls = std::min(vls, limit);
+		vss = std::min(vss, limit);
+		float num(listener.fSpeedSound - listener.fDopplerFactor*vls);
+		float denom(listener.fSpeedSound - listener.fDopplerFactor*vss);
+		if(num > 0.f && denom > 0.f)
+			step *= num / denom;
+	}
+
+	// Direction dans le repère de l'écouteur (x droite, y haut, z arrière)
+	float tblLocal[3] = {0.f, 0.f, 0.f};
+	if(dist > 0.f)
+	{
+		if(voice.isRelative)
+			set3(tblLocal, tblDelta[0] / dist, tblDelta[1] / dist,
+			     tblDelta[2] / dist);
+		else
+		{
+			float tblBack[3] = {-listener.tblAt[0], -listener.tblAt[1],
+			                    -listener.tblAt[2]};
+			float tblRight[3];
+			float tblUp[3];
+			normalize(tblBack);
+			cross(listener.tblUp, tblBack, tblRight);
+			normalize(tblRight);
+			cross(tblBack, tblRight, tblUp);
+			set3(tblLocal, dot(tblDelta, tblRight) / dist,
+			     dot(tblDelta, tblUp) / dist, dot(tblDelta, tblBack) / dist);
+		}
+	}
+
+	// Encodage dans le bus ambisonique (avant, gauche, haut)
+	if(m_uAmbiOrder > 0)
+	{
+		if(dist > 0.f)
+		{
+			mixerEncodeAmbisonic(m_uAmbiOrder, -tblLocal[2], -tblLocal[0],
+			                     tblLocal[1], tblAmbiGain);
+			for(std::uint16_t k=0; k<m_uAmbiChannels; ++k)
+				tblAmbiGain[k] *= gain;
+		}
+		else
+			tblAmbiGain[0] = gain;
+		return step;
+	}
+
+	if(m_uChannels == 1)
+	{
+		tblGain[0][0] = gain;
+		return step;
+	}
+
+	// Panoramique à puissance constante selon l'axe droit de l'écouteur
+	float angle((tblLocal[0] + 1.f) * PI * 0.25f);
+	tblGain[0][0] = gain * std::cos(angle);
+	tblGain[0][1] = gain * std::sin(angle);
+	return step;
+}
+
+void MixerPrivate::mixVoice(MixerVoiceData& voice, float* pBus,
+                            float* pScratch, std::uint32_t frames)
+	const noexcept
+{
+	float tblGain[MIXER_MAX_CHANNELS][MIXER_MAX_CHANNELS];
+	float tblAmbiGain[MIXER_MAX_AMBISONIC_CHANNELS];
+	double step(spatialize(voice, tblGain, tblAmbiGain));
+	const MixerBuffer* pBuffer(voice.pBuffer);
+	std::uint16_t srcChannels(pBuffer->channels());
+
+	// Rééchantillonnage de chaque canal depuis la même position
+	double position(voice.position);
+	std::uint32_t produced(0);
+	for(std::uint16_t c=0; c<srcChannels; ++c)
+	{
+		position = voice.position;
+		produced = mixResample(pScratch + c*m_uBlockSize, pBuffer->channel(c),
+		                       pBuffer->frames(), position, step, frames,
+		                       voice.isLooping, pBuffer->loopStart(),
+		                       pBuffer->loopEnd());
+	}
+
+	// Niveau de la voix : énergie du signal rééchantillonné × gains cibles
+	// (somme des carrés : indépendante du panoramique)
+	float energy(0.f);
+	for(std::uint16_t c=0; c<srcChannels; ++c)
+	{
+		float gainSquare(0.f);
+		for(std::uint16_t o=0; o<m_uChannels; ++o)
+			gainSquare += tblGain[c][o] * tblGain[c][o];
+		if(m_uAmbiChannels > 0 && srcChannels == 1)
+			gainSquare += tblAmbiGain[0] * tblAmbiGain[0];
+		if(gainSquare > 0.f)
+			energy += mixSumSquares(pScratch + c*m_uBlockSize, produced)
+			          * gainSquare;
+	}
+	voice.fEnergy = energy / static_cast<float>(frames);
+
+	// Accumulation avec rampe de gain depuis le bloc précédent
+	for(std::uint16_t c=0; c<srcChannels; ++c)
+	{
+		for(std::uint16_t o=0; o<m_uChannels; ++o)
+		{
+			float target(tblGain[c][o]);
+			float start(voice.hasLastGain ? voice.tblLastGain[c][o] : target);
+			if(start != 0.f || target != 0.f)
+			{
+				mixGainRamp(pBus + o*m_uBlockSize, pScratch + c*m_uBlockSize,
+				            produced, start, (target - start) / frames);
+			}
+			voice.tblLastGain[c][o] = target;
+		}
+	}
+	// Encodage ambisonique (voix mono) : un gain par canal du bus
+	const float* pAmbiScratch(pScratch);
+	float* pAmbiBus(pBus + m_uChannels*m_uBlockSize);
+	for(std::uint16_t k=0; k<m_uAmbiChannels && srcChannels == 1; ++k)
+	{
+		float target(tblAmbiGain[k]);
+		float start(voice.hasLastGain ? voice.tblLastAmbiGain[k] : target);
+		if(start != 0.f || target != 0.f)
+		{
+			mixGainRamp(pAmbiBus + k*m_uBlockSize, pAmbiScratch, produced,
+			            start, (target - start) / frames);
+		}
+		voice.tblLastAmbiGain[k] = target;
+	}
+	voice.hasLastGain = true;
+
+	if(produced < frames)
+	{
+		voice.state = MVS_STOPPED;
+		voice.position = 0.;
+		voice.hasLastGain = false;
+	}
+	else
+		voice.position = position;
+}
+
+Mixer::Mixer(std::uint32_t frequency, std::uint16_t channels,
+             std::uint32_t blockSize):
+	m_pData(nullptr)
+{
+	if(frequency == 0 || blockSize == 0)
+		throw std::runtime_error("Unable to create mixer: invalid format");
+	if(channels == 0 || channels > MIXER_MAX_CHANNELS)
+		throw std::runtime_error("Unable to create mixer: "
+		                         "unsupported channel count");
+	m_pData = new MixerPrivate(frequency, channels, blockSize);
+}
+
+Mixer::~Mixer() noexcept
+{
+	delete m_pData;
+}
+
+void Mixer::setAmbisonicOrder(std::uint16_t order)
+{
+	if(order > MIXER_MAX_AMBISONIC_ORDER)
+		throw std::runtime_error("Unable to set ambisonic order: "
+		                         "unsupported order");
+	m_pData->setAmbisonicOrder(order);
+}
+
+std::uint16_t Mixer::ambisonicOrder() const noexcept
+{
+	return m_pData->m_uAmbiOrder;
+}
+
+void Mixer::setAmbisonicDecoder(const std::vector<float>& tblMatrix)
+{
+	if(tblMatrix.size() != m_pData->m_tblDecoder.size() ||
+	   m_pData->m_uAmbiOrder == 0)
+	{
+		throw std::runtime_error("Unable to set ambisonic decoder: "
+		                         "invalid matrix size");
+	}
+	m_pData->m_tblDecoder = tblMatrix;
+}
+
+void Mixer::addEffect(MixerEffect* pEffect)
+{
+	m_pData->m_tblEffects.push_back(pEffect);
+}
+
+void Mixer::removeEffect(MixerEffect* pEffect) noexcept
+{
+	std::vector<MixerEffect*>& tblEffects(m_pData->m_tblEffects);
+	tblEffects.erase(std::remove(tblEffects.begin(), tblEffects.end(), pEffect),
+	                 tblEffects.end());
+}
+
+void Mixer::setVoiceGroup(MixerVoice voice, std::uint16_t group) noexcept
+{
+	assert(group < GROUP_COUNT);
+	m_pData->voice(voice).group = group;
+}
+
+void Mixer::setGroupGain(std::uint16_t group, float fGain) noexcept
+{
+	assert(group < GROUP_COUNT);
+	m_pData->m_tblGroupGain[group] = fGain;
+}
+
+float Mixer::groupLevel(std::uint16_t group) const noexcept
+{
+	assert(group < GROUP_COUNT);
+	return m_pData->m_tblGroupLevel[group];
+}
+
+void Mixer::addDucker(Ducker* pDucker, std::uint16_t trigger,
+                      std::uint16_t target)
+{
+	if(!pDucker || trigger >= GROUP_COUNT || target >= GROUP_COUNT)
+		throw std::runtime_error("Unable to add mixer ducker: invalid group");
+	MixerDucking ducking = {pDucker, trigger, target};
+	m_pData->m_tblDuckers.push_back(ducking);
+}
+
+void Mixer::removeDucker(Ducker* pDucker) noexcept
+{
+	std::vector<MixerDucking>& tblDuckers(m_pData->m_tblDuckers);
+	for(std::size_t i=0; i<tblDuckers.size(); )
+	{
+		if(tblDuckers[i].pDucker == pDucker)
+		{
+			m_pData->m_tblDuckGain[tblDuckers[i].target] = 1.f;
+			tblDuckers.erase(tblDuckers.begin() + i);
+		}
+		else
+			++i;
+	}
+}
+
+void Mixer::setThreadCount(std::uint32_t threads)
+{
+	if(threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	if(threads == threadCount())
+		return;
+
+	delete m_pData->m_pPool;
+	m_pData->m_pPool = nullptr;
+	m_pData->m_tblScratch.assign(threads * MIXER_MAX_CHANNELS *
+	                             m_pData->m_uBlockSize, 0.f);
+	try
+	{
+		if(threads > 1)
+			m_pData->m_pPool = new WorkStealingPool(threads);
+	}
+	catch(const std::exception& e)
+	{
+		m_pData->m_tblScratch.resize(MIXER_MAX_CHANNELS *
+		                             m_pData->m_uBlockSize);
+		throw std::runtime_error(std::string("Unable to start mixer threads: ")
+		                         + e.what());
+	}
+}
+
+std::uint32_t Mixer::threadCount() const noexcept
+{
+	return m_pData->m_pPool ? m_pData->m_pPool->size() : 1;
+}
+
+std::uint32_t Mixer::frequency() const noexcept
+{
+	return m_pData->m_uFrequency;
+}
+
+std::uint16_t Mixer::channels() const noexcept
+{
+	return m_pData->m_uChannels;
+}
+
+void Mixer::render(float* pOut, std::uint32_t frames)
+{
+	KA3D_PROFILE_SCOPE("Mixer::render");
+	while(frames > 0)
+	{
+		std::uint32_t count(std::min(frames, m_pData->m_uBlockSize));
+		m_pData->mixBlock(count);
+		interleave(pOut, count);
+		pOut += count * m_pData->m_uChannels;
+		frames -= count;
+	}
+}
+
+void Mixer::setCallback(MixerCallback callback, void* pUserData)
+{
+	m_pData->m_callback = callback;
+	m_pData->m_pUserData = pUserData;
+	m_pData->m_tblOutput.resize(m_pData->m_uChannels * m_pData->m_uBlockSize);
+}
+
+void Mixer::process(std::uint32_t frames)
+{
+	KA3D_PROFILE_SCOPE("Mixer::process");
+	while(frames > 0)
+	{
+		std::uint32_t count(std::min(frames, m_pData->m_uBlockSize));
+		m_pData->mixBlock(count);
+		if(m_pData->m_callback)
+		{
+			interleave(m_pData->m_tblOutput.data(), count);
+			m_pData->m_callback(m_pData->m_tblOutput.data(), count,
+			                    m_pData->m_pUserData);
+		}
+		frames -= count;
+	}
+}
+
+void Mixer::interleave(float* pOut, std::uint32_t frames) const noexcept
+{
+	std::uint16_t channels(m_pData->m_uChannels);
+	const float* pBus(m_pData->m_tblBus.data());
+	for(std::uint16_t o=0; o<channels; ++o)
+	{
+		const float* src(pBus + o*m_pData->m_uBlockSize);
+		for(std::uint32_t i=0; i<frames; ++i)
+			pOut[i*channels + o] = src[i];
+	}
+}
+
+MixerVoice Mixer::addVoice(const MixerBuffer* pBuffer)
+{
+	if(!pBuffer)
+		throw std::runtime_error("Unable to add mixer voice: no data");
+	if(pBuffer->channels() > MIXER_MAX_CHANNELS)
+		throw std::runtime_error("Unable to add mixer voice: "
+		                         "unsupported channel count");
+
+	MixerVoice id;
+	if(!m_pData->m_tblFreeVoices.empty())
+	{
+		id = m_pData->m_tblFreeVoices.back();
+		m_pData->m_tblFreeVoices.pop_back();
+	}
+	else
+	{
+		m_pData->m_tblVoices.emplace_back();
+		id = static_cast<MixerVoice>(m_pData->m_tblVoices.size());
+	}
+	m_pData->m_tblVoices[id-1].reset(pBuffer);
+	return id;
+}
+
+void Mixer::removeVoice(MixerVoice voice) noexcept
+{
+	m_pData->voice(voice).pBuffer = nullptr;
+	m_pData->m_tblFreeVoices.push_back(voice);
+}
+
+void Mixer::play(MixerVoice voice) noexcept
+{
+	MixerVoiceData& data(m_pData->voice(voice));
+	if(data.state == MVS_PLAYING)
+		data.position = 0.;
+	data.state = MVS_PLAYING;
+	data.hasLastGain = false;
+}
+
+void Mixer::pause(MixerVoice voice) noexcept
+{
+	MixerVoiceData& data(m_pData->voice(voice));
+	if(data.state == MVS_PLAYING)
+		data.state = MVS_PAUSED;
+}
+
+void Mixer::stop(MixerVoice voice) noexcept
+{
+	MixerVoiceData& data(m_pData->voice(voice));
+	data.state = MVS_STOPPED;
+	data.position = 0.;
+}
+
+void Mixer::rewind(MixerVoice voice) noexcept
+{
+	MixerVoiceData& data(m_pData->voice(voice));
+	data.state = MVS_INITIAL;
+	data.position = 0.;
+}
+
+bool Mixer::isPlaying(MixerVoice voice) const noexcept
+{
+	return m_pData->voice(voice).state == MVS_PLAYING;
+}
+
+bool Mixer::isPaused(MixerVoice voice) const noexcept
+{
+	return m_pData->voice(voice).state == MVS_PAUSED;
+}
+
+bool Mixer::isStopped(MixerVoice voice) const noexcept
+{
+	return m_pData->voice(voice).state == MVS_STOPPED;
+}
+
+void Mixer::setPosition(MixerVoice voice, float xpos, float ypos, float zpos)
+	noexcept
+{
+	set3(m_pData->voice(voice).tblPosition, xpos, ypos, zpos);
+}
+
+void Mixer::setVelocity(MixerVoice voice, float xvel, float yvel, float zvel)
+	noexcept
+{
+	set3(m_pData->voice(voice).tblVelocity, xvel, yvel, zvel);
+}
+
+void Mixer::setDirection(MixerVoice voice, float xat, float yat, float zat)
+	noexcept
+{
+	set3(m_pData->voice(voice).tblDirection, xat, yat, zat);
+}
+
+void Mixer::setPitch(MixerVoice voice, float factor) noexcept
+{
+	m_pData->voice(voice).fPitch = factor;
+}
+
+void Mixer::setGain(MixerVoice voice, float fGain) noexcept
+{
+	m_pData->voice(voice).fGain = fGain;
+}
+
+void Mixer::setMaxDistance(MixerVoice voice, float fMaxDistance) noexcept
+{
+	m_pData->voice(voice).fMaxDistance = fMaxDistance;
+}
+
+void Mixer::setRollOffFactor(MixerVoice voice, float fRollOff) noexcept
+{
+	m_pData->voice(voice).fRollOff = fRollOff;
+}
+
+void Mixer::setReferenceDistance(MixerVoice voice, float fRefDistance)
+	noexcept
+{
+	m_pData->voice(voice).fRefDistance = fRefDistance;
+}
+
+void Mixer::setMinGain(MixerVoice voice, float fMinGain) noexcept
+{
+	m_pData->voice(voice).fMinGain = fMinGain;
+}
+
+void Mixer::setMaxGain(MixerVoice voice, float fMaxGain) noexcept
+{
+	m_pData->voice(voice).fMaxGain = fMaxGain;
+}
+
+void Mixer::setConeOuterGain(MixerVoice voice, float fConeOuterGain) noexcept
+{
+	m_pData->voice(voice).fConeOuterGain = fConeOuterGain;
+}
+
+void Mixer::setConeInnerAngle(MixerVoice voice, float fConeInnerAngle)
+	noexcept
+{
+	m_pData->voice(voice).fConeInnerAngle = fConeInnerAngle;
+}
+
+void Mixer::setConeOuterAngle(MixerVoice voice, float fConeOuterAngle)
+	noexcept
+{
+	m_pData->voice(voice).fConeOuterAngle = fConeOuterAngle;
+}
+
+void Mixer::setRelative(MixerVoice voice, bool isRelative) noexcept
+{
+	m_pData->voice(voice).isRelative = isRelative;
+}
+
+void Mixer::setOffset(MixerVoice voice, std::uint32_t sample) noexcept
+{
+	MixerVoiceData& data(m_pData->voice(voice));
+	data.position = std::min(sample, data.pBuffer->frames());
+}
+
+void Mixer::setAutoLoop(MixerVoice voice, bool isLooping) noexcept
+{
+	m_pData->voice(voice).isLooping = isLooping;
+}
+
+std::uint32_t Mixer::offset(MixerVoice voice) const noexcept
+{
+	return static_cast<std::uint32_t>(m_pData->voice(voice).position);
+}
+
+void Mixer::setListenerGain(float gain) noexcept
+{
+	m_pData->m_listener.fGain = gain;
+}
+
+void Mixer::setListenerPosition(float xpos, float ypos, float zpos) noexcept
+{
+	set3(m_pData->m_listener.tblPosition, xpos, ypos, zpos);
+}
+
+void Mixer::setListenerVelocity(float xvel, float yvel, float zvel) noexcept
+{
+	set3(m_pData->m_listener.tblVelocity, xvel, yvel, zvel);
+}
+
+void Mixer::setListenerOrientation(float xat, float yat, float zat,
+                                   float xup, float yup, float zup) noexcept
+{
+	set3(m_pData->m_listener.tblAt, xat, yat, zat);
+	set3(m_pData->m_listener.tblUp, xup, yup, zup);
+}
+
+void Mixer::setDopplerFactor(float factor) noexcept
+{
+	m_pData->m_listener.fDopplerFactor = factor;
+}
+
+void Mixer::setSpeedSound(float fSpeedSound) noexcept
+{
+	m_pData->m_listener.fSpeedSound = fSpeedSound;
+}
+
+void Mixer::setDistanceModel(DistanceModel model) noexcept
+{
+	assert(model < DM_LAST);
+	m_pData->m_listener.distanceModel = model;
+}
+
+} // namespace KA3D
@@ -0,0 +1,180 @@
+/**
+ *
+ * @file MixerBuffer.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les données audio du mixeur logiciel (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/MixerBuffer.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "KA3D/WaveFile.h"
+
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+MixerBuffer* MixerBuffer::fromData(const std::vector<std::uint8_t>& tblData,
+                                   DataFormat format, std::uint32_t freq)
+{
+	KA3D_PROFILE_SCOPE("MixerBuffer::fromData");
+	std::uint16_t channels(Data::formatChannels(format));
+	std::uint16_t bytesPerSample(Data::formatBytesPerSample(format));
+	std::uint32_t frames(tblData.size() / Data::formatPitch(format));
+	std::vector<float> tblSamples(frames * channels);
+
+	// Désentrelacement et conversion en flottants dans [-1, 1[
+	// (16 bits signés et flottants dans l'ordre natif, comme pour
+	// alBufferData)
+	for(std::uint16_t c=0; c<channels; ++c)
+	{
+		float* dst(tblSamples.data() + c*frames);
+		if(bytesPerSample == 1)
+		{
+			const std::uint8_t* src(tblData.data() + c);
+			for(std::uint32_t i=0; i<frames; ++i)
+				dst[i] = (static_cast<float>(src[i*channels]) - 128.f) / 128.f;
+		}
+		else if(bytesPerSample == 2)
+		{
+			const std::uint8_t* src(tblData.data() + 2*c);
+			for(std::uint32_t i=0; i<frames; ++i)
+			{
+				std::int16_t value;
+				std::memcpy(&value, src + 2*i*channels, sizeof(value));
+				dst[i] = static_cast<float>(value) / 32768.f;
+			}
+		}
+		else
+		{
+			assert(bytesPerSample == 4);
+			const std::uint8_t* src(tblData.data() + 4*c);
+			for(std::uint32_t i=0; i<frames; ++i)
+				std::memcpy(dst + i, src + 4*i*channels, sizeof(float));
+		}
+	}
+	return new MixerBuffer(std::move(tblSamples), channels, freq);
+}
+
+// Charge les données d'un fichier wave (cf. MixerBuffer::fromWav)
+static MixerBuffer* fromWave(WaveFile& waveFile)
+{
+	std::vector<std::uint8_t> tblData;
+	DataFormat format;
+	std::uint32_t freq;
+
+	waveFile.open(std::ios_base::in);
+
+	format = waveFile.format();
+	freq = waveFile.samplesPerSec();
+	tblData.resize(waveFile.size());
+
+	waveFile.read(tblData.data(), waveFile.size());
+
+	waveFile.close();
+
+	std::unique_ptr<MixerBuffer> pBuffer(
+		MixerBuffer::fromData(tblData, format, freq));
+	if(waveFile.hasLoop())
+		pBuffer->setLoopPoints(waveFile.loopStart(), waveFile.loopEnd());
+	return pBuffer.release();
+}
+
+MixerBuffer* MixerBuffer::fromWav(std::iostream& file)
+{
+	WaveFile waveFile(file);
+	return fromWave(waveFile);
+}
+
+MixerBuffer* MixerBuffer::fromWav(Reader& reader)
+{
+	WaveFile waveFile(reader);
+	return fromWave(waveFile);
+}
+
+MixerBuffer::MixerBuffer(std::vector<float> tblSamples,
+                         std::uint16_t channels, std::uint32_t freq):
+	m_tblSamples(std::move(tblSamples)),
+	m_uChannels(channels),
+	m_uFrames(channels ? m_tblSamples.size() / channels : 0),
+	m_uFrequency(freq),
+	m_uLoopStart(0),
+	m_uLoopEnd(m_uFrames)
+{
+	if(channels == 0 || freq == 0)
+		throw std::runtime_error("Invalid mixer buffer format");
+}
+
+MixerBuffer::~MixerBuffer() noexcept
+{ }
+
+const float* MixerBuffer::channel(std::uint16_t channel) const noexcept
+{
+	assert(channel < m_uChannels);
+	return m_tblSamples.data() + channel*m_uFrames;
+}
+
+std::uint16_t MixerBuffer::channels() const noexcept
+{
+	return m_uChannels;
+}
+
+std::uint32_t MixerBuffer::frames() const noexcept
+{
+	return m_uFrames;
+}
+
+std::uint32_t MixerBuffer::frequency() const noexcept
+{
+	return m_uFrequency;
+}
+
+void MixerBuffer::setLoopPoints(std::uint32_t start, std::uint32_t end)
+{
+	if(start >= end || end > m_uFrames)
+		throw std::runtime_error("Unable to set loop points: "
+		                         "invalid loop");
+	m_uLoopStart = start;
+	m_uLoopEnd = end;
+}
+
+std::uint32_t MixerBuffer::loopStart() const noexcept
+{
+	return m_uLoopStart;
+}
+
+std::uint32_t MixerBuffer::loopEnd() const noexcept
+{
+	return m_uLoopEnd;
+}
+
+} // namespace KA3D
@@ -0,0 +1,249 @@
+#ifndef MIXERPRIVATE_H_INCLUDED
+#define MIXERPRIVATE_H_INCLUDED
+/**
+ *
+ * @file MixerPrivate.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'état interne du mixeur logiciel (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <vector>
+
+#include "KA3D/Listener.h"
+#include "KA3D/Mixer.h"
+#include "KA3D/MixerBuffer.h"
+#include "KA3D/MixerEffect.h"
+
+namespace KA3D
+{
+
+//! Nombre maximal de canaux (données et sortie) du mixeur
+constexpr std::uint16_t MIXER_MAX_CHANNELS = 2;
+//! Ordre ambisonique maximal du bus intermédiaire
+constexpr std::uint16_t MIXER_MAX_AMBISONIC_ORDER = 3;
+//! Nombre de canaux ambisoniques à l'ordre maximal ((ordre+1)²)
+constexpr std::uint16_t MIXER_MAX_AMBISONIC_CHANNELS = 16;
+//! Nombre de voix par lot de mixage (unité de travail des fils)
+constexpr std::uint32_t MIXER_BATCH_VOICES = 16;
+
+class WorkStealingPool;
+
+//! Atténuation par déclenchement entre deux groupes de voix
+struct MixerDucking
+{
+	Ducker* pDucker; //!< Enveloppe
+	std::uint16_t trigger; //!< Groupe déclencheur
+	std::uint16_t target; //!< Groupe atténué
+};
+
+//! État de lecture d'une voix (mêmes valeurs qu'OpenAL)
+enum MixerVoiceState {
+	MVS_INITIAL, //!< Jamais lue, ou remise au début
+	MVS_PLAYING, //!< En cours de lecture
+	MVS_PAUSED, //!< En pause
+	MVS_STOPPED //!< Stoppée (ou fin des données atteinte)
+};
+
+//! Paramètres et état de lecture d'une voix
+struct MixerVoiceData
+{
+	const MixerBuffer* pBuffer; //!< Données lues (nullptr : voix libre)
+	MixerVoiceState state; //!< État de lecture
+	double position; //!< Position de lecture (en échantillons source)
+
+	float fGain; //!< Volume
+	float fPitch; //!< Facteur du pitch
+	float fMinGain; //!< Volume minimum après atténuation
+	float fMaxGain; //!< Volume maximum après atténuation
+	float fRefDistance; //!< Distance de référence
+	float fMaxDistance; //!< Distance maximale
+	float fRollOff; //!< Facteur d'atténuation
+	float fConeInnerAngle; //!< Angle du cône intérieur (degrés)
+	float fConeOuterAngle; //!< Angle du cône extérieur (degrés)
+	float fConeOuterGain; //!< Volume à l'extérieur du cône
+	float tblPosition[3]; //!< Position
+	float tblVelocity[3]; //!< Vecteur vitesse
+	float tblDirection[3]; //!< Direction (nulle : omnidirectionnelle)
+	bool isRelative; //!< Position relative à l'écouteur
+	bool isLooping; //!< Rebouclage à la fin des données
+	std::uint16_t group; //!< Groupe de la voix (cf. Mixer::setVoiceGroup)
+	float fEnergy; //!< Énergie moyenne du dernier bloc (carré du RMS)
+
+	//! Gains appliqués à la fin du bloc précédent [canal source][sortie]
+	float tblLastGain[MIXER_MAX_CHANNELS][MIXER_MAX_CHANNELS];
+	//! Gains d'encodage ambisonique appliqués à la fin du bloc précédent
+	float tblLastAmbiGain[MIXER_MAX_AMBISONIC_CHANNELS];
+	bool hasLastGain; //!< Les gains précédents sont valides (sinon pas de rampe)
+
+	//! Remet les paramètres à leurs valeurs par défaut (cf. OpenAL)
+	void reset(const MixerBuffer* pNewBuffer) noexcept;
+};
+
+//! Paramètres de l'écouteur du mixeur
+struct MixerListenerData
+{
+	float fGain; //!< Volume général
+	float tblPosition[3]; //!< Position
+	float tblVelocity[3]; //!< Vecteur vitesse
+	float tblAt[3]; //!< Direction
+	float tblUp[3]; //!< Axe vertical
+	float fDopplerFactor; //!< Facteur de l'effet doppler
+	float fSpeedSound; //!< Vitesse du son
+	DistanceModel distanceModel; //!< Modèle d'atténuation
+};
+
+/**
+ * @brief Données interne du mixeur logiciel (cf. #Mixer)
+ */
+class MixerPrivate
+{
+public:
+	/**
+	 * @brief Constructeur
+	 * @param frequency Fréquence de la sortie
+	 * @param channels Nombre de canaux de la sortie
+	 * @param blockSize Taille maximale d'un bloc
+	 */
+	MixerPrivate(std::uint32_t frequency, std::uint16_t channels,
+	             std::uint32_t blockSize);
+	/**
+	 * @brief Destructeur (arrête les fils de mixage)
+	 */
+	~MixerPrivate() noexcept;
+
+	/**
+	 * @brief Calcule les gains et le pas de lecture d'une voix pour un bloc
+	 * @param voice Voix à spatialiser
+	 * @param[out] tblGain Gains cibles [canal source][sortie]
+	 * @param[out] tblAmbiGain Gains cibles d'encodage ambisonique
+	 * (voix mono, si le bus ambisonique est actif)
+	 * @return Pas de lecture (pitch × doppler × rapport des fréquences)
+	 */
+	double spatialize(const MixerVoiceData& voice,
+	                  float tblGain[MIXER_MAX_CHANNELS][MIXER_MAX_CHANNELS],
+	                  float tblAmbiGain[MIXER_MAX_AMBISONIC_CHANNELS])
+		const noexcept;
+	/**
+	 * @brief Mixe un bloc d'une voix en lecture dans un bus
+	 * @param voice Voix à mixer (position et état avancés)
+	 * @param pBus Bus planaire (m_uBusChannels × blockSize) : canaux de
+	 * sortie suivis des canaux ambisoniques
+	 * @param pScratch Mémoire de travail (MIXER_MAX_CHANNELS × blockSize)
+	 * @param frames Nombre d'échantillons du bloc
+	 */
+	void mixVoice(MixerVoiceData& voice, float* pBus, float* pScratch,
+	              std::uint32_t frames) const noexcept;
+	/**
+	 * @brief Mixe un lot de voix en lecture dans son bus partiel
+	 * Le lot 0 est mixé directement dans le bus de sortie
+	 * @param batch Numéro du lot (cf. #MIXER_BATCH_VOICES)
+	 * @param worker Numéro du fil (choix de la mémoire de travail)
+	 */
+	void mixBatch(std::uint32_t batch, std::uint32_t worker) noexcept;
+	/**
+	 * @brief Mixe un bloc de toutes les voix en lecture dans le bus de sortie
+	 * Le résultat ne dépend pas du nombre de fils : chaque lot est mixé
+	 * dans son propre bus, puis les bus sont sommés dans l'ordre des lots
+	 * @param frames Nombre d'échantillons du bloc
+	 */
+	void mixBlock(std::uint32_t frames);
+	/**
+	 * @brief Mesure le niveau des groupes et fait avancer les atténuations
+	 * @param frames Nombre d'échantillons du bloc
+	 */
+	void updateGroups(std::uint32_t frames) noexcept;
+	/**
+	 * @brief Décode le bus ambisonique dans les canaux de sortie du bus
+	 * @param frames Nombre d'échantillons du bloc
+	 */
+	void decodeAmbisonic(std::uint32_t frames) noexcept;
+	/**
+	 * @brief Change l'ordre du bus ambisonique (0 : désactivé)
+	 * Redimensionne les bus et remet la matrice de décodage par défaut
+	 */
+	void setAmbisonicOrder(std::uint16_t order);
+	/**
+	 * @brief Permet d'obtenir une voix à partir de son identifiant
+	 */
+	MixerVoiceData& voice(MixerVoice id) noexcept;
+
+public:
+	std::uint32_t m_uFrequency; //!< Fréquence de la sortie
+	std::uint16_t m_uChannels; //!< Nombre de canaux de la sortie
+	std::uint32_t m_uBlockSize; //!< Taille maximale d'un bloc
+	std::uint16_t m_uAmbiOrder; //!< Ordre ambisonique (0 : désactivé)
+	std::uint16_t m_uAmbiChannels; //!< Nombre de canaux ambisoniques
+	std::uint16_t m_uBusChannels; //!< Canaux de sortie + ambisoniques
+	//! Matrice de décodage [sortie][canal ambisonique]
+	std::vector<float> m_tblDecoder;
+
+	std::vector<MixerVoiceData> m_tblVoices; //!< Voix (indice = id - 1)
+	std::vector<MixerVoice> m_tblFreeVoices; //!< Identifiants libres
+	MixerListenerData m_listener; //!< Paramètres de l'écouteur
+
+	std::vector<float> m_tblBus; //!< Bus de sortie et ambisonique (planaire)
+	std::vector<float> m_tblPartialBus; //!< Bus des lots 1 à n (planaires)
+	std::vector<float> m_tblScratch; //!< Mémoire de travail de chaque fil
+	std::vector<std::uint32_t> m_tblActive; //!< Voix en lecture (indices)
+	std::uint32_t m_uBlockFrames; //!< Taille du bloc en cours de mixage
+	WorkStealingPool* m_pPool; //!< Fils de mixage (nullptr : fil appelant)
+	std::vector<float> m_tblOutput; //!< Sortie entrelacée de #Mixer::process
+
+	std::vector<MixerEffect*> m_tblEffects; //!< Effets du bus de sortie
+
+	float m_tblGroupGain[Mixer::GROUP_COUNT]; //!< Volume de chaque groupe
+	float m_tblDuckGain[Mixer::GROUP_COUNT]; //!< Atténuation de chaque groupe
+	float m_tblGroupLevel[Mixer::GROUP_COUNT]; //!< Niveau RMS de chaque groupe
+	std::vector<MixerDucking> m_tblDuckers; //!< Atténuations par groupe
+
+	MixerCallback m_callback; //!< Fonction recevant le signal
+	void* m_pUserData; //!< Donnée de la fonction de rappel
+};
+
+/**
+ * @brief Calcule le facteur d'atténuation avec la distance
+ * @param model Modèle d'atténuation (cf. #DistanceModel)
+ * @param dist Distance entre la voix et l'écouteur
+ * @param ref Distance de référence
+ * @param max Distance maximale
+ * @param rollOff Facteur d'atténuation
+ */
+float mixerDistanceGain(DistanceModel model, float dist, float ref,
+                        float max, float rollOff) noexcept;
+/**
+ * @brief Calcule les coefficients d'encodage ambisonique d'une direction
+ * Harmoniques sphériques réelles, ordre ACN, normalisation SN3D (AmbiX)
+ * @param order Ordre ambisonique (1 à #MIXER_MAX_AMBISONIC_ORDER)
+ * @param x Composante avant de la direction (unitaire)
+ * @param y Composante gauche de la direction
+ * @param z Composante haut de la direction
+ * @param[out] tblCoeff Coefficients ((order+1)² valeurs)
+ */
+void mixerEncodeAmbisonic(std::uint16_t order, float x, float y, float z,
+                          float* tblCoeff) noexcept;
+
+} // namespace KA3D
+
+#endif // MIXERPRIVATE_H_INCLUDED
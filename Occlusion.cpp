@@ -0,0 +1,301 @@
+/**
+ *
+ * @file Occlusion.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'occultation des sources par le décor (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Occlusion.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Extensions.h"
+
+#include <AL/al.h>
+
+#include "Context.h"
+#include "Error.h"
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+//! Écart de volume en dessous duquel un filtre n'est pas renvoyé
+const float FILTER_EPSILON = 1e-3f;
+
+static inline const Extensions& efx()
+{
+	Context* pContext(Context::current());
+	if(!pContext || !pContext->extensions().alGenFilters)
+		throw std::runtime_error("ALC_EXT_EFX not supported");
+	return pContext->extensions();
+}
+
+bool Occlusion::isSupported() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().alGenFilters;
+}
+
+Occlusion::Occlusion(const RayQuery& query, std::uint32_t budget):
+	m_query(query),
+	m_uBudget(std::max<std::uint32_t>(budget, 1)),
+	m_uCursor(0),
+	m_fSmoothing(0.1f),
+	m_fOcclusionGain(0.4f),
+	m_fOcclusionGainHF(0.1f),
+	m_fObstructionGainHF(0.25f),
+	m_tblEntries(),
+	m_tblFilters(),
+	m_stats()
+{ }
+
+Occlusion::~Occlusion() noexcept
+{ }
+
+void Occlusion::Init(std::uint32_t maxSources)
+{
+	KA3D_PROFILE_SCOPE("Occlusion::Init");
+	ContextLock contextLock;
+	try
+	{
+		const Extensions& ext(efx());
+		std::vector<ALuint> tblFilters(maxSources);
+
+		// Un seul appel au pilote pour tous les filtres
+		ext.alGenFilters(static_cast<ALsizei>(maxSources), tblFilters.data());
+		checkALError();
+		for(ALuint filter : tblFilters)
+			ext.alFilteri(filter, AL_FILTER_TYPE, AL_FILTER_LOWPASS);
+		if(alGetError() != AL_NO_ERROR)
+		{
+			ext.alDeleteFilters(static_cast<ALsizei>(maxSources),
+			                    tblFilters.data());
+			throw std::runtime_error("Low-pass filter not supported");
+		}
+
+		m_tblFilters.assign(tblFilters.begin(), tblFilters.end());
+		Entry empty = {nullptr, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, false, 0};
+		m_tblEntries.assign(maxSources, empty);
+		m_uCursor = 0;
+	}
+	catch(std::exception& e)
+	{
+		throw std::runtime_error(std::string("Unable to initialize occlusion: ")
+		                         + e.what());
+	}
+}
+
+void Occlusion::Quit()
+{
+	ContextLock contextLock;
+	if(m_tblFilters.empty())
+		return;
+	for(std::uint32_t id=0; id<m_tblEntries.size(); ++id)
+		if(m_tblEntries[id].pSource)
+			remove(id);
+
+	std::vector<ALuint> tblNames(m_tblFilters.begin(), m_tblFilters.end());
+	efx().alDeleteFilters(static_cast<ALsizei>(tblNames.size()),
+	                      tblNames.data());
+	m_tblFilters.clear();
+	m_tblEntries.clear();
+	checkALError();
+}
+
+void Occlusion::setBudget(std::uint32_t budget) noexcept
+{
+	m_uBudget = std::max<std::uint32_t>(budget, 1);
+}
+
+std::uint32_t Occlusion::budget() const noexcept
+{
+	return m_uBudget;
+}
+
+void Occlusion::setSmoothing(float fTime) noexcept
+{
+	m_fSmoothing = std::max(fTime, 0.f);
+}
+
+void Occlusion::setOcclusionFilter(float fGain, float fGainHF) noexcept
+{
+	m_fOcclusionGain = fGain;
+	m_fOcclusionGainHF = fGainHF;
+}
+
+void Occlusion::setObstructionFilter(float fGainHF) noexcept
+{
+	m_fObstructionGainHF = fGainHF;
+}
+
+std::uint32_t Occlusion::add(Source& source)
+{
+	for(std::uint32_t id=0; id<m_tblEntries.size(); ++id)
+	{
+		Entry& entry(m_tblEntries[id]);
+		if(!entry.pSource)
+		{
+			Entry init = {&source, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, false, 0};
+			entry = init;
+			return id;
+		}
+	}
+	throw std::runtime_error("Unable to add occluded source: "
+	                         "no filter available");
+}
+
+void Occlusion::remove(std::uint32_t id)
+{
+	ContextLock contextLock;
+	Entry& entry(m_tblEntries[id]);
+	if(entry.isFiltered && entry.pSource->isInitialized() &&
+	   entry.pSource->handle() == entry.uHandle)
+	{
+		alSourcei(entry.pSource->handle(), AL_DIRECT_FILTER, AL_FILTER_NULL);
+		checkALError();
+	}
+	entry.pSource = nullptr;
+	entry.isFiltered = false;
+}
+
+float Occlusion::occlusion(std::uint32_t id) const noexcept
+{
+	return m_tblEntries[id].fOcclusion;
+}
+
+float Occlusion::obstruction(std::uint32_t id) const noexcept
+{
+	return m_tblEntries[id].fObstruction;
+}
+
+void Occlusion::update(float xpos, float ypos, float zpos, float fDelta)
+{
+	KA3D_PROFILE_SCOPE("Occlusion::update");
+	ContextLock contextLock;
+	const float tblListener[3] = {xpos, ypos, zpos};
+	const std::uint32_t count(static_cast<std::uint32_t>(m_tblEntries.size()));
+	m_stats.uQueries = 0;
+	m_stats.uBudget = m_uBudget;
+	m_stats.uSources = 0;
+	m_stats.uFilterUpdates = 0;
+
+	// Requêtes à tour de rôle, dans la limite du budget
+	for(std::uint32_t i=0; i<count && m_stats.uQueries<m_uBudget; ++i)
+	{
+		Entry& entry(m_tblEntries[m_uCursor]);
+		m_uCursor = (m_uCursor + 1) % count;
+		if(!entry.pSource || !entry.pSource->isInitialized())
+			continue;
+
+		float tblSource[3];
+		entry.pSource->position(tblSource[0], tblSource[1], tblSource[2]);
+		if(entry.pSource->isRelative())
+			for(int axis=0; axis<3; ++axis)
+				tblSource[axis] += tblListener[axis];
+		m_query(tblListener, tblSource,
+		        entry.fTargetOcclusion, entry.fTargetObstruction);
+		KA3D_PROFILE_COUNT(PC_OCCLUSION_QUERY);
+		++m_stats.uQueries;
+	}
+
+	// Lissage exponentiel vers la dernière mesure
+	float fBlend(m_fSmoothing > 0.f ?
+	             1.f - std::exp(-std::max(fDelta, 0.f) / m_fSmoothing) : 1.f);
+	for(std::uint32_t id=0; id<count; ++id)
+	{
+		Entry& entry(m_tblEntries[id]);
+		if(!entry.pSource || !entry.pSource->isInitialized())
+			continue;
+		++m_stats.uSources;
+		entry.fOcclusion += (entry.fTargetOcclusion - entry.fOcclusion) * fBlend;
+		entry.fObstruction += (entry.fTargetObstruction - entry.fObstruction)
+		                      * fBlend;
+		if(applyFilter(id))
+			++m_stats.uFilterUpdates;
+	}
+}
+
+const OcclusionStats& Occlusion::stats() const noexcept
+{
+	return m_stats;
+}
+
+bool Occlusion::applyFilter(std::uint32_t id)
+{
+	Entry& entry(m_tblEntries[id]);
+	// Source réinitialisée : l'ancienne a été rendue sans filtre
+	if(entry.isFiltered && entry.pSource->handle() != entry.uHandle)
+	{
+		entry.isFiltered = false;
+		entry.fGain = entry.fGainHF = 1.f;
+	}
+	float fOcclusion(std::min(std::max(entry.fOcclusion, 0.f), 1.f));
+	float fObstruction(std::min(std::max(entry.fObstruction, 0.f), 1.f));
+	float fGain(1.f - fOcclusion * (1.f - m_fOcclusionGain));
+	float fGainHF((1.f - fOcclusion * (1.f - m_fOcclusionGainHF))
+	              * (1.f - fObstruction * (1.f - m_fObstructionGainHF)));
+
+	// Filtre neutre : détaché plutôt que calculé par le pilote
+	bool isNeutral(fGain > 1.f - FILTER_EPSILON &&
+	               fGainHF > 1.f - FILTER_EPSILON);
+	if(isNeutral)
+	{
+		if(!entry.isFiltered)
+			return false;
+		alSourcei(entry.pSource->handle(), AL_DIRECT_FILTER, AL_FILTER_NULL);
+		checkALError();
+		entry.isFiltered = false;
+		entry.fGain = entry.fGainHF = 1.f;
+		return true;
+	}
+	if(entry.isFiltered &&
+	   std::fabs(fGain - entry.fGain) < FILTER_EPSILON &&
+	   std::fabs(fGainHF - entry.fGainHF) < FILTER_EPSILON)
+	{
+		return false;
+	}
+
+	// Les paramètres du filtre sont copiés dans la source à l'attachement
+	const Extensions& ext(efx());
+	ALuint filter(m_tblFilters[id]);
+	ext.alFilterf(filter, AL_LOWPASS_GAIN, fGain);
+	ext.alFilterf(filter, AL_LOWPASS_GAINHF, fGainHF);
+	alSourcei(entry.pSource->handle(), AL_DIRECT_FILTER,
+	          static_cast<ALint>(filter));
+	checkALError();
+	entry.isFiltered = true;
+	entry.uHandle = entry.pSource->handle();
+	entry.fGain = fGain;
+	entry.fGainHF = fGainHF;
+	return true;
+}
+
+} // namespace KA3D
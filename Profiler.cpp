@@ -0,0 +1,360 @@
+/**
+ *
+ * @file Profiler.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant le profilage interne de la bibliothèque (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/Profiler.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+#ifdef KA3D_PROFILING
+
+static const char* tblCounterName[] = {
+	"al_error_check",
+	"source_state",
+	"source_set",
+	"source_get",
+	"listener_set",
+	"listener_get",
+	"sound_play",
+	"buffer_upload",
+	"buffer_upload_bytes",
+	"wave_read_bytes",
+	"wave_write_bytes",
+	"occlusion_query"
+};
+static_assert(sizeof(tblCounterName)/sizeof(tblCounterName[0]) == PC_LAST,
+              "Missing profile counter name");
+
+//! Nombre maximum d'événements enregistrés par thread
+const std::size_t MAX_EVENTS_PER_THREAD = 1 << 16;
+//! Nombre maximum d'images conservées (les plus anciennes sont oubliées)
+const std::size_t MAX_FRAMES = 1 << 14;
+
+//! Événement de portée
+struct ProfileEvent
+{
+	const char* szName; //!< Nom de la portée
+	std::int64_t iStart; //!< Début en nanosecondes
+	std::int64_t iDuration; //!< Durée en nanosecondes
+};
+
+//! Mesures d'un thread (écrites uniquement par ce thread)
+struct ThreadProfile
+{
+	std::uint32_t uId; //!< Numéro du thread dans la trace
+	std::atomic<std::uint64_t> tblCounters[PC_LAST]; //!< Compteurs
+	std::uint64_t tblBaseline[PC_LAST]; //!< Compteurs au reset (verrou)
+	std::unique_ptr<ProfileEvent[]> tblEvents; //!< Événements
+	std::atomic<std::size_t> uEvents; //!< Nombre d'événements publiés
+	std::atomic<std::uint32_t> uEpoch; //!< Génération des événements
+};
+
+//! Compteurs d'une image
+struct ProfileFrame
+{
+	std::int64_t iTime; //!< Fin de l'image en nanosecondes
+	std::uint64_t tblCounters[PC_LAST]; //!< Valeurs pendant l'image
+};
+
+static std::mutex mtxProfiler;
+static std::vector<std::shared_ptr<ThreadProfile> > tblThreads;
+static std::deque<ProfileFrame> tblFrames;
+static std::uint64_t uFrameCount(0); //!< Images depuis le reset
+static std::uint64_t tblLastTotals[PC_LAST];
+static std::atomic<std::uint32_t> uEpoch(0);
+
+static std::int64_t profileNow() noexcept
+{
+	using namespace std::chrono;
+	static const steady_clock::time_point origin(steady_clock::now());
+	return duration_cast<nanoseconds>(steady_clock::now() - origin).count();
+}
+
+static std::shared_ptr<ThreadProfile> registerThread()
+{
+	std::shared_ptr<ThreadProfile> pProfile(new ThreadProfile);
+	for(auto& counter : pProfile->tblCounters)
+		counter.store(0, std::memory_order_relaxed);
+	for(auto& baseline : pProfile->tblBaseline)
+		baseline = 0;
+	pProfile->uEvents.store(0, std::memory_order_relaxed);
+	pProfile->uEpoch.store(uEpoch.load(std::memory_order_relaxed),
+	                       std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> lock(mtxProfiler);
+	pProfile->uId = static_cast<std::uint32_t>(tblThreads.size());
+	tblThreads.push_back(pProfile);
+	return pProfile;
+}
+
+static ThreadProfile& threadProfile()
+{
+	thread_local std::shared_ptr<ThreadProfile> pProfile(registerThread());
+	return *pProfile;
+}
+
+void profileCount(ProfileCounter counter, std::uint64_t n) noexcept
+{
+	// Un seul écrivain par compteur : pas d'opération atomique composée
+	std::atomic<std::uint64_t>& value(threadProfile().tblCounters[counter]);
+	value.store(value.load(std::memory_order_relaxed) + n,
+	            std::memory_order_relaxed);
+}
+
+ProfileScope::ProfileScope(const char* szName) noexcept:
+	m_szName(szName),
+	m_iStart(profileNow())
+{ }
+
+ProfileScope::~ProfileScope() noexcept
+{
+	std::int64_t iEnd(profileNow());
+	ThreadProfile& profile(threadProfile());
+
+	// Événements vidés avant de publier la génération : un lecteur qui
+	// la voit ne lit pas les événements de la précédente
+	std::uint32_t uCurrentEpoch(uEpoch.load(std::memory_order_acquire));
+	if(profile.uEpoch.load(std::memory_order_relaxed) != uCurrentEpoch)
+	{
+		profile.uEvents.store(0, std::memory_order_relaxed);
+		profile.uEpoch.store(uCurrentEpoch, std::memory_order_release);
+	}
+
+	std::size_t uCount(profile.uEvents.load(std::memory_order_relaxed));
+	if(uCount >= MAX_EVENTS_PER_THREAD)
+		return;
+	if(!profile.tblEvents)
+		profile.tblEvents.reset(new ProfileEvent[MAX_EVENTS_PER_THREAD]);
+
+	profile.tblEvents[uCount].szName = m_szName;
+	profile.tblEvents[uCount].iStart = m_iStart;
+	profile.tblEvents[uCount].iDuration = iEnd - m_iStart;
+	profile.uEvents.store(uCount + 1, std::memory_order_release);
+}
+
+// Somme des compteurs de tous les threads depuis le reset (verrou détenu)
+static void counterTotals(std::uint64_t* tblTotals)
+{
+	for(std::size_t i=0; i<PC_LAST; ++i)
+		tblTotals[i] = 0;
+	for(const auto& pProfile : tblThreads)
+		for(std::size_t i=0; i<PC_LAST; ++i)
+			tblTotals[i] += pProfile->tblCounters[i].load(
+				std::memory_order_relaxed) - pProfile->tblBaseline[i];
+}
+
+// Nombre d'événements valides d'un thread (verrou détenu)
+static std::size_t eventCount(const ThreadProfile& profile)
+{
+	if(profile.uEpoch.load(std::memory_order_acquire) !=
+	   uEpoch.load(std::memory_order_acquire))
+		return 0;
+	return profile.uEvents.load(std::memory_order_acquire);
+}
+
+bool Profiler::isEnabled() noexcept
+{
+	return true;
+}
+
+void Profiler::frame()
+{
+	std::lock_guard<std::mutex> lock(mtxProfiler);
+	ProfileFrame frame;
+	std::uint64_t tblTotals[PC_LAST];
+	counterTotals(tblTotals);
+
+	frame.iTime = profileNow();
+	for(std::size_t i=0; i<PC_LAST; ++i)
+	{
+		frame.tblCounters[i] = tblTotals[i] - tblLastTotals[i];
+		tblLastTotals[i] = tblTotals[i];
+	}
+	tblFrames.push_back(frame);
+	if(tblFrames.size() > MAX_FRAMES)
+		tblFrames.pop_front();
+	++uFrameCount;
+}
+
+void Profiler::reset()
+{
+	std::lock_guard<std::mutex> lock(mtxProfiler);
+	// Les compteurs n'appartiennent qu'à leur thread : seule leur valeur
+	// de départ est relevée
+	for(const auto& pProfile : tblThreads)
+		for(std::size_t i=0; i<PC_LAST; ++i)
+			pProfile->tblBaseline[i] = pProfile->tblCounters[i].load(
+				std::memory_order_relaxed);
+	for(auto& total : tblLastTotals)
+		total = 0;
+	tblFrames.clear();
+	uFrameCount = 0;
+	uEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void Profiler::writeChromeTrace(std::ostream& out)
+{
+	std::lock_guard<std::mutex> lock(mtxProfiler);
+	const char* szSeparator("\n");
+
+	out << "{\"traceEvents\":[";
+	out << std::fixed << std::setprecision(3);
+	for(const auto& pProfile : tblThreads)
+	{
+		std::size_t uCount(eventCount(*pProfile));
+		for(std::size_t i=0; i<uCount; ++i)
+		{
+			const ProfileEvent& event(pProfile->tblEvents[i]);
+			out << szSeparator
+			    << "{\"name\":\"" << event.szName << "\",\"cat\":\"KA3D\","
+			    << "\"ph\":\"X\",\"pid\":1,\"tid\":" << pProfile->uId << ","
+			    << "\"ts\":" << event.iStart/1000. << ","
+			    << "\"dur\":" << event.iDuration/1000. << "}";
+			szSeparator = ",\n";
+		}
+	}
+	for(const ProfileFrame& frame : tblFrames)
+	{
+		out << szSeparator
+		    << "{\"name\":\"KA3D counters\",\"ph\":\"C\",\"pid\":1,"
+		    << "\"ts\":" << frame.iTime/1000. << ",\"args\":{";
+		for(std::size_t i=0; i<PC_LAST; ++i)
+		{
+			out << (i ? "," : "") << "\"" << tblCounterName[i] << "\":"
+			    << frame.tblCounters[i];
+		}
+		out << "}}";
+		szSeparator = ",\n";
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Profiler::writeSummary(std::ostream& out)
+{
+	std::lock_guard<std::mutex> lock(mtxProfiler);
+	std::uint64_t tblTotals[PC_LAST];
+	counterTotals(tblTotals);
+
+	out << "KA3D profile: " << uFrameCount << " frame(s)\n";
+	out << std::left << std::setw(24) << "counter"
+	    << std::right << std::setw(14) << "total"
+	    << std::setw(14) << "last frame"
+	    << std::setw(14) << "per frame" << "\n";
+	for(std::size_t i=0; i<PC_LAST; ++i)
+	{
+		double perFrame(uFrameCount == 0 ? 0. :
+			static_cast<double>(tblLastTotals[i]) / uFrameCount);
+		out << std::left << std::setw(24) << tblCounterName[i]
+		    << std::right << std::setw(14) << tblTotals[i]
+		    << std::setw(14)
+		    << (tblFrames.empty() ? 0 : tblFrames.back().tblCounters[i])
+		    << std::setw(14) << std::fixed << std::setprecision(1)
+		    << perFrame << "\n";
+	}
+
+	// Temps cumulé par portée
+	struct ScopeTotal
+	{
+		std::uint64_t uCount;
+		std::int64_t iTotal;
+		std::int64_t iMax;
+	};
+	// Clé par contenu : un même nom peut avoir plusieurs adresses
+	std::map<std::string, ScopeTotal> tblScopes;
+	for(const auto& pProfile : tblThreads)
+	{
+		std::size_t uCount(eventCount(*pProfile));
+		for(std::size_t i=0; i<uCount; ++i)
+		{
+			const ProfileEvent& event(pProfile->tblEvents[i]);
+			ScopeTotal& total(tblScopes[event.szName]);
+			++total.uCount;
+			total.iTotal += event.iDuration;
+			if(event.iDuration > total.iMax)
+				total.iMax = event.iDuration;
+		}
+	}
+
+	out << std::left << std::setw(24) << "scope"
+	    << std::right << std::setw(14) << "calls"
+	    << std::setw(14) << "total (ms)"
+	    << std::setw(14) << "mean (us)"
+	    << std::setw(14) << "max (us)" << "\n";
+	for(const auto& scope : tblScopes)
+	{
+		const ScopeTotal& total(scope.second);
+		out << std::left << std::setw(24) << scope.first
+		    << std::right << std::setw(14) << total.uCount
+		    << std::setw(14) << std::setprecision(3) << total.iTotal/1e6
+		    << std::setw(14) << std::setprecision(1)
+		    << total.iTotal/1e3/total.uCount
+		    << std::setw(14) << total.iMax/1e3 << "\n";
+	}
+}
+
+#else // KA3D_PROFILING
+
+bool Profiler::isEnabled() noexcept
+{
+	return false;
+}
+
+void Profiler::frame()
+{ }
+
+void Profiler::reset()
+{ }
+
+void Profiler::writeChromeTrace(std::ostream& out)
+{
+	out << "{\"traceEvents\":[],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Profiler::writeSummary(std::ostream& out)
+{
+	out << "KA3D profile: disabled (build with KA3D_PROFILING)\n";
+}
+
+#endif // KA3D_PROFILING
+
+} // namespace KA3D
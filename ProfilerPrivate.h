@@ -0,0 +1,93 @@
+#ifndef PROFILERPRIVATE_H_INCLUDED
+#define PROFILERPRIVATE_H_INCLUDED
+/**
+ *
+ * @file ProfilerPrivate.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les points de mesure du profilage (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace KA3D
+{
+
+//! Compteurs de profilage
+enum ProfileCounter {
+	PC_AL_ERROR_CHECK, //!< Vérifications d'erreur AL/ALC
+	PC_SOURCE_STATE, //!< Lecture, pause, arrêt d'une source
+	PC_SOURCE_SET, //!< Modification d'un paramètre de source
+	PC_SOURCE_GET, //!< Lecture d'un paramètre de source
+	PC_LISTENER_SET, //!< Modification d'un paramètre de l'écouteur
+	PC_LISTENER_GET, //!< Lecture d'un paramètre de l'écouteur
+	PC_SOUND_PLAY, //!< Lecture d'un son
+	PC_BUFFER_UPLOAD, //!< Envoi de données audio (alBufferData)
+	PC_BUFFER_UPLOAD_BYTES, //!< Octets envoyés
+	PC_WAVE_READ_BYTES, //!< Octets audio lus dans un wave
+	PC_WAVE_WRITE_BYTES, //!< Octets audio écrits dans un wave
+	PC_OCCLUSION_QUERY, //!< Requêtes de rayon de l'occultation
+
+	PC_LAST //!< Borne de fin
+};
+
+#ifdef KA3D_PROFILING
+
+/**
+ * @brief Chronomètre de portée (enregistre un événement à la destruction)
+ */
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* szName) noexcept;
+	ProfileScope(const ProfileScope& ) = delete;
+	ProfileScope& operator=(const ProfileScope& ) = delete;
+	~ProfileScope() noexcept;
+
+private:
+	const char* m_szName; //!< Nom de la portée (chaîne littérale)
+	std::int64_t m_iStart; //!< Début en nanosecondes
+};
+
+//! Incrémente un compteur du thread courant (sans verrou)
+void profileCount(ProfileCounter counter, std::uint64_t n = 1) noexcept;
+
+#  define KA3D_PROFILE_CONCAT2(A, B) A##B
+#  define KA3D_PROFILE_CONCAT(A, B) KA3D_PROFILE_CONCAT2(A, B)
+#  define KA3D_PROFILE_SCOPE(NAME) \
+	::KA3D::ProfileScope KA3D_PROFILE_CONCAT(profileScope, __LINE__)(NAME)
+#  define KA3D_PROFILE_COUNT(COUNTER) \
+	::KA3D::profileCount(::KA3D::COUNTER)
+#  define KA3D_PROFILE_ADD(COUNTER, N) \
+	::KA3D::profileCount(::KA3D::COUNTER, (N))
+
+#else // KA3D_PROFILING
+
+#  define KA3D_PROFILE_SCOPE(NAME)
+#  define KA3D_PROFILE_COUNT(COUNTER)
+#  define KA3D_PROFILE_ADD(COUNTER, N)
+
+#endif // KA3D_PROFILING
+
+} // namespace KA3D
+
+#endif // PROFILERPRIVATE_H_INCLUDED
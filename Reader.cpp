@@ -0,0 +1,217 @@
+/**
+ *
+ * @file Reader.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les sources de lecture des fichiers audio (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Reader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace KA3D
+{
+
+SpanReader::SpanReader(const void* data, std::size_t size) noexcept:
+	m_pData(static_cast<const std::uint8_t*>(data)),
+	m_uSize(size)
+{ }
+
+std::size_t SpanReader::readAt(std::uint64_t offset, void* data,
+                               std::size_t size)
+{
+	if(offset >= m_uSize)
+		return 0;
+	std::size_t readable(std::min<std::uint64_t>(size, m_uSize - offset));
+	std::memcpy(data, m_pData + offset, readable);
+	return readable;
+}
+
+StreamReader::StreamReader(std::istream& refStream) noexcept:
+	m_refStream(refStream),
+	m_uPos(0)
+{ }
+
+std::size_t StreamReader::readAt(std::uint64_t offset, void* data,
+                                 std::size_t size)
+{
+	if(offset != m_uPos)
+		seek(offset);
+
+	m_refStream.read(static_cast<std::istream::char_type*>(data), size);
+	std::size_t readable(static_cast<std::size_t>(m_refStream.gcount()));
+	m_uPos += readable;
+	if(m_refStream.bad())
+		throw std::runtime_error("Reading error");
+	m_refStream.clear(); // Fin du flux : lecture partielle
+	return readable;
+}
+
+void StreamReader::seek(std::uint64_t offset)
+{
+	m_refStream.seekg(static_cast<std::int64_t>(offset - m_uPos),
+	                  std::ios_base::cur);
+	if(m_refStream.fail())
+	{
+		m_refStream.clear();
+		throw std::runtime_error("Seeking error");
+	}
+	m_uPos = offset;
+}
+
+BufferedReader::BufferedReader(Reader& refSource, std::size_t blockSize):
+	m_refSource(refSource),
+	m_tblBlock(blockSize),
+	m_uBlockPos(0),
+	m_uBlockSize(0)
+{ }
+
+std::size_t BufferedReader::readAt(std::uint64_t offset, void* data,
+                                   std::size_t size)
+{
+	std::uint8_t* bytes(static_cast<std::uint8_t*>(data));
+	std::size_t done(0);
+	while(done < size)
+	{
+		std::uint64_t pos(offset + done);
+		if(pos < m_uBlockPos || pos >= m_uBlockPos + m_uBlockSize)
+		{
+			// Grande lecture : directement dans la destination
+			if(size - done >= m_tblBlock.size())
+				return done + m_refSource.readAt(pos, bytes + done,
+				                                 size - done);
+
+			m_uBlockPos = pos;
+			m_uBlockSize = m_refSource.readAt(pos, m_tblBlock.data(),
+			                                  m_tblBlock.size());
+			if(m_uBlockSize == 0)
+				break; // Fin de la source
+		}
+		std::size_t block(std::min<std::uint64_t>(size - done,
+		                  m_uBlockPos + m_uBlockSize - pos));
+		std::memcpy(bytes + done, m_tblBlock.data() + (pos - m_uBlockPos),
+		            block);
+		done += block;
+	}
+	return done;
+}
+
+#ifndef _WIN32
+FdReader::FdReader(int fd, std::uint64_t base) noexcept:
+	m_fd(fd),
+	m_uBase(base)
+{ }
+
+std::size_t FdReader::readAt(std::uint64_t offset, void* data,
+                             std::size_t size)
+{
+	std::uint8_t* bytes(static_cast<std::uint8_t*>(data));
+	std::size_t done(0);
+	while(done < size)
+	{
+		ssize_t count(pread(m_fd, bytes + done, size - done,
+		                    static_cast<off_t>(m_uBase + offset + done)));
+		if(count < 0)
+		{
+			if(errno == EINTR)
+				continue;
+			std::ostringstream msg;
+			msg << "Reading error: " << std::strerror(errno);
+			throw std::runtime_error(msg.str());
+		}
+		if(count == 0)
+			break; // Fin du fichier
+		done += static_cast<std::size_t>(count);
+	}
+	return done;
+}
+
+MmapReader::MmapReader() noexcept:
+	SpanReader(nullptr, 0)
+{ }
+
+MmapReader::~MmapReader() noexcept
+{
+	Quit();
+}
+
+void MmapReader::Init(const char* szPath)
+{
+	Quit();
+	int fd(open(szPath, O_RDONLY));
+	try
+	{
+		if(fd < 0)
+			throw std::runtime_error(std::strerror(errno));
+
+		struct stat info;
+		if(fstat(fd, &info) != 0)
+			throw std::runtime_error(std::strerror(errno));
+
+		// Fichier vide : rien à projeter
+		if(info.st_size > 0)
+		{
+			void* pData(mmap(nullptr, static_cast<std::size_t>(info.st_size),
+			                 PROT_READ, MAP_PRIVATE, fd, 0));
+			if(pData == MAP_FAILED)
+				throw std::runtime_error(std::strerror(errno));
+			m_pData = static_cast<const std::uint8_t*>(pData);
+			m_uSize = static_cast<std::size_t>(info.st_size);
+		}
+	}
+	catch(std::runtime_error& e)
+	{
+		if(fd >= 0)
+			close(fd);
+
+		std::ostringstream msg;
+		msg << "Unable to map file '" << szPath << "': " << e.what();
+		throw std::runtime_error(msg.str());
+	}
+	close(fd); // La projection reste valide
+}
+
+void MmapReader::Quit() noexcept
+{
+	if(m_pData)
+		munmap(const_cast<std::uint8_t*>(m_pData), m_uSize);
+	m_pData = nullptr;
+	m_uSize = 0;
+}
+#endif // _WIN32
+
+} // namespace KA3D
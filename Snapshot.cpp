@@ -0,0 +1,242 @@
+/**
+ *
+ * @file Snapshot.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les instantanés de mixage et leurs transitions (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Snapshot.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <AL/al.h>
+
+#include "Context.h"
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+static bool isSameEffect(const SlotEffect& a, const SlotEffect& b) noexcept
+{
+	if(a.type != b.type)
+		return false;
+	if(a.type == ET_REVERB)
+		return a.reverb == b.reverb;
+	if(a.type == ET_ECHO)
+		return a.echo.fDelay == b.echo.fDelay &&
+		       a.echo.fLRDelay == b.echo.fLRDelay &&
+		       a.echo.fDamping == b.echo.fDamping &&
+		       a.echo.fFeedback == b.echo.fFeedback &&
+		       a.echo.fSpread == b.echo.fSpread;
+	return true;
+}
+
+static EchoProperties blendEcho(const EchoProperties& from,
+                                const EchoProperties& to, float t) noexcept
+{
+	EchoProperties echo;
+	echo.fDelay = from.fDelay + (to.fDelay - from.fDelay) * t;
+	echo.fLRDelay = from.fLRDelay + (to.fLRDelay - from.fLRDelay) * t;
+	echo.fDamping = from.fDamping + (to.fDamping - from.fDamping) * t;
+	echo.fFeedback = from.fFeedback + (to.fFeedback - from.fFeedback) * t;
+	echo.fSpread = from.fSpread + (to.fSpread - from.fSpread) * t;
+	return echo;
+}
+
+Snapshots::Snapshots(Listener& listener, Bus* pRoot, Effects* pEffects):
+	m_listener(listener),
+	m_pRoot(pRoot),
+	m_pEffects(pEffects),
+	m_mutex(),
+	m_listenerGain(),
+	m_dopplerFactor(),
+	m_speedSound(),
+	m_tblBuses(),
+	m_tblSlots(),
+	m_fElapsed(0.f),
+	m_fDuration(0.f),
+	m_isActive(false)
+{ }
+
+Snapshots::~Snapshots() noexcept
+{ }
+
+MixSnapshot Snapshots::capture() const
+{
+	MixSnapshot snapshot;
+	snapshot.fListenerGain = m_listener.gain();
+	snapshot.fDopplerFactor = m_listener.dopplerFactor();
+	snapshot.fSpeedSound = m_listener.speedSound();
+	if(m_pRoot)
+	{
+		std::vector<Bus*> tblBuses;
+		m_pRoot->collect(tblBuses);
+		for(Bus* pBus : tblBuses)
+		{
+			SnapshotBus bus = {pBus, pBus->gain()};
+			snapshot.tblBuses.push_back(bus);
+		}
+	}
+	if(m_pEffects)
+	{
+		for(std::uint16_t slot=m_pEffects->zoneSlotCount();
+		    slot<m_pEffects->slotCount(); ++slot)
+		{
+			SnapshotSlot effect = {slot, m_pEffects->slotGain(slot),
+			                       m_pEffects->slotEffect(slot)};
+			snapshot.tblSlots.push_back(effect);
+		}
+	}
+	return snapshot;
+}
+
+void Snapshots::transition(const MixSnapshot& snapshot, float fDuration)
+{
+	// Départ des valeurs courantes : une transition interrompue ou un
+	// réglage direct (Listener::setGain...) ne provoque pas de saut
+	float fListenerGain(m_listener.gain());
+	float fDopplerFactor(m_listener.dopplerFactor());
+	float fSpeedSound(m_listener.speedSound());
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_listenerGain = {fListenerGain, snapshot.fListenerGain, fListenerGain};
+	m_dopplerFactor = {fDopplerFactor, snapshot.fDopplerFactor, fDopplerFactor};
+	m_speedSound = {fSpeedSound, snapshot.fSpeedSound, fSpeedSound};
+
+	m_tblBuses.clear();
+	for(const SnapshotBus& bus : snapshot.tblBuses)
+	{
+		float fGain(bus.pBus->gain());
+		BusField field = {bus.pBus, {fGain, bus.fGain, fGain}};
+		m_tblBuses.push_back(field);
+	}
+	m_tblSlots.clear();
+	for(const SnapshotSlot& slot : snapshot.tblSlots)
+	{
+		float fGain(m_pEffects ? m_pEffects->slotGain(slot.slot) : slot.fGain);
+		const SlotEffect& from(m_pEffects ? m_pEffects->slotEffect(slot.slot)
+		                                  : slot.effect);
+		bool isBlending(slot.effect.type != ET_NONE &&
+		                !isSameEffect(from, slot.effect));
+		SlotField field = {slot.slot, {fGain, slot.fGain, fGain},
+		                   from, slot.effect, isBlending, {0.f, 1.f, 0.f}};
+		m_tblSlots.push_back(field);
+	}
+
+	m_fElapsed = 0.f;
+	m_fDuration = std::max(fDuration, 0.f);
+	m_isActive = true;
+}
+
+bool Snapshots::isTransitioning() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_isActive;
+}
+
+bool Snapshots::step(Field& field, float t) noexcept
+{
+	float fValue(field.fFrom + (field.fTo - field.fFrom) * t);
+	if(fValue == field.fApplied)
+		return false;
+	field.fApplied = fValue;
+	return true;
+}
+
+void Snapshots::applyEffect(const SlotField& field, float t)
+{
+	const SlotEffect& from(field.from);
+	const SlotEffect& to(field.to);
+	if(from.type == ET_REVERB && to.type == ET_REVERB)
+	{
+		m_pEffects->blendReverb(field.slot, from.reverb, to.reverb, t);
+	}
+	else if(from.type == ET_ECHO && to.type == ET_ECHO)
+	{
+		m_pEffects->setEcho(field.slot, blendEcho(from.echo, to.echo, t));
+	}
+	else if(t >= 0.5f && m_pEffects->slotEffect(field.slot).type != to.type)
+	{
+		// Types différents : pas d'intermédiaire, bascule à mi-parcours
+		if(to.type == ET_REVERB)
+			m_pEffects->setReverb(field.slot, to.reverb);
+		else
+			m_pEffects->setEcho(field.slot, to.echo);
+	}
+}
+
+void Snapshots::update(float fDelta)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(!m_isActive)
+		return;
+	KA3D_PROFILE_SCOPE("Snapshots::update");
+	m_fElapsed += fDelta;
+	float t(m_fDuration > 0.f ? std::min(m_fElapsed / m_fDuration, 1.f) : 1.f);
+
+	// Toutes les modifications du pas sont appliquées ensemble
+	Context* pContext(Context::current());
+	bool isDeferred(pContext && pContext->extensions().alDeferUpdatesSOFT);
+	if(isDeferred)
+		pContext->extensions().alDeferUpdatesSOFT();
+	try
+	{
+		if(step(m_listenerGain, t))
+			m_listener.setGain(m_listenerGain.fApplied);
+		if(step(m_dopplerFactor, t))
+			m_listener.setDopplerFactor(m_dopplerFactor.fApplied);
+		if(step(m_speedSound, t))
+			m_listener.setSpeedSound(m_speedSound.fApplied);
+		for(BusField& bus : m_tblBuses)
+			if(step(bus.value, t))
+				bus.pBus->setGain(bus.value.fApplied);
+		for(SlotField& slot : m_tblSlots)
+		{
+			if(!m_pEffects)
+				break;
+			if(step(slot.value, t))
+				m_pEffects->setSlotGain(slot.slot, slot.value.fApplied);
+			if(slot.isBlending && step(slot.blend, t))
+				applyEffect(slot, slot.blend.fApplied);
+		}
+		if(m_pRoot)
+			m_pRoot->flush();
+	}
+	catch(...)
+	{
+		if(isDeferred)
+			pContext->extensions().alProcessUpdatesSOFT();
+		throw;
+	}
+	if(isDeferred)
+		pContext->extensions().alProcessUpdatesSOFT();
+
+	if(t >= 1.f)
+		m_isActive = false;
+}
+
+} // namespace KA3D
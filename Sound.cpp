@@ -34,23 +34,29 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
+
+#include "ProfilerPrivate.h"
+#include "KA3D/Bus.h"
 
 namespace KA3D
 {
 
 Sound::Sound(uint32_t instanceMax):
-	m_tblSources(new Source[instanceMax]),
+	m_tblSources(instanceMax),
 	m_pData(nullptr),
 	m_pConfig(nullptr),
+	m_pBus(nullptr),
 	m_uInstanceMax(instanceMax),
 	m_uCurrent(0),
 	m_removeData(false)
 { }
 
 Sound::Sound(SourceConfigure* pConfig, uint32_t instanceMax):
-	m_tblSources(new Source[instanceMax]),
+	m_tblSources(instanceMax),
 	m_pData(nullptr),
 	m_pConfig(pConfig),
+	m_pBus(nullptr),
 	m_uInstanceMax(instanceMax),
 	m_uCurrent(0),
 	m_removeData(false)
@@ -58,19 +64,53 @@ Sound::Sound(SourceConfigure* pConfig, uint32_t instanceMax):
 
 Sound::~Sound() noexcept
 {
-	delete[] m_tblSources;
+	if(m_pBus)
+		m_pBus->remove(*this);
 }
 
 void Sound::setData(Data* pData, bool removeData) noexcept
 {
+	// removeData : le son s'approprie la référence de l'appelant
+	if(pData && !removeData)
+		pData->ref();
+	if(m_pData)
+		m_pData->unref();
 	m_pData = pData;
 	m_removeData = removeData;
 }
 
 void Sound::setWav(std::iostream& file)
 {
-	m_pData = Data::fromWav(file);
-	m_removeData = true;
+	setData(Data::fromWav(file), true);
+}
+
+void Sound::setBus(Bus* pBus)
+{
+	if(m_pBus)
+		m_pBus->remove(*this);
+	m_pBus = pBus;
+	if(m_pBus)
+		m_pBus->add(*this);
+	setBusGain(m_pBus ? m_pBus->effectiveGain() : 1.f);
+}
+
+Bus* Sound::bus() const noexcept
+{
+	return m_pBus;
+}
+
+void Sound::setBusGain(float fBusGain)
+{
+	for(Source& source : m_tblSources)
+		source.setBusGain(fBusGain);
+}
+
+bool Sound::isPlaying() const
+{
+	for(const Source& source : m_tblSources)
+		if(source.isInitialized() && source.isPlaying())
+			return true;
+	return false;
 }
 
 void Sound::setConfig(SourceConfigure* pConfig)
@@ -80,6 +120,7 @@ void Sound::setConfig(SourceConfigure* pConfig)
 
 void Sound::Init(bool forceLoad)
 {
+	KA3D_PROFILE_SCOPE("Sound::Init");
 	assert(m_pData);
 	loadSource(0);
 	if(forceLoad)
@@ -95,29 +136,40 @@ void Sound::loadSource(SoundInstance instance)
 {
 	m_tblSources[instance].Init(m_pData);
 	if(m_pConfig)
-		(*m_pConfig)(m_tblSources);
+		(*m_pConfig)(&m_tblSources[instance]);
 }
 
 void Sound::Quit()
 {
-	for(uint32_t i=0; i<m_uInstanceMax; ++i)
+	KA3D_PROFILE_SCOPE("Sound::Quit");
+	for(Source& source : m_tblSources)
 	{
-		if(m_tblSources[i].isInitialized())
-			m_tblSources[i].Quit();
+		if(source.isInitialized())
+			source.Quit();
+	}
+	if(m_pData)
+	{
+		m_pData->unref();
+		m_pData = nullptr;
 	}
-	if(m_removeData)
-		delete m_pData;
 }
 
 void Sound::play()
+{
+	KA3D_PROFILE_COUNT(PC_SOUND_PLAY);
+	next().play();
+}
+
+Source& Sound::next()
 {
 	if(!m_tblSources[m_uCurrent].isInitialized())
 	{
 		loadSource(m_uCurrent);
 	}
-	m_tblSources[m_uCurrent].play();
+	Source& source(m_tblSources[m_uCurrent]);
 	++m_uCurrent;
 	m_uCurrent %= m_uInstanceMax;
+	return source;
 }
 
 Sound* Sound::fromWav(const std::string& filename)
@@ -0,0 +1,187 @@
+/**
+ *
+ * @file SoundGroup.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la gestion groupée de sources sonores (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "KA3D/SoundGroup.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <AL/al.h>
+#include <AL/alc.h>
+
+#include "Context.h"
+#include "Error.h"
+#include "Extensions.h"
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+static inline const ALuint* handles(const std::vector<std::uint32_t>& tbl)
+{
+	return reinterpret_cast<const ALuint*>(tbl.data());
+}
+
+SoundGroup::SoundGroup():
+	m_tblSources(),
+	m_tblSounds(),
+	m_tblInstances(),
+	m_tblHandles()
+{ }
+
+SoundGroup::~SoundGroup() noexcept
+{ }
+
+bool SoundGroup::isScheduleSupported() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().alSourcePlayAtTimevSOFT;
+}
+
+void SoundGroup::add(Source* pSource)
+{
+	m_tblSources.push_back(pSource);
+	m_tblHandles.reserve(size());
+}
+
+void SoundGroup::add(Sound* pSound)
+{
+	m_tblSounds.push_back(pSound);
+	m_tblInstances.push_back(nullptr);
+	m_tblHandles.reserve(size());
+}
+
+void SoundGroup::clear() noexcept
+{
+	m_tblSources.clear();
+	m_tblSounds.clear();
+	m_tblInstances.clear();
+}
+
+std::size_t SoundGroup::size() const noexcept
+{
+	return m_tblSources.size() + m_tblSounds.size();
+}
+
+void SoundGroup::resolve()
+{
+	for(std::size_t i=0; i<m_tblSounds.size(); ++i)
+		m_tblInstances[i] = &m_tblSounds[i]->next();
+	gather();
+}
+
+void SoundGroup::gather()
+{
+	m_tblHandles.clear();
+	for(Source* pSource : m_tblSources)
+		if(pSource->isInitialized())
+			m_tblHandles.push_back(pSource->handle());
+	for(Source* pSource : m_tblInstances)
+		if(pSource && pSource->isInitialized())
+			m_tblHandles.push_back(pSource->handle());
+}
+
+void SoundGroup::play()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	resolve();
+	if(m_tblHandles.empty())
+		return;
+	alSourcePlayv(static_cast<ALsizei>(m_tblHandles.size()),
+	              handles(m_tblHandles));
+	checkALError();
+}
+
+void SoundGroup::playAt(std::int64_t deviceTime)
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	Context* pContext(Context::current());
+	if(!pContext || !pContext->extensions().alSourcePlayAtTimevSOFT)
+		throw std::runtime_error("Unable to schedule sound group: "
+		                         "AL_SOFT_source_start_delay not supported");
+
+	resolve();
+	if(m_tblHandles.empty())
+		return;
+	pContext->extensions().alSourcePlayAtTimevSOFT(
+		static_cast<ALsizei>(m_tblHandles.size()), handles(m_tblHandles),
+		deviceTime);
+	checkALError();
+}
+
+void SoundGroup::playIn(std::int64_t delay)
+{
+	Context* pContext(Context::current());
+	if(!pContext)
+		throw std::runtime_error("Unable to schedule sound group: "
+		                         "no current audio context");
+	playAt(pContext->deviceClock() + delay);
+}
+
+void SoundGroup::pause()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	gather();
+	if(m_tblHandles.empty())
+		return;
+	alSourcePausev(static_cast<ALsizei>(m_tblHandles.size()),
+	               handles(m_tblHandles));
+	checkALError();
+}
+
+void SoundGroup::stop()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	gather();
+	if(m_tblHandles.empty())
+		return;
+	alSourceStopv(static_cast<ALsizei>(m_tblHandles.size()),
+	              handles(m_tblHandles));
+	checkALError();
+}
+
+void SoundGroup::rewind()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	gather();
+	if(m_tblHandles.empty())
+		return;
+	alSourceRewindv(static_cast<ALsizei>(m_tblHandles.size()),
+	                handles(m_tblHandles));
+	checkALError();
+}
+
+} // namespace KA3D
@@ -27,39 +27,129 @@
 
 #include "KA3D/Source.h"
 
+#include <cfloat>
 #include <cstdint>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 #include <AL/al.h>
 
-#include "DataPrivate.h"
+#include "Context.h"
 #include "Error.h"
+#include "Extensions.h"
+#include "ProfilerPrivate.h"
 
 namespace KA3D
 {
 
-Source::Source():
+//! Valeurs par défaut des paramètres d'une source (spécification OpenAL)
+static const struct
+{
+	ALenum param;
+	ALfloat value;
+} tblSourceDefaults[] = {
+	{AL_PITCH, 1.f},
+	{AL_GAIN, 1.f},
+	{AL_MIN_GAIN, 0.f},
+	{AL_MAX_GAIN, 1.f},
+	{AL_MAX_DISTANCE, FLT_MAX},
+	{AL_ROLLOFF_FACTOR, 1.f},
+	{AL_REFERENCE_DISTANCE, 1.f},
+	{AL_CONE_OUTER_GAIN, 0.f},
+	{AL_CONE_INNER_ANGLE, 360.f},
+	{AL_CONE_OUTER_ANGLE, 360.f}
+};
+
+// Remet une source dans son état initial avant de la rendre à la réserve
+static void resetSource(ALuint handle, const Extensions& ext)
+{
+	alSourceStop(handle);
+	alSourcei(handle, AL_BUFFER, 0);
+	for(const auto& def : tblSourceDefaults)
+		alSourcef(handle, def.param, def.value);
+	alSource3f(handle, AL_POSITION, 0.f, 0.f, 0.f);
+	alSource3f(handle, AL_VELOCITY, 0.f, 0.f, 0.f);
+	alSource3f(handle, AL_DIRECTION, 0.f, 0.f, 0.f);
+	alSourcei(handle, AL_SOURCE_RELATIVE, AL_FALSE);
+	alSourcei(handle, AL_LOOPING, AL_FALSE);
+	// Filtre direct (cf. Occlusion) et envois auxiliaires (cf. Effects::attach)
+	if(ext.alGenFilters)
+		alSourcei(handle, AL_DIRECT_FILTER, AL_FILTER_NULL);
+	for(ALint send=0; send<ext.iMaxAuxiliarySends; ++send)
+	{
+		alSource3i(handle, AL_AUXILIARY_SEND_FILTER,
+		           AL_EFFECTSLOT_NULL, send, AL_FILTER_NULL);
+	}
+	checkALError();
+}
+
+static_assert(sizeof(std::uint32_t) == sizeof(ALuint),
+              "ALuint must be stored inline as std::uint32_t");
+
+Source::Source() noexcept:
 	m_pData(nullptr),
-	m_pSource(new DataPrivate)
+	m_uHandle(0),
+	m_fGain(1.f),
+	m_fBusGain(1.f),
+	m_mutexGain()
 { }
-Source::~Source() noexcept
+Source::Source(Source&& other) noexcept:
+	m_pData(other.m_pData),
+	m_uHandle(other.m_uHandle),
+	m_fGain(other.m_fGain.load()),
+	m_fBusGain(other.m_fBusGain.load()),
+	m_mutexGain()
+{
+	other.m_pData = nullptr;
+	other.m_uHandle = 0;
+	other.m_fGain = 1.f;
+}
+Source& Source::operator=(Source&& other) noexcept
 {
-	delete m_pSource;
+	std::swap(m_pData, other.m_pData);
+	std::swap(m_uHandle, other.m_uHandle);
+	m_fGain = other.m_fGain.exchange(m_fGain);
+	m_fBusGain = other.m_fBusGain.exchange(m_fBusGain);
+	return *this;
 }
+Source::~Source() noexcept
+{ }
 
 void Source::Init(Data* pData)
 {
+	KA3D_PROFILE_SCOPE("Source::Init");
+	ContextLock contextLock;
+	Context* pContext(Context::current());
 	try
 	{
-		m_pData = pData;
-		alGenSources(1, &m_pSource->handle);
-		checkALError();
-		alSourcei(m_pSource->handle, AL_BUFFER, m_pData->data()->handle);
+		if(!pContext)
+			throw std::runtime_error("No current audio context");
+
+		// Source pré-allouée (cf. Listener::setSourcePool)
+		std::uint32_t handle(pContext->sources().pop());
+		{
+			// Nom publié sous le verrou du volume : un Bus::flush concurrent
+			// s'applique soit avant (m_fBusGain lu ici), soit après
+			std::lock_guard<std::mutex> lock(m_mutexGain);
+			m_uHandle = handle;
+			alSourcei(m_uHandle, AL_BUFFER, pData->handle());
+			if(m_fBusGain != 1.f)
+				alSourcef(m_uHandle, AL_GAIN, m_fBusGain);
+		}
 		checkALError();
+		pData->ref();
+		m_pData = pData;
 	}
 	catch(std::exception& e)
 	{
+		std::lock_guard<std::mutex> lock(m_mutexGain);
+		if(m_uHandle)
+		{
+			pContext->sources().push(m_uHandle);
+			m_uHandle = 0;
+		}
+
 		std::ostringstream msg;
 		msg << "Unable to initialize audio source: " << e.what();
 		throw std::runtime_error(msg.str());
@@ -68,11 +158,31 @@ void Source::Init(Data* pData)
 
 void Source::Quit()
 {
+	KA3D_PROFILE_SCOPE("Source::Quit");
+	ContextLock contextLock;
 	try
 	{
-		alDeleteSources(1, &m_pSource->handle);
-		checkALError();
+		Context* pContext(Context::current());
+		{
+			// Plus aucun volume ne doit être envoyé au nom rendu
+			std::lock_guard<std::mutex> lock(m_mutexGain);
+			if(pContext)
+			{
+				resetSource(m_uHandle, pContext->extensions());
+				pContext->sources().push(m_uHandle);
+			}
+			else
+			{
+				alDeleteSources(1, &m_uHandle);
+				checkALError();
+			}
+			m_uHandle = 0;
+			m_fGain = 1.f;
+		}
+		m_pData->unref();
 		m_pData = nullptr;
+		// La source supprimée a pu libérer des buffers en attente
+		Data::collect();
 	}
 	catch(std::exception& e)
 	{
@@ -87,292 +197,438 @@ bool Source::isInitialized() const noexcept
 	return m_pData;
 }
 
+std::uint32_t Source::handle() const noexcept
+{
+	return m_uHandle;
+}
+
+Data* Source::data() const noexcept
+{
+	return m_pData;
+}
+
 void Source::play()
 {
-	alSourcePlay(m_pSource->handle);
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	alSourcePlay(m_uHandle);
 	checkALError();
 }
 
 void Source::pause()
 {
-	alSourcePause(m_pSource->handle);
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	alSourcePause(m_uHandle);
 	checkALError();
 }
 
 void Source::stop()
 {
-	alSourceStop(m_pSource->handle);
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	alSourceStop(m_uHandle);
 	checkALError();
 }
 
 void Source::rewind()
 {
-	alSourceRewind(m_pSource->handle);
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	alSourceRewind(m_uHandle);
 	checkALError();
 }
 
 void Source::setPosition(float xpos, float ypos, float zpos)
 {
-	alSource3f(m_pSource->handle, AL_POSITION, xpos, ypos, zpos);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSource3f(m_uHandle, AL_POSITION, xpos, ypos, zpos);
 	checkALError();
 }
 
 void Source::setVelocity(float xvel, float yvel, float zvel)
 {
-	alSource3f(m_pSource->handle, AL_VELOCITY, xvel, yvel, zvel);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSource3f(m_uHandle, AL_VELOCITY, xvel, yvel, zvel);
 	checkALError();
 }
 
 void Source::setDirection(float xat, float yat, float zat)
 {
-	alSource3f(m_pSource->handle, AL_DIRECTION, xat, yat, zat);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSource3f(m_uHandle, AL_DIRECTION, xat, yat, zat);
 	checkALError();
 }
 
 void Source::setPitch(float factor)
 {
-	alSourcef(m_pSource->handle, AL_PITCH, factor);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_PITCH, factor);
 	checkALError();
 }
 
 void Source::setGain(float fGain)
 {
-	alSourcef(m_pSource->handle, AL_GAIN, fGain);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	// Le produit est calculé et envoyé sous le même verrou que
+	// #setBusGain : aucune des deux mises à jour ne peut être perdue
+	std::lock_guard<std::mutex> lock(m_mutexGain);
+	alSourcef(m_uHandle, AL_GAIN, fGain * m_fBusGain);
+	checkALError();
+	m_fGain = fGain;
+}
+
+void Source::setBusGain(float fBusGain)
+{
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(m_mutexGain);
+	if(fBusGain == m_fBusGain)
+		return;
+	m_fBusGain = fBusGain;
+	if(!m_uHandle)
+		return;
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	alSourcef(m_uHandle, AL_GAIN, m_fGain * m_fBusGain);
 	checkALError();
 }
 
 void Source::setMaxDistance(float fMaxDistance)
 {
-	alSourcef(m_pSource->handle, AL_MAX_DISTANCE, fMaxDistance);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_MAX_DISTANCE, fMaxDistance);
 	checkALError();
 }
 
 void Source::setRollOffFactor(float fRollOff)
 {
-	alSourcef(m_pSource->handle, AL_ROLLOFF_FACTOR, fRollOff);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_ROLLOFF_FACTOR, fRollOff);
 	checkALError();
 }
 
 void Source::setReferenceDistance(float fRefDistance)
 {
-	alSourcef(m_pSource->handle, AL_REFERENCE_DISTANCE, fRefDistance);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_REFERENCE_DISTANCE, fRefDistance);
 	checkALError();
 }
 
 void Source::setMinGain(float fMinGain)
 {
-	alSourcef(m_pSource->handle, AL_MIN_GAIN, fMinGain);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_MIN_GAIN, fMinGain);
 	checkALError();
 }
 
 void Source::setMaxGain(float fMaxGain)
 {
-	alSourcef(m_pSource->handle, AL_MAX_GAIN, fMaxGain);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_MAX_GAIN, fMaxGain);
 	checkALError();
 }
 
 void Source::setConeOuterGain(float fConeOuterGain)
 {
-	alSourcef(m_pSource->handle, AL_CONE_OUTER_GAIN, fConeOuterGain);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_CONE_OUTER_GAIN, fConeOuterGain);
 	checkALError();
 }
 
 void Source::setConeInnerAngle(float fConeInnerAngle)
 {
-	alSourcef(m_pSource->handle, AL_CONE_INNER_ANGLE, fConeInnerAngle);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_CONE_INNER_ANGLE, fConeInnerAngle);
 	checkALError();
 }
 
 void Source::setConeOuterAngle(float fConeOuterAngle)
 {
-	alSourcef(m_pSource->handle, AL_CONE_OUTER_ANGLE, fConeOuterAngle);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_CONE_OUTER_ANGLE, fConeOuterAngle);
 	checkALError();
 }
 
 void Source::setRelative(bool isRelative)
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
 	ALint val(isRelative ? AL_TRUE : AL_FALSE);
-	alSourcei(m_pSource->handle, AL_SOURCE_RELATIVE, val);
+	alSourcei(m_uHandle, AL_SOURCE_RELATIVE, val);
 	checkALError();
 }
 
 void Source::setOffsetSec(float second)
 {
-	alSourcef(m_pSource->handle, AL_SEC_OFFSET, second);
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_SEC_OFFSET, second);
 	checkALError();
 }
 
 void Source::setOffset(std::uint32_t sample)
 {
-	alSourcei(m_pSource->handle, AL_SAMPLE_OFFSET, static_cast<ALint>(sample));
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcei(m_uHandle, AL_SAMPLE_OFFSET, static_cast<ALint>(sample));
 	checkALError();
 }
 
 void Source::setAutoLoop(bool isLooping)
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
 	ALint val(isLooping ? AL_TRUE : AL_FALSE);
-	alSourcei(m_pSource->handle, AL_LOOPING, val);
+	alSourcei(m_uHandle, AL_LOOPING, val);
 	checkALError();
 }
 
 void Source::position(float& xpos, float& ypos, float& zpos) const
 {
-	alGetSource3f(m_pSource->handle, AL_POSITION, &xpos, &ypos, &zpos);
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
+	alGetSource3f(m_uHandle, AL_POSITION, &xpos, &ypos, &zpos);
 	checkALError();
 }
 
 void Source::velocity(float& xvel, float& yvel, float& zvel) const
 {
-	alGetSource3f(m_pSource->handle, AL_VELOCITY, &xvel, &yvel, &zvel);
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
+	alGetSource3f(m_uHandle, AL_VELOCITY, &xvel, &yvel, &zvel);
 	checkALError();
 }
 
 void Source::direction(float& xat, float& yat, float& zat) const
 {
-	alGetSource3f(m_pSource->handle, AL_DIRECTION, &xat, &yat, &zat);
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
+	alGetSource3f(m_uHandle, AL_DIRECTION, &xat, &yat, &zat);
 	checkALError();
 }
 
 float Source::pitch() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_PITCH, &val);
+	alGetSourcef(m_uHandle, AL_PITCH, &val);
 	checkALError();
 	return val;
 }
 
 float Source::gain() const
 {
-	float val;
-	alGetSourcef(m_pSource->handle, AL_GAIN, &val);
-	checkALError();
-	return val;
+	// Conservé localement : le pilote contient le volume multiplié par
+	// celui du bus
+	return m_fGain;
+}
+
+float Source::busGain() const noexcept
+{
+	return m_fBusGain;
 }
 
 float Source::maxDistance() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_MAX_DISTANCE, &val);
+	alGetSourcef(m_uHandle, AL_MAX_DISTANCE, &val);
 	checkALError();
 	return val;
 }
 
 float Source::rollOffFactor() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_ROLLOFF_FACTOR, &val);
+	alGetSourcef(m_uHandle, AL_ROLLOFF_FACTOR, &val);
 	checkALError();
 	return val;
 }
 
 float Source::referenceDistance() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_REFERENCE_DISTANCE, &val);
+	alGetSourcef(m_uHandle, AL_REFERENCE_DISTANCE, &val);
 	checkALError();
 	return val;
 }
 
 float Source::minGain() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_MIN_GAIN, &val);
+	alGetSourcef(m_uHandle, AL_MIN_GAIN, &val);
 	checkALError();
 	return val;
 }
 
 float Source::maxGain() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_MAX_GAIN, &val);
+	alGetSourcef(m_uHandle, AL_MAX_GAIN, &val);
 	checkALError();
 	return val;
 }
 
 float Source::coneOuterGain() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_CONE_OUTER_GAIN, &val);
+	alGetSourcef(m_uHandle, AL_CONE_OUTER_GAIN, &val);
 	checkALError();
 	return val;
 }
 
 float Source::coneInnerAngle() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_CONE_INNER_ANGLE, &val);
+	alGetSourcef(m_uHandle, AL_CONE_INNER_ANGLE, &val);
 	checkALError();
 	return val;
 }
 
 float Source::coneOuterAngle() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_CONE_OUTER_ANGLE, &val);
+	alGetSourcef(m_uHandle, AL_CONE_OUTER_ANGLE, &val);
 	checkALError();
 	return val;
 }
 
 bool Source::isRelative() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_SOURCE_RELATIVE, &val);
+	alGetSourcei(m_uHandle, AL_SOURCE_RELATIVE, &val);
 	checkALError();
 	return (val == AL_TRUE);
 }
 
 float Source::offsetSec() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	float val;
-	alGetSourcef(m_pSource->handle, AL_SEC_OFFSET, &val);
+	alGetSourcef(m_uHandle, AL_SEC_OFFSET, &val);
 	checkALError();
 	return val;
 }
 
 std::uint32_t Source::offset() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_SAMPLE_OFFSET, &val);
+	alGetSourcei(m_uHandle, AL_SAMPLE_OFFSET, &val);
 	checkALError();
 	return static_cast<std::uint32_t>(val);
 }
 
 bool Source::isLooping() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_LOOPING, &val);
+	alGetSourcei(m_uHandle, AL_LOOPING, &val);
 	checkALError();
 	return (val == AL_TRUE);
 }
 
+bool Source::hasOffsetLatency() noexcept
+{
+	Context* pContext(Context::current());
+	return pContext && pContext->extensions().alGetSourcedvSOFT;
+}
+
+// Lit deux valeurs double d'une source (AL_SOFT_source_latency)
+static void getSourcedv2(ALuint handle, ALenum param, double& a, double& b)
+{
+	Context* pContext(Context::current());
+	if(!pContext || !pContext->extensions().alGetSourcedvSOFT)
+		throw std::runtime_error("AL_SOFT_source_latency not supported");
+
+	ALdouble vals[2];
+	pContext->extensions().alGetSourcedvSOFT(handle, param, vals);
+	checkALError();
+	a = vals[0];
+	b = vals[1];
+}
+
+void Source::offsetLatency(double& second, double& latency) const
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	getSourcedv2(m_uHandle, AL_SEC_OFFSET_LATENCY_SOFT, second, latency);
+}
+
+void Source::offsetClock(double& second, double& clock) const
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	getSourcedv2(m_uHandle, AL_SEC_OFFSET_CLOCK_SOFT, second, clock);
+}
+
 bool Source::isPlaying() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_SOURCE_STATE, &val);
+	alGetSourcei(m_uHandle, AL_SOURCE_STATE, &val);
 	checkALError();
 	return (val == AL_PLAYING);
 }
 
 bool Source::isPaused() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_SOURCE_STATE, &val);
+	alGetSourcei(m_uHandle, AL_SOURCE_STATE, &val);
 	checkALError();
 	return (val == AL_PAUSED);
 }
 
 bool Source::isStopped() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_SOURCE_STATE, &val);
+	alGetSourcei(m_uHandle, AL_SOURCE_STATE, &val);
 	checkALError();
 	return (val == AL_STOPPED);
 }
 
 bool Source::isInitial() const
 {
+	KA3D_PROFILE_COUNT(PC_SOURCE_GET);
+	ContextLock contextLock;
 	ALint val;
-	alGetSourcei(m_pSource->handle, AL_SOURCE_STATE, &val);
+	alGetSourcei(m_uHandle, AL_SOURCE_STATE, &val);
 	checkALError();
 	return (val == AL_INITIAL);
 }
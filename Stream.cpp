@@ -0,0 +1,400 @@
+/**
+ *
+ * @file Stream.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la lecture en flux de fichiers wave (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <AL/al.h>
+
+#include "Context.h"
+#include "Error.h"
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+static_assert(sizeof(std::uint32_t) == sizeof(ALuint),
+              "ALuint must be stored inline as std::uint32_t");
+
+Stream::Stream(std::uint32_t bufferCount, std::uint32_t bufferMs) noexcept:
+	m_uBufferCount(std::max<std::uint32_t>(bufferCount, 2)),
+	m_uBufferMs(std::max<std::uint32_t>(bufferMs, 1)),
+	m_pWave(),
+	m_uHandle(0),
+	m_tblBuffers(),
+	m_tblFree(),
+	m_tblScratch(),
+	m_uQueued(0),
+	m_isLooping(false),
+	m_isPlaying(false),
+	m_isEnded(false),
+	m_mutex()
+{ }
+
+Stream::~Stream() noexcept
+{ }
+
+void Stream::Init(std::iostream& file)
+{
+	open(new WaveFile(file));
+}
+
+void Stream::Init(Reader& reader)
+{
+	open(new WaveFile(reader));
+}
+
+// Prend possession du fichier wave, l'ouvre et remplit la file
+void Stream::open(WaveFile* pWave)
+{
+	KA3D_PROFILE_SCOPE("Stream::Init");
+	ContextLock contextLock;
+	Context* pContext(Context::current());
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_pWave.reset(pWave);
+	try
+	{
+		if(!pContext)
+			throw std::runtime_error("No current audio context");
+
+		m_pWave->open(std::ios_base::in);
+
+		// Tampon d'un buffer, aligné sur les échantillons
+		std::uint16_t pitch(Data::formatPitch(m_pWave->format()));
+		std::uint64_t frames(static_cast<std::uint64_t>(
+			m_pWave->samplesPerSec()) * m_uBufferMs / 1000);
+		m_tblScratch.resize(std::max<std::uint64_t>(frames, 1) * pitch);
+
+		// Buffers propres au flux (générés en un appel)
+		m_tblBuffers.resize(m_uBufferCount);
+		alGenBuffers(static_cast<ALsizei>(m_uBufferCount),
+		             reinterpret_cast<ALuint*>(m_tblBuffers.data()));
+		checkALError();
+		m_tblFree.reserve(m_uBufferCount);
+
+		// Source pré-allouée (cf. Listener::setSourcePool)
+		m_uHandle = pContext->sources().pop();
+		restart();
+	}
+	catch(std::exception& e)
+	{
+		if(m_uHandle)
+		{
+			alSourceStop(m_uHandle);
+			alSourcei(m_uHandle, AL_BUFFER, 0);
+			pContext->sources().push(m_uHandle);
+			m_uHandle = 0;
+		}
+		if(!m_tblBuffers.empty())
+		{
+			alDeleteBuffers(static_cast<ALsizei>(m_tblBuffers.size()),
+			                reinterpret_cast<ALuint*>(m_tblBuffers.data()));
+			m_tblBuffers.clear();
+		}
+		m_tblFree.clear();
+		m_pWave.reset();
+
+		std::ostringstream msg;
+		msg << "Unable to initialize audio stream: " << e.what();
+		throw std::runtime_error(msg.str());
+	}
+}
+
+bool Stream::isInitialized() const noexcept
+{
+	return m_uHandle != 0;
+}
+
+std::uint32_t Stream::handle() const noexcept
+{
+	return m_uHandle;
+}
+
+void Stream::Quit()
+{
+	KA3D_PROFILE_SCOPE("Stream::Quit");
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	try
+	{
+		// Vide la file avant de rendre la source
+		alSourceStop(m_uHandle);
+		alSourcei(m_uHandle, AL_BUFFER, 0);
+		alSourcef(m_uHandle, AL_GAIN, 1.f);
+		alSource3f(m_uHandle, AL_POSITION, 0.f, 0.f, 0.f);
+		alSourcei(m_uHandle, AL_SOURCE_RELATIVE, AL_FALSE);
+		checkALError();
+
+		Context* pContext(Context::current());
+		if(pContext)
+			pContext->sources().push(m_uHandle);
+		else
+			alDeleteSources(1, &m_uHandle);
+		m_uHandle = 0;
+
+		alDeleteBuffers(static_cast<ALsizei>(m_tblBuffers.size()),
+		                reinterpret_cast<ALuint*>(m_tblBuffers.data()));
+		m_tblBuffers.clear();
+		m_tblFree.clear();
+		m_uQueued = 0;
+		m_isPlaying = false;
+		m_pWave.reset();
+		checkALError();
+	}
+	catch(std::exception& e)
+	{
+		std::ostringstream msg;
+		msg << "Unable to quit audio stream: " << e.what();
+		throw std::runtime_error(msg.str());
+	}
+}
+
+void Stream::play()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// Fin du fichier jouée : la file peut encore contenir les derniers
+	// buffers (pas encore retirés par #refill), à ne pas rejouer
+	ALint state(AL_STOPPED);
+	alGetSourcei(m_uHandle, AL_SOURCE_STATE, &state);
+	if(m_uQueued == 0 || (m_isEnded && state == AL_STOPPED))
+		restart();
+	m_isPlaying = true;
+	alSourcePlay(m_uHandle);
+	checkALError();
+}
+
+void Stream::pause()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_isPlaying = false;
+	alSourcePause(m_uHandle);
+	checkALError();
+}
+
+void Stream::stop()
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_STATE);
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_isPlaying = false;
+	restart();
+}
+
+bool Stream::isPlaying() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_isPlaying;
+}
+
+void Stream::setLooping(bool isLooping) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_isLooping = isLooping;
+}
+
+bool Stream::isLooping() const noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_isLooping;
+}
+
+void Stream::setGain(float fGain)
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcef(m_uHandle, AL_GAIN, fGain);
+	checkALError();
+}
+
+void Stream::setPosition(float xpos, float ypos, float zpos)
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSource3f(m_uHandle, AL_POSITION, xpos, ypos, zpos);
+	checkALError();
+}
+
+void Stream::setRelative(bool isRelative)
+{
+	KA3D_PROFILE_COUNT(PC_SOURCE_SET);
+	ContextLock contextLock;
+	alSourcei(m_uHandle, AL_SOURCE_RELATIVE, isRelative ? AL_TRUE : AL_FALSE);
+	checkALError();
+}
+
+void Stream::refill()
+{
+	KA3D_PROFILE_SCOPE("Stream::refill");
+	ContextLock contextLock;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if(!m_uHandle)
+		return;
+
+	// Buffers joués : retirés de la file puis remplis avec la suite
+	ALint processed(0);
+	alGetSourcei(m_uHandle, AL_BUFFERS_PROCESSED, &processed);
+	if(processed > 0)
+	{
+		std::size_t first(m_tblFree.size());
+		m_tblFree.resize(first + processed);
+		alSourceUnqueueBuffers(m_uHandle, processed,
+		                       reinterpret_cast<ALuint*>(&m_tblFree[first]));
+		m_uQueued -= processed;
+	}
+	while(!m_tblFree.empty() && !m_isEnded && fill(m_tblFree.back()))
+	{
+		queue(m_tblFree.back());
+		m_tblFree.pop_back();
+	}
+	checkALError();
+
+	if(!m_isPlaying)
+		return;
+
+	ALint state(AL_STOPPED);
+	alGetSourcei(m_uHandle, AL_SOURCE_STATE, &state);
+	if(state != AL_PLAYING && state != AL_PAUSED)
+	{
+		if(m_uQueued > 0)
+			alSourcePlay(m_uHandle); // Famine : la file a été vidée
+		else
+			m_isPlaying = false; // Fin du fichier jouée
+	}
+	checkALError();
+}
+
+void Stream::update(float fDelta)
+{
+	(void)fDelta;
+	refill();
+}
+
+DataFormat Stream::format() const noexcept
+{
+	return m_pWave ? m_pWave->format() : DF_LAST;
+}
+
+std::uint32_t Stream::samplesPerSec() const noexcept
+{
+	return m_pWave ? m_pWave->samplesPerSec() : 0;
+}
+
+std::uint64_t Stream::size() const noexcept
+{
+	return m_pWave ? m_pWave->size() : 0;
+}
+
+// Remplit un buffer avec la suite du fichier (appelé verrou détenu)
+bool Stream::fill(std::uint32_t uBuffer)
+{
+	// Boucle du fichier (chunk smpl) ou fichier entier, en octets
+	std::uint64_t loopStart(0);
+	std::uint64_t loopEnd(m_pWave->size());
+	if(m_pWave->hasLoop())
+	{
+		std::uint64_t pitch(Data::formatPitch(m_pWave->format()));
+		loopStart = m_pWave->loopStart() * pitch;
+		loopEnd = m_pWave->loopEnd() * pitch;
+	}
+
+	// Boucle : le début de la boucle complète le buffer (sans coupure)
+	std::uint64_t size(0);
+	while(size < m_tblScratch.size())
+	{
+		std::uint64_t readable(m_tblScratch.size() - size);
+		if(m_isLooping)
+		{
+			std::uint64_t pos(static_cast<std::uint64_t>(
+				m_pWave->seek(0, std::ios_base::cur)));
+			if(pos >= loopEnd)
+			{
+				if(loopEnd <= loopStart)
+					break;
+				m_pWave->seek(static_cast<std::int64_t>(loopStart),
+				              std::ios_base::beg);
+				pos = loopStart;
+			}
+			readable = std::min(readable, loopEnd - pos);
+		}
+		std::uint64_t done(m_pWave->read(m_tblScratch.data() + size,
+		                                 readable));
+		size += done;
+		if(done == 0 || !m_isLooping)
+			break;
+	}
+	if(size == 0)
+	{
+		m_isEnded = true;
+		return false;
+	}
+
+	KA3D_PROFILE_COUNT(PC_BUFFER_UPLOAD);
+	KA3D_PROFILE_ADD(PC_BUFFER_UPLOAD_BYTES, size);
+	Data::bufferData(uBuffer, m_pWave->format(), m_tblScratch.data(),
+	                 static_cast<std::size_t>(size),
+	                 static_cast<std::int32_t>(m_pWave->samplesPerSec()));
+	return true;
+}
+
+void Stream::queue(std::uint32_t uBuffer)
+{
+	ALuint handle(uBuffer);
+	alSourceQueueBuffers(m_uHandle, 1, &handle);
+	++m_uQueued;
+}
+
+// Arrête la source, revient au début et remplit toute la file
+// (appelé verrou détenu)
+void Stream::restart()
+{
+	alSourceStop(m_uHandle);
+	alSourcei(m_uHandle, AL_BUFFER, 0);
+	checkALError();
+	m_tblFree.assign(m_tblBuffers.begin(), m_tblBuffers.end());
+	m_uQueued = 0;
+	m_isEnded = false;
+
+	m_pWave->seek(0, std::ios_base::beg);
+	while(!m_tblFree.empty() && fill(m_tblFree.back()))
+	{
+		queue(m_tblFree.back());
+		m_tblFree.pop_back();
+	}
+	checkALError();
+}
+
+} // namespace KA3D
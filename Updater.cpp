@@ -0,0 +1,284 @@
+/**
+ *
+ * @file Updater.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant le fil de mise à jour audio (rampes) (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/Updater.h"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Context.h"
+#include "ProfilerPrivate.h"
+#include "KA3D/Bus.h"
+
+namespace KA3D
+{
+
+Updater::Updater(std::uint32_t tickMs):
+	m_uTickMs(std::max<std::uint32_t>(tickMs, 1)),
+	m_tblRamps(),
+	m_tblTasks(),
+	m_pBus(nullptr),
+	m_mutex(),
+	m_cvWake(),
+	m_thread(),
+	m_isStopping(false)
+{ }
+
+Updater::~Updater() noexcept
+{
+	Quit();
+}
+
+void Updater::Init(bool isThreaded)
+{
+	if(m_thread.joinable())
+		throw std::runtime_error("Unable to start updater: already started");
+	m_isStopping = false;
+	if(isThreaded)
+		m_thread = std::thread(&Updater::threadLoop, this);
+}
+
+void Updater::Quit()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+		m_tblRamps.clear();
+		m_tblTasks.clear();
+		m_pBus = nullptr;
+	}
+	m_cvWake.notify_all();
+	if(m_thread.joinable())
+		m_thread.join();
+}
+
+std::uint32_t Updater::tickMs() const noexcept
+{
+	return m_uTickMs;
+}
+
+void Updater::fadeTo(Source& source, float fGain, std::uint32_t durationMs)
+{
+	start(source, RT_GAIN, fGain, durationMs);
+}
+
+void Updater::pitchTo(Source& source, float fPitch, std::uint32_t durationMs)
+{
+	start(source, RT_PITCH, fPitch, durationMs);
+}
+
+void Updater::cancel(const Source& source) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_tblRamps.erase(std::remove_if(m_tblRamps.begin(), m_tblRamps.end(),
+		[&source](const Ramp& ramp) { return ramp.pSource == &source; }),
+		m_tblRamps.end());
+}
+
+void Updater::add(UpdateTask& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tblTasks.push_back(&task);
+	}
+	m_cvWake.notify_one();
+}
+
+void Updater::remove(UpdateTask& task) noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_tblTasks.erase(std::remove(m_tblTasks.begin(), m_tblTasks.end(), &task),
+	                 m_tblTasks.end());
+}
+
+void Updater::setBus(Bus* pRoot) noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pBus = pRoot;
+	}
+	m_cvWake.notify_one();
+}
+
+std::size_t Updater::activeRamps() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_tblRamps.size();
+}
+
+void Updater::tick(float fDelta)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	advance(fDelta);
+}
+
+void Updater::start(Source& source, RampTarget target, float fTo,
+                    std::uint32_t durationMs)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	std::vector<Ramp>::iterator it(std::find_if(m_tblRamps.begin(),
+		m_tblRamps.end(), [&](const Ramp& ramp)
+		{ return ramp.pSource == &source && ramp.target == target; }));
+
+	if(durationMs == 0)
+	{
+		if(it != m_tblRamps.end())
+			m_tblRamps.erase(it);
+		if(target == RT_GAIN)
+			source.setGain(fTo);
+		else
+			source.setPitch(fTo);
+		return;
+	}
+
+	// Départ de la valeur courante : celle de la rampe remplacée, si elle
+	// existe (pas de saut), sinon celle de la source
+	float fDuration(static_cast<float>(durationMs) / 1000.f);
+	if(it != m_tblRamps.end())
+	{
+		float t(std::min(it->fElapsed / it->fDuration, 1.f));
+		it->fFrom += (it->fTo - it->fFrom) * t;
+		it->fTo = fTo;
+		it->fElapsed = 0.f;
+		it->fDuration = fDuration;
+	}
+	else
+	{
+		float fFrom(target == RT_GAIN ? source.gain() : source.pitch());
+		Ramp ramp = {&source, target, fFrom, fTo, 0.f, fDuration};
+		m_tblRamps.push_back(ramp);
+	}
+	lock.unlock();
+	m_cvWake.notify_one();
+}
+
+void Updater::advance(float fDelta)
+{
+	KA3D_PROFILE_SCOPE("Updater::tick");
+	// Un pas entier sous le verrou du contexte : aucune erreur d'un autre
+	// fil n'est lue par les tâches (cf. ContextLock)
+	ContextLock contextLock;
+	std::size_t i(0);
+	while(i < m_tblRamps.size())
+	{
+		Ramp& ramp(m_tblRamps[i]);
+		ramp.fElapsed += fDelta;
+		float t(std::min(ramp.fElapsed / ramp.fDuration, 1.f));
+		float fValue(ramp.fFrom + (ramp.fTo - ramp.fFrom) * t);
+		bool isDone(t >= 1.f);
+		try
+		{
+			if(ramp.target == RT_GAIN)
+				ramp.pSource->setGain(fValue);
+			else
+				ramp.pSource->setPitch(fValue);
+		}
+		catch(std::runtime_error& )
+		{
+			// Erreur du pilote sur cette source : la rampe est abandonnée
+			isDone = true;
+		}
+
+		if(isDone)
+		{
+			m_tblRamps[i] = m_tblRamps.back();
+			m_tblRamps.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	// Une tâche en erreur n'empêche pas les suivantes : nouvel essai au
+	// pas suivant
+	for(UpdateTask* pTask : m_tblTasks)
+	{
+		try
+		{
+			pTask->update(fDelta);
+		}
+		catch(std::runtime_error& )
+		{
+			// Erreur du pilote : nouvel essai au pas suivant
+		}
+	}
+
+	if(m_pBus)
+	{
+		try
+		{
+			m_pBus->flush();
+		}
+		catch(std::runtime_error& )
+		{
+			// Erreur du pilote : nouvel essai au pas suivant
+		}
+	}
+}
+
+bool Updater::isBusy() const noexcept
+{
+	return !m_tblRamps.empty() || !m_tblTasks.empty() || m_pBus;
+}
+
+void Updater::threadLoop()
+{
+	using namespace std::chrono;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	steady_clock::time_point last(steady_clock::now());
+	while(!m_isStopping)
+	{
+		// Rien à faire : attente sans réveil périodique
+		if(!isBusy())
+		{
+			m_cvWake.wait(lock, [this]
+				{ return m_isStopping || isBusy(); });
+			last = steady_clock::now();
+			continue;
+		}
+
+		steady_clock::time_point next(last + milliseconds(m_uTickMs));
+		if(m_cvWake.wait_until(lock, next, [this] { return m_isStopping; }))
+			break;
+
+		// Temps réellement écoulé : un pas en retard est rattrapé
+		steady_clock::time_point now(steady_clock::now());
+		advance(duration<float>(now - last).count());
+		last = now;
+	}
+}
+
+} // namespace KA3D
@@ -27,6 +27,7 @@
 
 #include "KA3D/WaveFile.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <cstdint>
@@ -35,6 +36,8 @@
 #include <sstream>
 
 #include "Endianness.h"
+#include "MixKernels.h"
+#include "ProfilerPrivate.h"
 
 namespace KA3D
 {
@@ -53,13 +56,92 @@ struct fmtSpecificPCM
 	std::uint16_t wBitsPerSample;
 };
 
+struct fmtExtensible
+{
+	std::uint16_t cbSize;
+	std::uint16_t wValidBitsPerSample;
+	std::uint32_t dwChannelMask;
+	std::uint8_t subFormat[16];
+};
+
 const std::uint16_t WAVE_FORMAT_PCM = 0x0001;
+const std::uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+const std::uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+//! Masques de canaux (WAVEFORMATEXTENSIBLE) des formats multicanaux,
+//! dans l'ordre des canaux d'AL_EXT_MCFORMATS (le premier par défaut)
+static const struct
+{
+	std::uint16_t channels;
+	std::uint32_t mask;
+} tblChannelMask[] = {
+	{1, 0x004}, // FC
+	{2, 0x003}, // FL FR
+	{4, 0x033}, // FL FR BL BR
+	{6, 0x03F}, // FL FR FC LFE BL BR
+	{6, 0x60F}, // FL FR FC LFE SL SR
+	{7, 0x70F}, // FL FR FC LFE BC SL SR
+	{8, 0x63F} // FL FR FC LFE BL BR SL SR
+};
+
+//! Taille de l'extension WAVE_FORMAT_EXTENSIBLE (cbSize compris)
+const std::uint32_t EXTENSIBLE_SIZE = 24;
+//! Fin du GUID KSDATAFORMAT_SUBTYPE_* (les 2 premiers octets : format)
+const std::uint8_t KSDATAFORMAT_SUFFIX[] = {0x00, 0x00, 0x00, 0x00, 0x10,
+                                            0x00, 0x80, 0x00, 0x00, 0xAA,
+                                            0x00, 0x38, 0x9B, 0x71};
 
 const std::uint8_t RIFF_TAG_RIFF[] = {'R', 'I', 'F', 'F'};
+const std::uint8_t RIFF_TAG_RF64[] = {'R', 'F', '6', '4'};
 const std::uint8_t RIFF_TAG_WAVE[] = {'W', 'A', 'V', 'E'};
+const std::uint8_t RIFF_TAG_DS64[] = {'d', 's', '6', '4'};
 const std::uint8_t RIFF_TAG_FMT[] = {'f', 'm', 't', ' '};
 const std::uint8_t RIFF_TAG_DATA[] = {'d', 'a', 't', 'a'};
 
+/*
+ * smpl chunk : 9 mots de 4 octets puis les boucles (24 octets chacune)
+ * 		cSampleLoops		4	28
+ * 		loop : dwIdentifier	4	36
+ * 		       dwType		4	40	(0 : boucle avant)
+ * 		       dwStart		4	44
+ * 		       dwEnd		4	48	(dernier échantillon joué)
+ */
+const std::uint64_t SMPL_LOOP_COUNT = 28;
+const std::uint64_t SMPL_LOOPS = 36;
+const std::uint64_t SMPL_LOOP_SIZE = 24;
+const std::uint32_t SMPL_LOOP_FORWARD = 0;
+
+/*
+ * cue chunk : nombre de points (4) puis les points (24 octets chacun)
+ * 		dwName				4	0
+ * 		dwPosition			4	4
+ * 		fccChunk			4	8
+ * 		dwChunkStart		4	12
+ * 		dwBlockStart		4	16
+ * 		dwSampleOffset		4	20
+ * LIST/adtl : sous-chunks labl (dwName puis texte terminé par un zéro)
+ */
+const std::size_t CUE_POINT_SIZE = 24;
+const std::size_t CUE_SAMPLE_OFFSET = 20;
+const char LIST_TYPE_ADTL[] = {'a', 'd', 't', 'l'};
+const char ADTL_TAG_LABL[] = {'l', 'a', 'b', 'l'};
+
+// Wave64 : chunks identifiés par un GUID de 16 octets (tel qu'écrit sur le
+// disque) ; pour wave, fmt et data, les 4 premiers octets sont le tag RIFF
+const std::uint8_t W64_GUID_RIFF[] = {'r', 'i', 'f', 'f', 0x2E, 0x91, 0xCF,
+                                      0x11, 0xA5, 0xD6, 0x28, 0xDB, 0x04,
+                                      0xC1, 0x00, 0x00};
+const std::uint8_t W64_GUID_SUFFIX[] = {0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1,
+                                        0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A};
+const std::uint8_t W64_TAG_WAVE[] = {'w', 'a', 'v', 'e'};
+
+//! Taille maximum d'un identifiant de chunk (GUID Wave64)
+const std::uint32_t CHUNK_ID_MAX = 16;
+//! Taille d'un en-tête de chunk Wave64 (GUID et taille 64 bits)
+const std::uint64_t W64_CHUNK_HEADER = 24;
+//! Taille 32 bits signifiant « voir le chunk ds64 » (RF64)
+const std::uint32_t RF64_SIZE_IN_DS64 = 0xFFFFFFFF;
+
 /*
  * WAVE chunk				4	4	-
  * 	format chunk			4	8	-
@@ -75,32 +157,129 @@ const std::uint8_t RIFF_TAG_DATA[] = {'d', 'a', 't', 'a'};
  *
  * TOTAL FORMAT				16
  * TOTAL HEADER				36
+ *
+ * RF64 : chunk ds64 après WAVE (8 + 28 octets)
+ * 		riffSize			8
+ * 		dataSize			8
+ * 		sampleCount			8
+ * 		tableLength			4	(0 : pas de table)
+ *
+ * Wave64 : en-tête riff (24), GUID wave (16), fmt (24 + 16), data (24)
  */
 const std::uint32_t DEFAULT_FORMAT_SIZE = 16;
-const std::uint32_t DEFAULT_HEADER_SIZE = 36;
+const std::uint64_t DEFAULT_HEADER_SIZE = 36;
+const std::uint32_t DS64_SIZE = 28;
+const std::uint64_t RF64_HEADER_SIZE = DEFAULT_HEADER_SIZE + 8 + DS64_SIZE;
+//! Chunk JUNK réservé pour un éventuel ds64 (RIFF écrit en flux)
+const std::uint8_t RIFF_TAG_JUNK[] = {'J', 'U', 'N', 'K'};
+//! Taille des blocs de conversion de #write (hôte gros-boutiste)
+const std::uint64_t SCRATCH_SIZE = 64 * 1024;
+const std::uint64_t W64_HEADER_SIZE = 3*W64_CHUNK_HEADER + 16 +
+                                      DEFAULT_FORMAT_SIZE;
 
 
 WaveFile::WaveFile(std::iostream& refFile) noexcept:
-	m_refFile(refFile),
+	WaveFile(static_cast<Reader*>(nullptr))
+{
+	m_pFile = &refFile;
+}
+
+WaveFile::WaveFile(Reader& refReader) noexcept:
+	WaveFile(&refReader)
+{ }
+
+WaveFile::WaveFile(Reader* pReader) noexcept:
+	m_pFile(nullptr),
+	m_pReader(pReader),
+	m_pStreamReader(),
+	m_container(WC_RIFF),
 	m_uFileSize(4),
 	m_uFileRemaining(m_uFileSize),
+	m_uDataSize64(0),
 	m_uSamplesPerSec(0),
 	m_format(DF_LAST),
 	m_uSize(0),
-	m_uRemaining(0)
+	m_uRemaining(0),
+	m_uFileBytes(0),
+	m_uChannelMask(0),
+	m_mode(std::ios_base::in),
+	m_isStreaming(false),
+	m_headerPos(0),
+	m_tblScratch(),
+	m_tblPrefix(),
+	m_uPos(0),
+	m_uWaveEnd(0),
+	m_tblChunks(),
+	m_uLoopStart(0),
+	m_uLoopEnd(0),
+	m_tblMarkers()
 { }
 
+constexpr std::uint64_t WaveFile::SIZE_UNKNOWN;
+constexpr std::uint64_t WaveFile::PREFIX_SIZE;
+
+// Masque de canaux par défaut d'un nombre de canaux (0 : non supporté)
+static std::uint32_t defaultChannelMask(std::uint16_t channels) noexcept
+{
+	for(const auto& layout : tblChannelMask)
+		if(layout.channels == channels)
+			return layout.mask;
+	return 0;
+}
+
+// Vrai si la disposition des canaux correspond à un format (cf. Data)
+// (mono et stéréo : masque non vérifié)
+static bool isChannelMaskSupported(std::uint16_t channels,
+                                   std::uint32_t mask) noexcept
+{
+	if(channels == 1 || channels == 2)
+		return true;
+	for(const auto& layout : tblChannelMask)
+		if(layout.channels == channels && layout.mask == mask)
+			return true;
+	return false;
+}
+
+// Vrai si l'hôte est petit-boutiste (aucune conversion des échantillons)
+static inline bool isLittleEndianHost() noexcept
+{
+	std::uint16_t value(1);
+	htole(value);
+	return value == 1;
+}
+
 WaveFile::~WaveFile() noexcept
 { }
 
 void WaveFile::open(std::ios_base::openmode mode)
 {
+	m_mode = mode;
 	if(mode == std::ios_base::in)
 	{
+		// Flux lu au travers d'un Reader (cf. #close)
+		if(m_pFile)
+		{
+			m_pStreamReader.reset(new StreamReader(*m_pFile));
+			m_pReader = m_pStreamReader.get();
+		}
 		readHeaders();
 	}
 	else if(mode == std::ios_base::out)
 	{
+		if(!m_pFile)
+			throw std::runtime_error("Unable to write wave file: "
+			                         "read-only source");
+
+		// Taille inconnue : en-têtes provisoires, corrigés par close
+		m_isStreaming = (m_uSize == SIZE_UNKNOWN);
+		if(m_isStreaming)
+		{
+			m_uSize = 0;
+			m_headerPos = m_pFile->tellp();
+			if(m_headerPos == std::iostream::pos_type(-1))
+				throw std::runtime_error("Unable to stream wave file: "
+				                         "output is not seekable");
+		}
 		writeHeaders();
 	}
 	else
@@ -113,20 +292,74 @@ void WaveFile::open(std::ios_base::openmode mode)
 
 void WaveFile::readHeaders()
 {
-	std::uint32_t cksz;
+	KA3D_PROFILE_SCOPE("WaveFile::readHeaders");
+	std::uint8_t chunk[CHUNK_ID_MAX];
+	std::uint32_t riffSize;
+	std::uint64_t cksz;
 	fmtCommon fmtCom;
 	fmtSpecificPCM fmtPCM;
-	std::uint16_t audioPitch;
+	fmtExtensible fmtExt;
+	std::uint16_t formatTag;
 
-	// En-tête RIFF/WAVE
-	checkNextChunk(RIFF_TAG_RIFF, m_uFileSize);
+	// Début du fichier lu en une fois (en-têtes servis depuis la mémoire)
+	// (fichier éventuellement plus court que PREFIX_SIZE)
+	m_tblPrefix.resize(PREFIX_SIZE);
+	m_tblPrefix.resize(m_pReader->readAt(0, m_tblPrefix.data(),
+	                                     m_tblPrefix.size()));
+	m_uPos = 0;
 
-	m_uFileRemaining = m_uFileSize;
+	// En-tête RIFF/WAVE, RF64/WAVE ou riff/wave (Wave64)
+	rawRead(chunk, 1, 4);
+	if(std::memcmp(chunk, RIFF_TAG_RIFF, 4) == 0)
+	{
+		m_container = WC_RIFF;
+		readDWord(riffSize);
+		m_uFileSize = riffSize;
+		m_uWaveEnd = 8 + m_uFileSize;
+		checkChunk(RIFF_TAG_WAVE);
+	}
+	else if(std::memcmp(chunk, RIFF_TAG_RF64, 4) == 0)
+	{
+		m_container = WC_RF64;
+		readDWord(riffSize); // RF64_SIZE_IN_DS64
+		checkChunk(RIFF_TAG_WAVE);
 
-	checkChunk(RIFF_TAG_WAVE);
+		// Tailles 64 bits (le chunk ds64 est aussi indexé)
+		std::uint64_t ds64Pos(m_uPos);
+		checkNextChunk(RIFF_TAG_DS64, cksz);
+		if(cksz < 2*sizeof(std::uint64_t))
+			throw std::runtime_error("Incoherent ds64 chunk size");
+		readQWord(m_uFileSize);
+		readQWord(m_uDataSize64);
+		m_uWaveEnd = 8 + m_uFileSize;
+		m_uPos = ds64Pos;
+	}
+	else if(std::memcmp(chunk, W64_GUID_RIFF, 4) == 0)
+	{
+		m_container = WC_WAVE64;
+		rawRead(chunk + 4, 1, CHUNK_ID_MAX - 4);
+		if(std::memcmp(chunk, W64_GUID_RIFF, CHUNK_ID_MAX) != 0)
+			throw std::runtime_error("Expected Wave64 riff GUID");
+		readQWord(m_uFileSize);
+		if(m_uFileSize < W64_CHUNK_HEADER)
+			throw std::runtime_error("Incoherent Wave64 size");
+		m_uWaveEnd = m_uFileSize;
+		checkChunk(W64_TAG_WAVE);
+	}
+	else
+	{
+		throw std::runtime_error("Expected chunk RIFF, RF64 or riff");
+	}
+
+	// Répertoire des chunks
+	indexChunks(m_uPos);
 
 	// Format
-	findNextChunk(RIFF_TAG_FMT, cksz);
+	const WaveChunk& format(requireChunk("fmt "));
+	cksz = format.size;
+	if(cksz < DEFAULT_FORMAT_SIZE)
+		throw std::runtime_error("Incoherent format size");
+	m_uPos = format.offset;
 
 	// Commun
 	readWord(fmtCom.wFormatTag);
@@ -136,19 +369,58 @@ void WaveFile::readHeaders()
 	readWord(fmtCom.wBlockAlign);
 
 	// Specifique
-	if(fmtCom.wFormatTag != WAVE_FORMAT_PCM)
-		throw std::runtime_error("Can't parse proprietary wave format, "
-		                         "only WAVE_FORMAT_PCM (0x0001) supported");
-
 	readWord(fmtPCM.wBitsPerSample);
 
+	// Extensible : le format réel est dans le GUID du sous-format
+	formatTag = fmtCom.wFormatTag;
+	if(formatTag == WAVE_FORMAT_EXTENSIBLE)
+	{
+		if(cksz < DEFAULT_FORMAT_SIZE + EXTENSIBLE_SIZE)
+			throw std::runtime_error("Incoherent format size");
+		readWord(fmtExt.cbSize);
+		readWord(fmtExt.wValidBitsPerSample);
+		readDWord(fmtExt.dwChannelMask);
+		rawRead(fmtExt.subFormat, 1, sizeof(fmtExt.subFormat));
+
+		if(std::memcmp(fmtExt.subFormat + 2, KSDATAFORMAT_SUFFIX,
+		               sizeof(KSDATAFORMAT_SUFFIX)) != 0)
+			throw std::runtime_error("Can't parse proprietary wave format, "
+			                         "unknown extensible sub-format");
+		formatTag = static_cast<std::uint16_t>(fmtExt.subFormat[0] |
+		                                       fmtExt.subFormat[1] << 8);
+		m_uChannelMask = fmtExt.dwChannelMask;
+	}
+	else
+	{
+		m_uChannelMask = 0;
+	}
+
 	// Vérification
-	if(fmtCom.wChannels != 1 && fmtCom.wChannels != 2)
-		throw std::runtime_error("Unsupported format: "
-		                         "only mono and stereo supported");
-	if(fmtPCM.wBitsPerSample != 8 && fmtPCM.wBitsPerSample != 16)
-		throw std::runtime_error("Unsupported format: "
-		                         "only 8 and 16 bits/sample supported");
+	if(formatTag == WAVE_FORMAT_PCM)
+	{
+		if(fmtPCM.wBitsPerSample != 8 && fmtPCM.wBitsPerSample != 16 &&
+		   fmtPCM.wBitsPerSample != 24)
+			throw std::runtime_error("Unsupported format: "
+			                         "only 8, 16 and 24 bits/sample PCM "
+			                         "supported");
+	}
+	else if(formatTag == WAVE_FORMAT_IEEE_FLOAT)
+	{
+		if(fmtPCM.wBitsPerSample != 32)
+			throw std::runtime_error("Unsupported format: "
+			                         "only 32 bits/sample float supported");
+	}
+	else
+	{
+		throw std::runtime_error("Can't parse proprietary wave format, "
+		                         "only WAVE_FORMAT_PCM (0x0001) and "
+		                         "WAVE_FORMAT_IEEE_FLOAT (0x0003) supported");
+	}
+	if(m_uChannelMask == 0)
+		m_uChannelMask = defaultChannelMask(fmtCom.wChannels);
+	if(!isChannelMaskSupported(fmtCom.wChannels, m_uChannelMask))
+		throw std::runtime_error("Unsupported format: only mono, stereo, "
+		                         "quad, 5.1, 6.1 and 7.1 supported");
 	if(fmtCom.dwSamplesPerSec <= 0)
 		throw std::runtime_error("Invalid samples/second");
 
@@ -157,47 +429,286 @@ void WaveFile::readHeaders()
 	if(fmtCom.dwAvgBytesPerSec != fmtCom.wBlockAlign*fmtCom.dwSamplesPerSec)
 		throw std::runtime_error("Incoherent bytes/second");
 
-	// Enregistrement
+	// Enregistrement (24 bits : lus en flottants)
 	m_uSamplesPerSec = fmtCom.dwSamplesPerSec;
+	m_uFileBytes = fmtPCM.wBitsPerSample/8;
 	m_format = Data::formatFromPerSample(fmtCom.wChannels,
-	                                          fmtPCM.wBitsPerSample/8);
-	audioPitch = Data::formatPitch(m_format);
+	                                     m_uFileBytes == 3 ? 4 : m_uFileBytes);
 
 	// Données
-	findNextChunk(RIFF_TAG_DATA, m_uSize);
+	const WaveChunk& data(requireChunk("data"));
+	m_uSize = data.size;
 
 	// Vérification
-	if(m_uFileRemaining < m_uSize)
+	if(data.offset > m_uWaveEnd || m_uWaveEnd - data.offset < m_uSize)
 		throw std::runtime_error("Incoherent data size");
-	if(m_uSize % audioPitch != 0)
+	if(m_uSize % fmtCom.wBlockAlign != 0)
 		throw std::runtime_error("Incoherent data size");
 
+	// Boucle et marqueurs éventuels
+	readLoop(m_uSize / fmtCom.wBlockAlign);
+	readMarkers(m_uSize / fmtCom.wBlockAlign);
+
 	// Fichier ouvert, curseur au début des données
+	m_uPos = data.offset;
 	m_uRemaining = m_uSize;
 }
 
+// Lit la première boucle du chunk smpl (ignorée si invalide : les
+// métadonnées ne doivent pas empêcher la lecture)
+void WaveFile::readLoop(std::uint64_t frames)
+{
+	m_uLoopStart = 0;
+	m_uLoopEnd = 0;
+	const WaveChunk* pSampler(findChunk("smpl"));
+	if(!pSampler || pSampler->size < SMPL_LOOPS + SMPL_LOOP_SIZE)
+		return;
+
+	std::uint32_t count, type, start, end;
+	try
+	{
+		m_uPos = pSampler->offset + SMPL_LOOP_COUNT;
+		readDWord(count);
+		m_uPos = pSampler->offset + SMPL_LOOPS + sizeof(std::uint32_t);
+		readDWord(type);
+		readDWord(start);
+		readDWord(end);
+	}
+	catch(std::exception&)
+	{
+		return; // Chunk tronqué
+	}
+
+	if(count == 0 || type != SMPL_LOOP_FORWARD || start > end ||
+	   end >= frames)
+		return;
+	m_uLoopStart = start;
+	m_uLoopEnd = end + 1;
+}
+
+// Indexe les chunks depuis \a pos jusqu'à la fin du wave
+// (en-têtes servis depuis le début du fichier, puis lus dans le flux)
+void WaveFile::indexChunks(std::uint64_t pos)
+{
+	const std::uint64_t headerSize(m_container == WC_WAVE64 ?
+	                               W64_CHUNK_HEADER : 8);
+	bool hasData(false);
+
+	m_tblChunks.clear();
+	while(m_uWaveEnd >= headerSize && pos <= m_uWaveEnd - headerSize)
+	{
+		std::uint8_t id[CHUNK_ID_MAX];
+		std::uint64_t cksz;
+		m_uPos = pos;
+		try
+		{
+			nextChunk(id, cksz);
+		}
+		catch(std::exception&)
+		{
+			// Fichier tronqué après les données : chunks suivants ignorés
+			if(!hasData)
+				throw;
+			break;
+		}
+
+		WaveChunk chunk;
+		std::memcpy(chunk.tag, id, sizeof(chunk.tag));
+		if(m_container == WC_WAVE64 &&
+		   std::memcmp(id + 4, W64_GUID_SUFFIX, CHUNK_ID_MAX - 4) != 0)
+			std::memset(chunk.tag, 0, sizeof(chunk.tag)); // GUID inconnu
+		chunk.offset = m_uPos;
+		chunk.size = cksz;
+		m_tblChunks.push_back(chunk);
+
+		hasData = hasData || isChunk(id, RIFF_TAG_DATA);
+		if(UINT64_MAX - chunk.offset < paddedSize(cksz))
+			break;
+		pos = chunk.offset + paddedSize(cksz);
+	}
+}
+
+// Lit une valeur 32 bits petit-boutiste en mémoire
+static inline std::uint32_t getDWord(const std::uint8_t* data) noexcept
+{
+	std::uint32_t dword;
+	std::memcpy(&dword, data, sizeof(dword));
+	letoh(dword);
+	return dword;
+}
+
+// Lit les points du chunk cue et leurs noms (ignorés si invalides)
+void WaveFile::readMarkers(std::uint64_t frames)
+{
+	m_tblMarkers.clear();
+	const WaveChunk* pCue(findChunk("cue "));
+	if(!pCue || pCue->size < sizeof(std::uint32_t))
+		return;
+
+	std::vector<std::uint8_t> tblCue;
+	try
+	{
+		chunkData(*pCue, tblCue);
+	}
+	catch(std::exception&)
+	{
+		return; // Chunk tronqué
+	}
+
+	std::size_t count(std::min<std::size_t>(getDWord(tblCue.data()),
+		(tblCue.size() - sizeof(std::uint32_t)) / CUE_POINT_SIZE));
+	for(std::size_t i=0; i<count; ++i)
+	{
+		const std::uint8_t* point(tblCue.data() + sizeof(std::uint32_t) +
+		                          i*CUE_POINT_SIZE);
+		Marker marker;
+		marker.id = getDWord(point);
+		marker.position = getDWord(point + CUE_SAMPLE_OFFSET);
+		if(marker.position <= frames)
+			m_tblMarkers.push_back(marker);
+	}
+	std::stable_sort(m_tblMarkers.begin(), m_tblMarkers.end(),
+	                 [](const Marker& a, const Marker& b)
+	                 { return a.position < b.position; });
+
+	readLabels();
+}
+
+// Associe les noms des listes adtl (sous-chunks labl) aux marqueurs
+void WaveFile::readLabels()
+{
+	std::vector<std::uint8_t> tblList;
+	for(const WaveChunk& chunk : m_tblChunks)
+	{
+		if(std::memcmp(chunk.tag, "LIST", sizeof(chunk.tag)) != 0 ||
+		   chunk.size < sizeof(LIST_TYPE_ADTL))
+			continue;
+
+		// Type de la liste lu seul (les listes INFO peuvent être grandes)
+		char type[sizeof(LIST_TYPE_ADTL)];
+		try
+		{
+			m_uPos = chunk.offset;
+			rawRead(type, 1, sizeof(type));
+			if(std::memcmp(type, LIST_TYPE_ADTL, sizeof(type)) != 0)
+				continue;
+			chunkData(chunk, tblList);
+		}
+		catch(std::exception&)
+		{
+			continue; // Chunk tronqué
+		}
+
+		std::size_t pos(sizeof(LIST_TYPE_ADTL));
+		while(pos + 8 <= tblList.size())
+		{
+			const std::uint8_t* sub(tblList.data() + pos);
+			std::uint32_t size(getDWord(sub + 4));
+			if(size > tblList.size() - pos - 8)
+				break;
+			if(std::memcmp(sub, ADTL_TAG_LABL, 4) == 0 &&
+			   size >= sizeof(std::uint32_t))
+			{
+				std::uint32_t id(getDWord(sub + 8));
+				const char* text(reinterpret_cast<const char*>(sub + 12));
+				std::size_t length(0);
+				while(length < size - sizeof(std::uint32_t) && text[length])
+					++length;
+				for(Marker& marker : m_tblMarkers)
+					if(marker.id == id)
+						marker.label.assign(text, length);
+			}
+			pos += 8 + size + (size & 1);
+		}
+	}
+}
+
+const WaveChunk& WaveFile::requireChunk(const char* tag) const
+{
+	const WaveChunk* pChunk(findChunk(tag));
+	if(!pChunk)
+	{
+		std::ostringstream msg;
+		msg << "Missing chunk " << tag;
+		throw std::runtime_error(msg.str());
+	}
+	return *pChunk;
+}
+
 void WaveFile::writeHeaders()
 {
+	KA3D_PROFILE_SCOPE("WaveFile::writeHeaders");
 	std::uint16_t bytesPerSample(Data::formatBytesPerSample(m_format));
 	fmtCommon fmtCom;
 	fmtSpecificPCM fmtPCM;
-	fmtCom.wFormatTag = WAVE_FORMAT_PCM;
+	fmtCom.wFormatTag = (bytesPerSample == 4 ? WAVE_FORMAT_IEEE_FLOAT
+	                                         : WAVE_FORMAT_PCM);
 	fmtCom.wChannels = Data::formatChannels(m_format);
 	fmtCom.dwSamplesPerSec = m_uSamplesPerSec;
 	fmtCom.wBlockAlign = fmtCom.wChannels * bytesPerSample;
 	fmtCom.dwAvgBytesPerSec = fmtCom.wBlockAlign * m_uSamplesPerSec;
 	fmtPCM.wBitsPerSample = 8*bytesPerSample;
+	m_uFileBytes = bytesPerSample;
+
+	// Plus de 2 canaux : WAVE_FORMAT_EXTENSIBLE (disposition des canaux)
+	std::uint64_t formatExtra(0);
+	std::uint16_t subFormatTag(fmtCom.wFormatTag);
+	if(fmtCom.wChannels > 2)
+	{
+		formatExtra = EXTENSIBLE_SIZE;
+		fmtCom.wFormatTag = WAVE_FORMAT_EXTENSIBLE;
+		m_uChannelMask = defaultChannelMask(fmtCom.wChannels);
+	}
+
+	// Données alignées sur 2 octets (RIFF) ou 8 octets (Wave64)
+	std::uint64_t padded(paddedSize(m_uSize));
+	// Écriture en flux : place réservée pour un chunk ds64
+	std::uint64_t junkSize(m_isStreaming ? 8 + DS64_SIZE : 0);
 
-	// En-tête RIFF/WAVE
-	m_uFileSize = DEFAULT_HEADER_SIZE + m_uSize;
-	writeChunk(RIFF_TAG_RIFF, m_uFileSize);
+	// Un fichier RIFF ne peut pas dépasser 4 Go : passage en RF64
+	if(m_container == WC_RIFF &&
+	   DEFAULT_HEADER_SIZE + formatExtra + junkSize + padded > UINT32_MAX)
+		m_container = WC_RF64;
 
-	m_uFileRemaining = m_uFileSize;
+	// En-tête RIFF/WAVE, RF64/WAVE (et ds64) ou riff/wave
+	if(m_container == WC_RIFF)
+	{
+		m_uFileSize = DEFAULT_HEADER_SIZE + formatExtra + junkSize + padded;
+		writeChunk(RIFF_TAG_RIFF, m_uFileSize);
+		m_uFileRemaining = m_uFileSize;
+		writeChunk(RIFF_TAG_WAVE);
 
-	writeChunk(RIFF_TAG_WAVE);
+		if(m_isStreaming)
+		{
+			writeChunk(RIFF_TAG_JUNK, DS64_SIZE);
+			writePadding(DS64_SIZE);
+		}
+	}
+	else if(m_container == WC_RF64)
+	{
+		m_uFileSize = RF64_HEADER_SIZE + formatExtra + padded;
+		writeChunk(RIFF_TAG_RF64);
+		writeDWord(RF64_SIZE_IN_DS64);
+		m_uFileRemaining = m_uFileSize;
+		writeChunk(RIFF_TAG_WAVE);
+
+		writeChunk(RIFF_TAG_DS64, DS64_SIZE);
+		writeQWord(m_uFileSize);
+		writeQWord(m_uSize);
+		writeQWord(m_uSize / (fmtCom.wBlockAlign ? fmtCom.wBlockAlign : 1));
+		writeDWord(0);
+	}
+	else
+	{
+		m_uFileSize = W64_HEADER_SIZE + formatExtra + padded;
+		rawWrite(W64_GUID_RIFF, 1, CHUNK_ID_MAX);
+		writeQWord(m_uFileSize);
+		m_uFileRemaining = m_uFileSize - W64_CHUNK_HEADER;
+		writeChunk(W64_TAG_WAVE);
+	}
 
 	// Format
-	writeChunk(RIFF_TAG_FMT, DEFAULT_FORMAT_SIZE);
+	writeChunk(RIFF_TAG_FMT, DEFAULT_FORMAT_SIZE + formatExtra);
 
 	// Commun
 	writeWord(fmtCom.wFormatTag);
@@ -207,66 +718,132 @@ void WaveFile::writeHeaders()
 	writeWord(fmtCom.wBlockAlign);
 	// Specifique
 	writeWord(fmtPCM.wBitsPerSample);
+	if(formatExtra)
+	{
+		writeWord(EXTENSIBLE_SIZE - sizeof(std::uint16_t)); // cbSize
+		writeWord(fmtPCM.wBitsPerSample);
+		writeDWord(m_uChannelMask);
+		writeWord(subFormatTag);
+		rawWrite(KSDATAFORMAT_SUFFIX, 1, sizeof(KSDATAFORMAT_SUFFIX));
+	}
 
 	// Données
 	writeChunk(RIFF_TAG_DATA, m_uSize);
 
 	// Fichier ouvert, curseur au début des données
 	m_uRemaining = m_uSize;
-	assert(m_uFileRemaining == m_uRemaining);
+	assert(m_uFileRemaining == padded);
 }
 
 std::uint64_t WaveFile::read(void* data, std::uint64_t size)
 {
-	std::uint32_t readable;
-	readable = std::min(static_cast<std::uint64_t>(m_uRemaining), size);
+	KA3D_PROFILE_SCOPE("WaveFile::read");
+	std::uint16_t bytesPerSample(Data::formatBytesPerSample(m_format));
+	if(m_uFileBytes == 3)
+		return readS24(static_cast<float*>(data), size / bytesPerSample);
+
+	std::uint64_t readable(std::min(m_uRemaining, size));
 	rawRead(data, readable);
 
-	if(Data::formatBytesPerSample(m_format) == 2)
+	if(bytesPerSample == 2)
 	{
 		std::uint16_t* data16(static_cast<std::uint16_t*>(data));
-		std::uint32_t count(readable/2);
-		for(std::uint32_t i=0; i<count; ++i)
+		std::uint64_t count(readable/2);
+		for(std::uint64_t i=0; i<count; ++i)
 		{
 			letoh(data16[i]);
 		}
 	}
+	else if(bytesPerSample == 4)
+	{
+		std::uint32_t* data32(static_cast<std::uint32_t*>(data));
+		std::uint64_t count(readable/4);
+		for(std::uint64_t i=0; i<count; ++i)
+		{
+			letoh(data32[i]);
+		}
+	}
 
 	m_uRemaining -= readable;
+	KA3D_PROFILE_ADD(PC_WAVE_READ_BYTES, readable);
 	return readable;
 }
 
+// Lecture 24 bits convertie en flottants (par blocs, tampon réutilisé)
+std::uint64_t WaveFile::readS24(float* data, std::uint64_t count)
+{
+	count = std::min(count, m_uRemaining / 3);
+	const std::uint64_t blockMax(SCRATCH_SIZE / 3);
+	m_tblScratch.resize(3 * std::min(count, blockMax));
+	for(std::uint64_t done=0; done<count; )
+	{
+		std::uint64_t block(std::min(count - done, blockMax));
+		rawRead(m_tblScratch.data(), 3, block);
+		convertS24ToFloat(data + done, m_tblScratch.data(),
+		                  static_cast<std::uint32_t>(block));
+		done += block;
+	}
+
+	m_uRemaining -= 3*count;
+	KA3D_PROFILE_ADD(PC_WAVE_READ_BYTES, 3*count);
+	return count * sizeof(float);
+}
+
 void WaveFile::write(const void* data, std::uint64_t size)
 {
-	assert(m_uRemaining >= size);
+	KA3D_PROFILE_SCOPE("WaveFile::write");
+	assert(m_isStreaming || m_uRemaining >= size);
+	std::uint16_t bytesPerSample(Data::formatBytesPerSample(m_format));
 
-	if(Data::formatBytesPerSample(m_format) == 2)
+	if(bytesPerSample > 1 && !isLittleEndianHost())
 	{
-		std::uint16_t count(size/2);
-		std::uint16_t* data16(new std::uint16_t[count]);
-		std::memcpy(data16, data, size);
-		try
+		// Conversion par blocs dans un tampon réutilisé
+		const std::uint8_t* bytes(static_cast<const std::uint8_t*>(data));
+		m_tblScratch.resize(std::min(size, SCRATCH_SIZE));
+		for(std::uint64_t done=0; done<size; done+=m_tblScratch.size())
 		{
-			for(std::uint32_t i=0; i<count; ++i)
+			std::uint64_t block(std::min(size - done,
+			                    static_cast<std::uint64_t>(m_tblScratch.size())));
+			std::memcpy(m_tblScratch.data(), bytes + done, block);
+			if(bytesPerSample == 2)
 			{
-				letoh(data16[i]);
+				std::uint16_t* data16(reinterpret_cast<std::uint16_t*>(
+					m_tblScratch.data()));
+				for(std::uint64_t i=0; i<block/2; ++i)
+				{
+					htole(data16[i]);
+				}
 			}
-			rawWrite(data16, size);
-		}
-		catch(...)
-		{
-			delete[] data16;
+			else
+			{
+				std::uint32_t* data32(reinterpret_cast<std::uint32_t*>(
+					m_tblScratch.data()));
+				for(std::uint64_t i=0; i<block/4; ++i)
+				{
+					htole(data32[i]);
+				}
+			}
+			rawWrite(m_tblScratch.data(), block);
 		}
 	}
 	else
 	{
 		rawWrite(data, size);
 	}
-	m_uRemaining -= size;
+
+	if(m_isStreaming)
+		m_uSize += size;
+	else
+		m_uRemaining -= size;
+	KA3D_PROFILE_ADD(PC_WAVE_WRITE_BYTES, size);
 }
 std::int64_t WaveFile::seek(std::int64_t offset, std::ios_base::seekdir whence)
 {
-	std::uint32_t done(m_uSize - m_uRemaining);
+	// Fichier 24 bits : décalage donné en octets de flottants
+	if(m_uFileBytes == 3)
+		offset = offset / 4 * 3;
+
+	std::uint64_t done(m_uSize - m_uRemaining);
 	// distance relative curseur-début
 	std::int64_t min(- static_cast<std::int64_t>(done));
 	// distance relative curseur-fin
@@ -289,16 +866,49 @@ std::int64_t WaveFile::seek(std::int64_t offset, std::ios_base::seekdir whence)
 
 	realOffset = std::min(std::max(realOffset, min), max);
 
-	m_refFile.seekg(realOffset, std::ios_base::cur);
-	m_uFileRemaining -= realOffset;
+	// Déplacement différé jusqu'à la prochaine lecture
+	m_uPos += realOffset;
 	m_uRemaining -= realOffset;
 
-	return (m_uSize - m_uRemaining);
+	return formatBytes(m_uSize - m_uRemaining);
 }
 
 void WaveFile::close()
 {
-	skipRead(m_uFileRemaining);
+	if(m_mode != std::ios_base::out)
+	{
+		// Curseur du flux placé à la fin du wave
+		m_uPos = m_uWaveEnd;
+		if(m_pStreamReader)
+		{
+			try
+			{
+				m_pStreamReader->seek(m_uWaveEnd);
+			}
+			catch(std::runtime_error& )
+			{
+				// Fichier tronqué : curseur laissé à la fin lue
+			}
+		}
+	}
+	else if(m_isStreaming)
+	{
+		// Tailles définitives : réécriture des en-têtes puis retour à la fin
+		writePadding(paddedSize(m_uSize) - m_uSize);
+		std::iostream::pos_type end(m_pFile->tellp());
+		m_pFile->seekp(m_headerPos);
+		writeHeaders();
+		m_pFile->seekp(end);
+		if(!m_pFile->good())
+			throw std::runtime_error("Writing error");
+		m_isStreaming = false;
+		m_uRemaining = 0;
+	}
+	else
+	{
+		// Octet d'alignement du chunk de données
+		writePadding(m_uFileRemaining - m_uRemaining);
+	}
 }
 
 void WaveFile::setSamplesPerSec(std::uint32_t dwSamplesPerSec) noexcept
@@ -311,10 +921,15 @@ void WaveFile::setFormat(DataFormat format) noexcept
 	// Avant ouverture et en mode écriture seulement
 	m_format = format;
 }
-void WaveFile::setSize(std::uint32_t dwSize) noexcept
+void WaveFile::setSize(std::uint64_t uSize) noexcept
 {
 	// Avant ouverture et en mode écriture seulement
-	m_uSize = dwSize;
+	m_uSize = uSize;
+}
+void WaveFile::setContainer(WaveContainer container) noexcept
+{
+	// Avant ouverture et en mode écriture seulement
+	m_container = container;
 }
 std::uint32_t WaveFile::samplesPerSec() const noexcept
 {
@@ -324,24 +939,95 @@ DataFormat WaveFile::format() const noexcept
 {
 	return m_format;
 }
-std::uint32_t WaveFile::size() const noexcept
+std::uint64_t WaveFile::size() const noexcept
+{
+	return formatBytes(m_uSize);
+}
+WaveContainer WaveFile::container() const noexcept
 {
-	return m_uSize;
+	return m_container;
+}
+std::uint32_t WaveFile::channelMask() const noexcept
+{
+	return m_uChannelMask;
+}
+bool WaveFile::hasLoop() const noexcept
+{
+	return m_uLoopEnd > m_uLoopStart;
+}
+std::uint32_t WaveFile::loopStart() const noexcept
+{
+	return m_uLoopStart;
+}
+std::uint32_t WaveFile::loopEnd() const noexcept
+{
+	return m_uLoopEnd;
+}
+const std::vector<Marker>& WaveFile::markers() const noexcept
+{
+	return m_tblMarkers;
+}
+const std::vector<WaveChunk>& WaveFile::chunks() const noexcept
+{
+	return m_tblChunks;
+}
+const WaveChunk* WaveFile::findChunk(const char* tag) const noexcept
+{
+	for(const WaveChunk& chunk : m_tblChunks)
+		if(std::memcmp(chunk.tag, tag, sizeof(chunk.tag)) == 0)
+			return &chunk;
+	return nullptr;
+}
+void WaveFile::chunkData(const WaveChunk& chunk,
+                         std::vector<std::uint8_t>& tblData)
+{
+	std::uint64_t pos(m_uPos);
+	tblData.resize(static_cast<std::size_t>(chunk.size));
+	if(tblData.empty())
+		return;
+
+	m_uPos = chunk.offset;
+	try
+	{
+		rawRead(tblData.data(), tblData.size());
+	}
+	catch(...)
+	{
+		m_uPos = pos;
+		throw;
+	}
+	m_uPos = pos;
 }
 
 void WaveFile::rawRead(void* data, std::uint64_t size, std::uint64_t n)
 {
-	m_refFile.read(static_cast<std::iostream::char_type*>(data), n*size);
-	if(!m_refFile.good())
+	std::uint8_t* bytes(static_cast<std::uint8_t*>(data));
+	std::uint64_t total(size*n);
+
+	// Octets déjà en mémoire (début du fichier)
+	if(m_uPos < m_tblPrefix.size())
+	{
+		std::uint64_t block(std::min<std::uint64_t>(total,
+		                    m_tblPrefix.size() - m_uPos));
+		std::memcpy(bytes, m_tblPrefix.data() + m_uPos, block);
+		bytes += block;
+		total -= block;
+		m_uPos += block;
+	}
+	if(total == 0)
+		return;
+
+	// Reste lu dans la source, à la position courante (cf. #seek)
+	if(m_pReader->readAt(m_uPos, bytes, total) != total)
 	{
 		throw std::runtime_error("Reading error");
 	}
-	m_uFileRemaining -= size*n;
+	m_uPos += total;
 }
 void WaveFile::rawWrite(const void* data, std::uint64_t size, std::uint64_t n)
 {
-	m_refFile.write(static_cast<const std::iostream::char_type*>(data), n*size);
-	if(!m_refFile.good())
+	m_pFile->write(static_cast<const std::iostream::char_type*>(data), n*size);
+	if(!m_pFile->good())
 	{
 		throw std::runtime_error("Writing error");
 	}
@@ -349,17 +1035,6 @@ void WaveFile::rawWrite(const void* data, std::uint64_t size, std::uint64_t n)
 }
 
 
-void WaveFile::skipRead(std::uint32_t size)
-{
-	m_refFile.seekg(size, std::ios_base::cur);
-	m_uRemaining -= size;
-	m_uFileRemaining -= size;
-}
-void WaveFile::skipWord()
-{
-	std::uint16_t empty;
-	rawRead(&empty, sizeof(std::uint16_t));
-}
 void WaveFile::readWord(std::uint16_t& word)
 {
 	rawRead(&word, sizeof(std::uint16_t));
@@ -370,16 +1045,29 @@ void WaveFile::readDWord(std::uint32_t& dword)
 	rawRead(&dword, sizeof(std::uint32_t));
 	letoh(dword);
 }
+void WaveFile::readQWord(std::uint64_t& qword)
+{
+	rawRead(&qword, sizeof(std::uint64_t));
+	letoh(qword);
+}
 void WaveFile::readChunk(std::uint8_t* chunk)
 {
-	rawRead(chunk, 1, 4);
+	rawRead(chunk, 1, m_container == WC_WAVE64 ? CHUNK_ID_MAX : 4);
+}
+bool WaveFile::isChunk(const std::uint8_t* chunk,
+                       const std::uint8_t* value) const noexcept
+{
+	if(std::memcmp(chunk, value, 4) != 0)
+		return false;
+	return m_container != WC_WAVE64 ||
+	       std::memcmp(chunk + 4, W64_GUID_SUFFIX, CHUNK_ID_MAX - 4) == 0;
 }
 void WaveFile::checkChunk(const std::uint8_t* value)
 {
-	std::uint8_t chunk[4];
+	std::uint8_t chunk[CHUNK_ID_MAX];
 	readChunk(chunk);
 
-	if(std::memcmp(chunk, value, 4) != 0) // chunk != value
+	if(!isChunk(chunk, value)) // chunk != value
 	{
 		std::ostringstream msg;
 		msg << "Expected chunk " << value[0] << value[1]
@@ -388,18 +1076,34 @@ void WaveFile::checkChunk(const std::uint8_t* value)
 	}
 }
 
-void WaveFile::nextChunk(std::uint8_t* chunk, std::uint32_t& cksz)
+void WaveFile::nextChunk(std::uint8_t* chunk, std::uint64_t& cksz)
 {
 	readChunk(chunk);
-	readDWord(cksz);
+	if(m_container == WC_WAVE64)
+	{
+		// La taille Wave64 inclut l'en-tête du chunk
+		readQWord(cksz);
+		if(cksz < W64_CHUNK_HEADER)
+			throw std::runtime_error("Incoherent chunk size");
+		cksz -= W64_CHUNK_HEADER;
+	}
+	else
+	{
+		std::uint32_t size;
+		readDWord(size);
+		cksz = size;
+		if(m_container == WC_RF64 && size == RF64_SIZE_IN_DS64 &&
+		   std::memcmp(chunk, RIFF_TAG_DATA, 4) == 0)
+			cksz = m_uDataSize64;
+	}
 }
 
-void WaveFile::checkNextChunk(const std::uint8_t* value, std::uint32_t& cksz)
+void WaveFile::checkNextChunk(const std::uint8_t* value, std::uint64_t& cksz)
 {
-	std::uint8_t chunk[4];
+	std::uint8_t chunk[CHUNK_ID_MAX];
 	nextChunk(chunk, cksz);
 
-	if(std::memcmp(chunk, value, 4) != 0) // chunk != value
+	if(!isChunk(chunk, value)) // chunk != value
 	{
 		std::ostringstream msg;
 		msg << "Expected chunk " << value[0] << value[1]
@@ -408,33 +1112,18 @@ void WaveFile::checkNextChunk(const std::uint8_t* value, std::uint32_t& cksz)
 	}
 }
 
-void WaveFile::findNextChunk(const std::uint8_t* value, std::uint32_t& cksz)
+// Taille dans le format lu (#format) d'une taille dans le fichier
+std::uint64_t WaveFile::formatBytes(std::uint64_t fileBytes) const noexcept
 {
-	try
-	{
-		std::uint8_t chunk[4];
+	return m_uFileBytes == 3 ? fileBytes / 3 * sizeof(float) : fileBytes;
+}
 
-		nextChunk(chunk, cksz);
-		while(std::memcmp(chunk, value, 4) != 0) // while(chunck != value)
-		{
-			skipRead(cksz);
-			nextChunk(chunk, cksz);
-		}
-	}
-	catch(std::exception& e)
-	{
-		if(m_refFile.eof())
-		{
-			std::ostringstream msg;
-			msg << "Missing chunk " << value[0] << value[1]
-			                        << value[2] << value[3];
-			throw std::runtime_error(msg.str());
-		}
-		else
-		{
-			throw;
-		}
-	}
+std::uint64_t WaveFile::paddedSize(std::uint64_t cksz) const noexcept
+{
+	// Chunks alignés sur 2 octets (RIFF) ou 8 octets (Wave64)
+	if(m_container == WC_WAVE64)
+		return (cksz + 7) & ~static_cast<std::uint64_t>(7);
+	return cksz + (cksz & 1);
 }
 
 void WaveFile::writeWord(std::uint16_t word)
@@ -447,14 +1136,36 @@ void WaveFile::writeDWord(std::uint32_t dword)
 	htole(dword);
 	rawWrite(&dword, sizeof(std::uint32_t));
 }
+void WaveFile::writeQWord(std::uint64_t qword)
+{
+	htole(qword);
+	rawWrite(&qword, sizeof(std::uint64_t));
+}
+void WaveFile::writePadding(std::uint64_t size)
+{
+	static const std::uint8_t tblZero[8] = {0};
+	while(size > 0)
+	{
+		std::uint64_t block(std::min<std::uint64_t>(size, sizeof(tblZero)));
+		rawWrite(tblZero, block);
+		size -= block;
+	}
+}
 void WaveFile::writeChunk(const std::uint8_t* chunk)
 {
 	rawWrite(chunk, 1, 4);
+	if(m_container == WC_WAVE64)
+		rawWrite(W64_GUID_SUFFIX, 1, CHUNK_ID_MAX - 4);
 }
-void WaveFile::writeChunk(const std::uint8_t* chunk, std::uint32_t cksz)
+void WaveFile::writeChunk(const std::uint8_t* chunk, std::uint64_t cksz)
 {
 	writeChunk(chunk);
-	writeDWord(cksz);
+	if(m_container == WC_WAVE64)
+		writeQWord(cksz + W64_CHUNK_HEADER);
+	else if(cksz > UINT32_MAX)
+		writeDWord(RF64_SIZE_IN_DS64); // RF64 : taille dans le chunk ds64
+	else
+		writeDWord(static_cast<std::uint32_t>(cksz));
 }
 
 } // namespace KA3D
@@ -0,0 +1,239 @@
+/**
+ *
+ * @file WaveWriter.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant l'écriture de fichiers wave en arrière-plan (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "KA3D/WaveWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "ProfilerPrivate.h"
+
+namespace KA3D
+{
+
+WaveWriter::WaveWriter(std::size_t blockSize):
+	m_uBlockSize(std::max<std::size_t>(blockSize, 1)),
+	m_pWave(),
+	m_tblCurrent(),
+	m_tblQueue(),
+	m_tblFree(),
+	m_uSize(0),
+	m_isWriting(false),
+	m_isStopping(false),
+	m_pError(),
+	m_mutex(),
+	m_cvWork(),
+	m_cvIdle(),
+	m_thread()
+{ }
+
+WaveWriter::~WaveWriter() noexcept
+{
+	try
+	{
+		if(m_pWave)
+			Quit();
+	}
+	catch(...)
+	{ }
+}
+
+void WaveWriter::Init(std::iostream& file, DataFormat format,
+                      std::uint32_t samplesPerSec, WaveContainer container)
+{
+	KA3D_PROFILE_SCOPE("WaveWriter::Init");
+	try
+	{
+		m_pWave.reset(new WaveFile(file));
+		m_pWave->setFormat(format);
+		m_pWave->setSamplesPerSec(samplesPerSec);
+		m_pWave->setContainer(container);
+		m_pWave->setSize(WaveFile::SIZE_UNKNOWN);
+		m_pWave->open(std::ios_base::out);
+	}
+	catch(std::exception& e)
+	{
+		m_pWave.reset();
+		std::ostringstream msg;
+		msg << "Unable to initialize wave writer: " << e.what();
+		throw std::runtime_error(msg.str());
+	}
+
+	m_tblCurrent.reserve(m_uBlockSize);
+	m_uSize = 0;
+	m_isStopping = false;
+	m_pError = nullptr;
+	m_thread = std::thread(&WaveWriter::threadLoop, this);
+}
+
+void WaveWriter::Quit()
+{
+	KA3D_PROFILE_SCOPE("WaveWriter::Quit");
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		submit(lock);
+		m_isStopping = true;
+	}
+	m_cvWork.notify_all();
+	if(m_thread.joinable())
+		m_thread.join();
+
+	// Le fil est arrêté : l'erreur éventuelle puis la fermeture
+	std::unique_ptr<WaveFile> pWave(std::move(m_pWave));
+	rethrow();
+	try
+	{
+		if(pWave)
+			pWave->close();
+	}
+	catch(std::exception& e)
+	{
+		std::ostringstream msg;
+		msg << "Unable to close wave writer: " << e.what();
+		throw std::runtime_error(msg.str());
+	}
+}
+
+void WaveWriter::write(const void* data, std::uint64_t size)
+{
+	const std::uint8_t* bytes(static_cast<const std::uint8_t*>(data));
+	m_uSize += size;
+	while(size > 0)
+	{
+		std::size_t block(static_cast<std::size_t>(std::min<std::uint64_t>(
+			size, m_uBlockSize - m_tblCurrent.size())));
+		m_tblCurrent.insert(m_tblCurrent.end(), bytes, bytes + block);
+		bytes += block;
+		size -= block;
+
+		if(m_tblCurrent.size() == m_uBlockSize)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			rethrow();
+			submit(lock);
+		}
+	}
+}
+
+void WaveWriter::flush()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	submit(lock);
+	m_cvIdle.wait(lock, [this]
+		{ return m_pError || (m_tblQueue.empty() && !m_isWriting); });
+	rethrow();
+}
+
+std::uint64_t WaveWriter::size() const noexcept
+{
+	return m_uSize;
+}
+
+std::size_t WaveWriter::pending() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_tblQueue.size() + (m_isWriting ? 1 : 0);
+}
+
+// Confie le bloc en cours au fil (verrou détenu) et prend un bloc libre
+void WaveWriter::submit(std::unique_lock<std::mutex>& lock)
+{
+	(void)lock;
+	if(m_tblCurrent.empty())
+		return;
+
+	m_tblQueue.push_back(std::move(m_tblCurrent));
+	if(m_tblFree.empty())
+	{
+		m_tblCurrent = std::vector<std::uint8_t>();
+		m_tblCurrent.reserve(m_uBlockSize);
+	}
+	else
+	{
+		m_tblCurrent = std::move(m_tblFree.back());
+		m_tblFree.pop_back();
+	}
+	m_cvWork.notify_one();
+}
+
+// Relance l'erreur du fil d'écriture (verrou détenu ou fil arrêté)
+void WaveWriter::rethrow()
+{
+	if(m_pError)
+	{
+		std::exception_ptr pError(m_pError);
+		m_pError = nullptr;
+		std::rethrow_exception(pError);
+	}
+}
+
+void WaveWriter::threadLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for(;;)
+	{
+		m_cvWork.wait(lock, [this]
+			{ return m_isStopping || !m_tblQueue.empty(); });
+		if(m_tblQueue.empty())
+			break; // Arrêt demandé, tout est écrit
+
+		std::vector<std::uint8_t> tblBlock(std::move(m_tblQueue.front()));
+		m_tblQueue.pop_front();
+		m_isWriting = true;
+
+		// Écriture hors verrou : l'appelant continue à remplir ses blocs
+		lock.unlock();
+		std::exception_ptr pError;
+		try
+		{
+			KA3D_PROFILE_SCOPE("WaveWriter::write");
+			m_pWave->write(tblBlock.data(), tblBlock.size());
+		}
+		catch(...)
+		{
+			pError = std::current_exception();
+		}
+		lock.lock();
+
+		m_isWriting = false;
+		tblBlock.clear();
+		m_tblFree.push_back(std::move(tblBlock));
+		if(pError && !m_pError)
+		{
+			m_pError = pError;
+			m_tblQueue.clear(); // Fichier inutilisable
+		}
+		if(m_tblQueue.empty())
+			m_cvIdle.notify_all();
+	}
+}
+
+} // namespace KA3D
@@ -0,0 +1,172 @@
+/**
+ *
+ * @file WorkStealingPool.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la réserve de fils d'exécution à vol de tâches (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "WorkStealingPool.h"
+
+#include <cstdint>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace KA3D
+{
+
+WorkStealingPool::WorkStealingPool(std::uint32_t threads):
+	m_tblThreads(),
+	m_tblQueues(),
+	m_mutex(),
+	m_cvStart(),
+	m_cvDone(),
+	m_func(nullptr),
+	m_pUserData(nullptr),
+	m_uGeneration(0),
+	m_uRemaining(0),
+	m_uBusy(0),
+	m_isStopping(false)
+{
+	if(threads == 0)
+		threads = 1;
+	for(std::uint32_t i=0; i<threads; ++i)
+		m_tblQueues.emplace_back(new Queue());
+	for(std::uint32_t i=1; i<threads; ++i)
+		m_tblThreads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+	m_cvStart.notify_all();
+	for(std::thread& thread : m_tblThreads)
+		thread.join();
+}
+
+std::uint32_t WorkStealingPool::size() const noexcept
+{
+	return static_cast<std::uint32_t>(m_tblQueues.size());
+}
+
+void WorkStealingPool::run(std::uint32_t count, TaskFunc func,
+                           void* pUserData)
+{
+	if(count == 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		// Répartition par blocs contigus : chaque fil commence par des
+		// tâches voisines, les vols se font depuis la fin des files
+		std::uint32_t workers(size());
+		for(std::uint32_t w=0; w<workers; ++w)
+		{
+			std::lock_guard<std::mutex> queueLock(m_tblQueues[w]->mutex);
+			for(std::uint32_t t=w*count/workers; t<(w+1)*count/workers; ++t)
+				m_tblQueues[w]->tblTasks.push_back(t);
+		}
+		m_uRemaining = count;
+		m_func = func;
+		m_pUserData = pUserData;
+		++m_uGeneration;
+	}
+	m_cvStart.notify_all();
+
+	drain(0, func, pUserData);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cvDone.wait(lock, [this]{ return m_uRemaining == 0 && m_uBusy == 0; });
+	m_func = nullptr;
+	m_pUserData = nullptr;
+}
+
+void WorkStealingPool::workerLoop(std::uint32_t worker)
+{
+	std::uint64_t uSeen(0);
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for(;;)
+	{
+		m_cvStart.wait(lock, [this, &uSeen]{
+			return m_isStopping || (m_func && m_uGeneration != uSeen);
+		});
+		if(m_isStopping)
+			return;
+
+		uSeen = m_uGeneration;
+		TaskFunc func(m_func);
+		void* pUserData(m_pUserData);
+		++m_uBusy;
+		lock.unlock();
+
+		drain(worker, func, pUserData);
+
+		lock.lock();
+		if(--m_uBusy == 0)
+			m_cvDone.notify_all();
+	}
+}
+
+void WorkStealingPool::drain(std::uint32_t worker, TaskFunc func,
+                             void* pUserData)
+{
+	std::uint32_t task;
+	while(popTask(worker, task))
+	{
+		func(task, worker, pUserData);
+		m_uRemaining.fetch_sub(1);
+	}
+}
+
+bool WorkStealingPool::popTask(std::uint32_t worker, std::uint32_t& task)
+{
+	{
+		Queue& queue(*m_tblQueues[worker]);
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(!queue.tblTasks.empty())
+		{
+			task = queue.tblTasks.front();
+			queue.tblTasks.pop_front();
+			return true;
+		}
+	}
+	std::uint32_t workers(size());
+	for(std::uint32_t i=1; i<workers; ++i)
+	{
+		Queue& victim(*m_tblQueues[(worker + i) % workers]);
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if(!victim.tblTasks.empty())
+		{
+			task = victim.tblTasks.back();
+			victim.tblTasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+} // namespace KA3D
@@ -0,0 +1,114 @@
+#ifndef WORKSTEALINGPOOL_H_INCLUDED
+#define WORKSTEALINGPOOL_H_INCLUDED
+/**
+ *
+ * @file WorkStealingPool.h
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant la réserve de fils d'exécution à vol de tâches (H)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace KA3D
+{
+
+/**
+ * @brief Réserve de fils d'exécution à vol de tâches (« work-stealing »)
+ * Les tâches d'un lot sont réparties entre les files des fils ; un fil
+ * dont la file est vide vole les tâches restantes à la fin des autres files.
+ * Le fil appelant #run participe au travail (fil numéro 0).
+ */
+class WorkStealingPool
+{
+public:
+	/**
+	 * @brief Fonction exécutant une tâche
+	 * @param task Numéro de la tâche (dans [0, count[)
+	 * @param worker Numéro du fil qui l'exécute (dans [0, size()[)
+	 * @param pUserData Donnée transmise à #run
+	 */
+	typedef void (*TaskFunc)(std::uint32_t task, std::uint32_t worker,
+	                         void* pUserData);
+
+public:
+	/**
+	 * @brief Constructeur (démarre threads - 1 fils en arrière plan)
+	 * @param threads Nombre total de fils, appelant compris
+	 */
+	explicit WorkStealingPool(std::uint32_t threads);
+	WorkStealingPool(const WorkStealingPool& ) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool& ) = delete;
+	~WorkStealingPool() noexcept;
+
+	/**
+	 * @brief Nombre total de fils, appelant compris
+	 */
+	std::uint32_t size() const noexcept;
+	/**
+	 * @brief Exécute un lot de tâches et attend leur fin
+	 * @param count Nombre de tâches
+	 * @param func Fonction exécutant une tâche
+	 * @param pUserData Donnée transmise à la fonction
+	 */
+	void run(std::uint32_t count, TaskFunc func, void* pUserData);
+
+private:
+	//! File de tâches d'un fil
+	struct Queue
+	{
+		std::mutex mutex; //!< Protection de la file
+		std::deque<std::uint32_t> tblTasks; //!< Tâches restantes
+	};
+
+	//! Boucle d'un fil en arrière plan
+	void workerLoop(std::uint32_t worker);
+	//! Exécute des tâches jusqu'à ce que toutes les files soient vides
+	void drain(std::uint32_t worker, TaskFunc func, void* pUserData);
+	//! Retire une tâche de sa file (début) ou d'une autre (fin)
+	bool popTask(std::uint32_t worker, std::uint32_t& task);
+
+private:
+	std::vector<std::thread> m_tblThreads; //!< Fils en arrière plan
+	std::vector<std::unique_ptr<Queue>> m_tblQueues; //!< File de chaque fil
+	std::mutex m_mutex; //!< Protection du lot en cours
+	std::condition_variable m_cvStart; //!< Signal d'un nouveau lot
+	std::condition_variable m_cvDone; //!< Signal de fin de lot
+	TaskFunc m_func; //!< Fonction du lot en cours (nullptr : aucun)
+	void* m_pUserData; //!< Donnée du lot en cours
+	std::uint64_t m_uGeneration; //!< Numéro du lot en cours
+	std::atomic<std::uint32_t> m_uRemaining; //!< Tâches non terminées
+	std::uint32_t m_uBusy; //!< Fils en arrière plan travaillant sur le lot
+	bool m_isStopping; //!< Arrêt des fils demandé
+};
+
+} // namespace KA3D
+
+#endif // WORKSTEALINGPOOL_H_INCLUDED
@@ -0,0 +1,322 @@
+/**
+ *
+ * @file Bench.cpp
+ * @author karfouilla
+ * @version 1.0
+ * @date 18 octobre 2026
+ * @brief Fichier contenant les mesures de performance de KAudio3D (CPP)
+ *
+ */
+////////////////////////////////////////////////////////////////////////////////
+//
+// This file is part of KAudio3D.
+// KAudio3D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// KAudio3D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with KAudio3D.  If not, see <https://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// Utilisation : KAudio3D_bench [fichier.json]
+// Les résultats sont écrits en JSON (sur la sortie standard par défaut).
+// Les mesures de lecture utilisent le pilote nul d'OpenAL Soft
+// (ALSOFT_DRIVERS=null, sauf si la variable est déjà définie) :
+// aucune sortie audio, mais le mixage est bien effectué.
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "KA3D/Convolver.h"
+#include "KA3D/Data.h"
+#include "KA3D/Listener.h"
+#include "KA3D/Reader.h"
+#include "KA3D/Sound.h"
+#include "KA3D/Source.h"
+#include "KA3D/WaveFile.h"
+
+namespace
+{
+
+//! Nombre de répétitions de chaque mesure (la médiane est retenue)
+const int REPEAT = 7;
+//! Fréquence d'échantillonage des données de test
+const std::uint32_t BENCH_FREQ = 44100;
+
+//! Résultat d'une mesure
+struct Result
+{
+	std::string name;
+	std::uint64_t iterations;
+	double nsPerOp;
+};
+
+std::vector<Result> tblResults;
+
+// Mesure \a iterations appels de \a op, REPEAT fois, conserve la médiane
+void bench(const std::string& name, std::uint64_t iterations,
+           const std::function<void(std::uint64_t)>& op)
+{
+	using namespace std::chrono;
+	std::vector<double> tblRuns;
+
+	op(0); // Échauffement
+	for(int r=0; r<REPEAT; ++r)
+	{
+		steady_clock::time_point start(steady_clock::now());
+		for(std::uint64_t i=0; i<iterations; ++i)
+			op(i);
+		double ns(duration_cast<nanoseconds>(steady_clock::now() - start)
+		          .count());
+		tblRuns.push_back(ns / static_cast<double>(iterations));
+	}
+	std::sort(tblRuns.begin(), tblRuns.end());
+
+	Result result = {name, iterations, tblRuns[REPEAT/2]};
+	tblResults.push_back(result);
+	std::cerr << name << ": " << result.nsPerOp << " ns/op" << std::endl;
+}
+
+// Données PCM déterministes (bruit pseudo-aléatoire à graine fixe)
+std::vector<std::uint8_t> pcmData(std::uint32_t seconds, std::uint16_t pitch)
+{
+	std::vector<std::uint8_t> tblData(seconds * BENCH_FREQ * pitch);
+	std::uint32_t state(0x12345678);
+	for(std::uint8_t& byte : tblData)
+	{
+		state = state * 1664525 + 1013904223;
+		byte = static_cast<std::uint8_t>(state >> 24);
+	}
+	return tblData;
+}
+
+// Fichier wave en mémoire
+std::string waveData(const std::vector<std::uint8_t>& tblData,
+                     KA3D::DataFormat format)
+{
+	std::stringstream stream;
+	KA3D::WaveFile wave(stream);
+	wave.setFormat(format);
+	wave.setSamplesPerSec(BENCH_FREQ);
+	wave.setSize(tblData.size());
+	wave.open(std::ios_base::out);
+	wave.write(tblData.data(), tblData.size());
+	return stream.str();
+}
+
+// Fichier wave PCM 24 bits stéréo en mémoire (écrit à la main : WaveFile
+// n'écrit pas le 24 bits)
+std::string wave24Data(const std::vector<std::uint8_t>& tblData)
+{
+	std::string wave;
+	auto dword = [&wave](std::uint32_t value)
+	{
+		for(int i=0; i<4; ++i)
+			wave += static_cast<char>((value >> (8*i)) & 0xFF);
+	};
+	auto word = [&wave](std::uint16_t value)
+	{
+		wave += static_cast<char>(value & 0xFF);
+		wave += static_cast<char>(value >> 8);
+	};
+	const std::uint16_t CHANNELS = 2;
+	const std::uint16_t BLOCK_ALIGN = 3 * CHANNELS;
+	std::uint32_t size(static_cast<std::uint32_t>(tblData.size()));
+	wave += "RIFF";
+	dword(4 + 8 + 16 + 8 + size + (size & 1));
+	wave += "WAVEfmt ";
+	dword(16);
+	word(1); // PCM
+	word(CHANNELS);
+	dword(BENCH_FREQ);
+	dword(BENCH_FREQ * BLOCK_ALIGN);
+	word(BLOCK_ALIGN);
+	word(24);
+	wave += "data";
+	dword(size);
+	wave.append(tblData.begin(), tblData.end());
+	if(size & 1)
+		wave += '\0';
+	return wave;
+}
+
+void benchWave()
+{
+	std::vector<std::uint8_t> tblData(pcmData(1, 4));
+	std::string wave(waveData(tblData, KA3D::DF_STEREO16));
+	std::vector<std::uint8_t> tblOut(tblData.size());
+	// Fichier sans données : ne mesure que l'analyse des en-têtes
+	std::string header(waveData(std::vector<std::uint8_t>(),
+	                            KA3D::DF_STEREO16));
+
+	bench("wave_parse_header", 20000, [&](std::uint64_t)
+	{
+		std::stringstream stream(header);
+		KA3D::WaveFile file(stream);
+		file.open(std::ios_base::in);
+	});
+
+	bench("wave_read_stereo16_1s", 200, [&](std::uint64_t)
+	{
+		std::stringstream stream(wave);
+		KA3D::WaveFile file(stream);
+		file.open(std::ios_base::in);
+		file.read(tblOut.data(), tblOut.size());
+	});
+
+	// Sur un hôte little-endian, la lecture 16 bits n'est qu'une copie :
+	// le 24 bits mesure le chemin de conversion (vers des flottants)
+	std::string wave24(wave24Data(pcmData(1, 6)));
+	std::vector<float> tblOut24(BENCH_FREQ * 2);
+	bench("wave_read_stereo24_to_float_1s", 200, [&](std::uint64_t)
+	{
+		std::stringstream stream(wave24);
+		KA3D::WaveFile file(stream);
+		file.open(std::ios_base::in);
+		file.read(tblOut24.data(), tblOut24.size() * sizeof(float));
+	});
+
+	// Même fichiers lus en mémoire, sans flux
+	bench("wave_parse_header_span", 20000, [&](std::uint64_t)
+	{
+		KA3D::SpanReader reader(header.data(), header.size());
+		KA3D::WaveFile file(reader);
+		file.open(std::ios_base::in);
+	});
+
+	bench("wave_read_stereo16_1s_span", 200, [&](std::uint64_t)
+	{
+		KA3D::SpanReader reader(wave.data(), wave.size());
+		KA3D::WaveFile file(reader);
+		file.open(std::ios_base::in);
+		file.read(tblOut.data(), tblOut.size());
+	});
+
+	bench("wave_read_stereo24_to_float_1s_span", 200, [&](std::uint64_t)
+	{
+		KA3D::SpanReader reader(wave24.data(), wave24.size());
+		KA3D::WaveFile file(reader);
+		file.open(std::ios_base::in);
+		file.read(tblOut24.data(), tblOut24.size() * sizeof(float));
+	});
+}
+
+void benchConvolver()
+{
+	// Réponse stéréo de 3 secondes (bruit), blocs de 256 échantillons
+	const std::uint32_t BLOCK = 256;
+	std::vector<std::uint8_t> tblIr(pcmData(3, 4));
+	KA3D::Convolver convolver(BLOCK);
+	convolver.setImpulse(*std::unique_ptr<KA3D::MixerBuffer>(
+		KA3D::MixerBuffer::fromData(tblIr, KA3D::DF_STEREO16, BENCH_FREQ)));
+
+	std::vector<float> tblLeft(BLOCK), tblRight(BLOCK);
+	float* tblChannels[2] = {tblLeft.data(), tblRight.data()};
+	bench("convolver_stereo_3s_ir_block256", 500, [&](std::uint64_t)
+	{
+		convolver.process(tblChannels, 2, BLOCK);
+	});
+}
+
+void benchPlayback()
+{
+	KA3D::Listener listener;
+	try
+	{
+		listener.Init();
+	}
+	catch(std::exception& e)
+	{
+		std::cerr << "Playback benchmarks skipped: " << e.what() << std::endl;
+		return;
+	}
+
+	std::vector<std::uint8_t> tblData(pcmData(1, 2));
+
+	bench("data_upload_mono16_1s", 200, [&](std::uint64_t)
+	{
+		KA3D::Data::fromData(tblData, KA3D::DF_MONO16, BENCH_FREQ)->unref();
+	});
+
+	KA3D::Data* pData(KA3D::Data::fromData(tblData, KA3D::DF_MONO16,
+	                                       BENCH_FREQ));
+	{
+		KA3D::Source source;
+		source.Init(pData);
+		bench("source_set_position", 100000, [&](std::uint64_t i)
+		{
+			float x(static_cast<float>(i % 100));
+			source.setPosition(x, 0.f, -x);
+		});
+		source.Quit();
+	}
+	{
+		KA3D::Sound sound(16);
+		sound.setData(pData, false);
+		sound.Init(true);
+		bench("sound_play", 20000, [&](std::uint64_t)
+		{
+			sound.play();
+		});
+		sound.Quit();
+	}
+	pData->unref();
+
+	listener.Quit();
+}
+
+void writeJson(std::ostream& out)
+{
+	out << "{\n  \"benchmarks\": [";
+	for(std::size_t i=0; i<tblResults.size(); ++i)
+	{
+		const Result& result(tblResults[i]);
+		out << (i ? "," : "") << "\n    {\"name\": \"" << result.name << "\", "
+		    << "\"iterations\": " << result.iterations << ", "
+		    << "\"repeat\": " << REPEAT << ", "
+		    << "\"ns_per_op\": " << result.nsPerOp << ", "
+		    << "\"ops_per_sec\": " << 1e9/result.nsPerOp << "}";
+	}
+	out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+#ifndef _WIN32
+	setenv("ALSOFT_DRIVERS", "null", 0);
+#endif
+
+	benchWave();
+	benchConvolver();
+	benchPlayback();
+
+	if(argc > 1)
+	{
+		std::ofstream out(argv[1]);
+		writeJson(out);
+	}
+	else
+	{
+		writeJson(std::cout);
+	}
+	return EXIT_SUCCESS;
+}